@@ -0,0 +1,103 @@
+#!/usr/bin/env bash
+# Copyright Nguyen Minh Tam. All Rights Reserved.
+#
+# Launches a local server and N headless (-nullrhi) bot clients on one Linux
+# box to load test combat replication. See docs/LOAD_TESTING.md.
+#
+# Usage: UE_ROOT=/path/to/UnrealEngine Scripts/RunCombatBots.sh [num_bots]
+#
+# Environment:
+#   UE_ROOT        Engine root (required)
+#   MODE           dedicated | listen (default: dedicated)
+#   MAP            Map to load (default: /Game/Variant_Combat/Lvl_Combat)
+#   PORT           Server port (default: 7777)
+#   PATTERN        random | scripted (default: random)
+#   DURATION       Seconds to run before shutting everything down (default: 120)
+#   STATS_INTERVAL Seconds between server stat reports (default: 5)
+#   LOG_DIR        Where to write per-process logs (default: Saved/BotLogs)
+#   SERVER_BINARY  Packaged OptimizedGASDemoServer binary to use instead of the
+#                  editor in dedicated mode (optional)
+
+set -euo pipefail
+
+NUM_BOTS="${1:-8}"
+MODE="${MODE:-dedicated}"
+MAP="${MAP:-/Game/Variant_Combat/Lvl_Combat}"
+PORT="${PORT:-7777}"
+PATTERN="${PATTERN:-random}"
+DURATION="${DURATION:-120}"
+STATS_INTERVAL="${STATS_INTERVAL:-5}"
+
+if [[ "$(uname -s)" != "Linux" ]]; then
+  echo "This script only supports Linux." >&2
+  exit 1
+fi
+
+if [[ -z "${UE_ROOT:-}" ]]; then
+  echo "UE_ROOT must point at the engine root." >&2
+  exit 1
+fi
+
+PROJECT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+PROJECT="$PROJECT_DIR/OptimizedGASDemo.uproject"
+EDITOR="$UE_ROOT/Engine/Binaries/Linux/UnrealEditor"
+LOG_DIR="${LOG_DIR:-$PROJECT_DIR/Saved/BotLogs}"
+
+if [[ ! -x "$EDITOR" ]]; then
+  echo "Could not find $EDITOR" >&2
+  exit 1
+fi
+
+mkdir -p "$LOG_DIR"
+
+PIDS=()
+cleanup() {
+  for PID in "${PIDS[@]}"; do
+    kill "$PID" 2>/dev/null || true
+  done
+  wait 2>/dev/null || true
+}
+trap cleanup EXIT INT TERM
+
+COMMON_ARGS=(-unattended -nosplash -nosound -NoVerifyGC -log -ForceLogFlush)
+
+# start the server
+if [[ "$MODE" == "dedicated" && -n "${SERVER_BINARY:-}" ]]; then
+  "$SERVER_BINARY" "$MAP" -port="$PORT" \
+    -CombatNetStats -CombatNetStatsInterval="$STATS_INTERVAL" \
+    "${COMMON_ARGS[@]}" -abslog="$LOG_DIR/Server.log" >/dev/null 2>&1 &
+elif [[ "$MODE" == "dedicated" ]]; then
+  "$EDITOR" "$PROJECT" "$MAP" -server -port="$PORT" \
+    -CombatNetStats -CombatNetStatsInterval="$STATS_INTERVAL" \
+    "${COMMON_ARGS[@]}" -abslog="$LOG_DIR/Server.log" >/dev/null 2>&1 &
+elif [[ "$MODE" == "listen" ]]; then
+  "$EDITOR" "$PROJECT" "$MAP?listen" -game -nullrhi -port="$PORT" \
+    -CombatNetStats -CombatNetStatsInterval="$STATS_INTERVAL" \
+    "${COMMON_ARGS[@]}" -abslog="$LOG_DIR/Server.log" >/dev/null 2>&1 &
+else
+  echo "Unknown MODE '$MODE' (expected dedicated or listen)." >&2
+  exit 1
+fi
+PIDS+=("$!")
+
+# give the server time to load the map before clients connect
+sleep 15
+
+BOT_ARGS=(-CombatBot)
+if [[ "$PATTERN" == "scripted" ]]; then
+  BOT_ARGS+=(-CombatBotScript)
+fi
+
+for ((i = 0; i < NUM_BOTS; i++)); do
+  "$EDITOR" "$PROJECT" "127.0.0.1:$PORT" -game -nullrhi -windowed \
+    "${BOT_ARGS[@]}" -CombatBotSeed="$i" \
+    "${COMMON_ARGS[@]}" -abslog="$LOG_DIR/Bot_$i.log" >/dev/null 2>&1 &
+  PIDS+=("$!")
+done
+
+echo "Running $NUM_BOTS bots against a $MODE server for ${DURATION}s."
+echo "Server stats: grep CombatNetStats $LOG_DIR/Server.log"
+sleep "$DURATION"
+
+grep "CombatNetStats\|CombatFootprint" "$LOG_DIR/Server.log" |
+  tail -n $((NUM_BOTS + 3)) || true
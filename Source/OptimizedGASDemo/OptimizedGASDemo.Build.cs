@@ -20,7 +20,8 @@ public class OptimizedGASDemo : ModuleRules
 			"UMG",
 			"Slate",
 			"ModularGameplay",
-			"GameplayAbilities"
+			"GameplayAbilities",
+			"GameplayTasks"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[] { });
@@ -35,6 +36,7 @@ public class OptimizedGASDemo : ModuleRules
 			"OptimizedGASDemo/Variant_Combat/Components",
 			"OptimizedGASDemo/Variant_Combat/Gameplay",
 			"OptimizedGASDemo/Variant_Combat/Interfaces",
+			"OptimizedGASDemo/Variant_Combat/Subsystems",
 			"OptimizedGASDemo/Variant_Combat/UI",
 			"OptimizedGASDemo/Variant_SideScrolling",
 			"OptimizedGASDemo/Variant_SideScrolling/AI",
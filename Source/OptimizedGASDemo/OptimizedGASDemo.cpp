@@ -1,9 +1,24 @@
 // Copyright Nguyen Minh Tam. All Rights Reserved.
 
 #include "OptimizedGASDemo.h"
+#include "HAL/IConsoleManager.h"
 #include "Modules/ModuleManager.h"
 
 IMPLEMENT_PRIMARY_GAME_MODULE(FDefaultGameModuleImpl, OptimizedGASDemo,
                               "OptimizedGASDemo");
 
-DEFINE_LOG_CATEGORY(LogOptimizedGASDemo)
\ No newline at end of file
+DEFINE_LOG_CATEGORY(LogOptimizedGASDemo)
+
+DEFINE_STAT(STAT_CombatDeferrableTraces);
+DEFINE_STAT(STAT_CombatAsyncTraces);
+
+namespace {
+TAutoConsoleVariable<bool> CVarAsyncTraces(
+    TEXT("Combat.AsyncTraces"), false,
+    TEXT("Run AI attack traces, danger notifications and camera probes as ")
+        TEXT("async queries, consuming the results the next frame"));
+} // namespace
+
+bool CombatAsyncTraces::IsEnabled() {
+  return CVarAsyncTraces.GetValueOnGameThread();
+}
@@ -5,4 +5,23 @@
 #include "CoreMinimal.h"
 
 /** Main log category used across the project */
-DECLARE_LOG_CATEGORY_EXTERN(LogOptimizedGASDemo, Log, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(LogOptimizedGASDemo, Log, All);
+
+/** Stat group for combat systems (stat Combat) */
+DECLARE_STATS_GROUP(TEXT("Combat"), STATGROUP_Combat, STATCAT_Advanced);
+
+/** Game thread time spent in traces that could run as async queries */
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Deferrable Traces"),
+                          STAT_CombatDeferrableTraces, STATGROUP_Combat, );
+
+/** Traces that ran as async queries instead of on the game thread */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Async Traces"), STAT_CombatAsyncTraces,
+                                  STATGROUP_Combat, );
+
+namespace CombatAsyncTraces {
+
+/** Returns true if traces that tolerate a frame of latency should run as
+ * async queries, with their results consumed the next frame */
+bool IsEnabled();
+
+} // namespace CombatAsyncTraces
@@ -8,7 +8,8 @@
 #include "Components/WidgetComponent.h"
 #include "Engine/DamageEvents.h"
 #include "CombatLifeBar.h"
-#include "TimerManager.h"
+#include "CombatCosmetics.h"
+#include "OptimizedGASDemo.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Animation/AnimInstance.h"
 #include "AbilitySystemComponent.h"
@@ -30,13 +31,90 @@
 #include "Data/CombatAttackEventData.h"
 #include "Data/CombatPawnData.h"
 #include "Abilities/CombatAbilitySet.h"
+#include "CombatTeams.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_CYCLE_STAT(TEXT("AI Command"), STAT_CombatAICommand, STATGROUP_Combat);
+
+namespace {
+/** Logs the ability instances held per enemy and the cost of activating the
+ * danger notification ability, which runs once per attack */
+void BenchmarkAbilityInstances(const TArray<FString> &Args, UWorld *World) {
+  if (!World) {
+    return;
+  }
+
+  int32 NumEnemies = 0;
+  int32 NumInstances = 0;
+  SIZE_T InstanceBytes = 0;
+  ACombatEnemy *FirstEnemy = nullptr;
+  for (TActorIterator<ACombatEnemy> It(World); It; ++It) {
+    UAbilitySystemComponent *ASC = It->GetAbilitySystemComponent();
+    if (!ASC) {
+      continue;
+    }
+
+    ++NumEnemies;
+    FirstEnemy = FirstEnemy ? FirstEnemy : *It;
+    for (const FGameplayAbilitySpec &Spec : ASC->GetActivatableAbilities()) {
+      for (const UGameplayAbility *Instance : Spec.GetAbilityInstances()) {
+        ++NumInstances;
+        InstanceBytes += Instance->GetClass()->GetStructureSize();
+      }
+    }
+  }
+
+  if (!FirstEnemy) {
+    UE_LOG(LogOptimizedGASDemo, Warning,
+           TEXT("Combat.BenchAbilityInstances: no enemies in the world"));
+    return;
+  }
+
+  UE_LOG(LogOptimizedGASDemo, Log,
+         TEXT("Combat.BenchAbilityInstances: %d enemies, %.1f ability "
+              "instances and %.0f bytes (shallow) per enemy"),
+         NumEnemies, static_cast<double>(NumInstances) / NumEnemies,
+         static_cast<double>(InstanceBytes) / NumEnemies);
+
+  const int32 Activations =
+      Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+  const FGameplayTag NotifyTag =
+      FGameplayTag::RequestGameplayTag(FName("Event.Notify.Enemies"));
+
+  FGameplayEventData EventData;
+  EventData.Instigator = FirstEnemy;
+  EventData.Target = FirstEnemy;
+
+  UAbilitySystemComponent *ASC = FirstEnemy->GetAbilitySystemComponent();
+  const double StartTime = FPlatformTime::Seconds();
+  for (int32 Index = 0; Index < Activations; ++Index) {
+    ASC->HandleGameplayEvent(NotifyTag, &EventData);
+  }
+  const double ElapsedUs = (FPlatformTime::Seconds() - StartTime) * 1e6;
+
+  UE_LOG(LogOptimizedGASDemo, Log,
+         TEXT("Combat.BenchAbilityInstances: %d danger notify activations, "
+              "%.2fus per activation"),
+         Activations, ElapsedUs / Activations);
+}
+
+FAutoConsoleCommandWithWorldAndArgs BenchAbilityInstancesCommand(
+    TEXT("Combat.BenchAbilityInstances"),
+    TEXT("Logs the ability instances and their memory per enemy, then "
+         "activates the first enemy's danger notify ability N times "
+         "(default 100) and logs the cost per activation"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+        &BenchmarkAbilityInstances));
+} // namespace
 
 /** Constructor */
 ACombatEnemy::ACombatEnemy() {
   PrimaryActorTick.bCanEverTick = true;
 
-  // bind the attack montage ended delegate
-  OnAttackMontageEnded.BindUObject(this, &ACombatEnemy::AttackMontageEnded);
+  // enemies never hit each other
+  TeamId = CombatTeams::Enemies;
 
   // create the ability system component
   AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>(
@@ -75,52 +153,87 @@ UAbilitySystemComponent *ACombatEnemy::GetAbilitySystemComponent() const {
   return AbilitySystemComponent;
 }
 
-void ACombatEnemy::DoAIComboAttack() {
-  // Send gameplay event to activate combo attack ability
-  SendGameplayEvent(
-      FGameplayTag::RequestGameplayTag(FName("Event.Attack.Combo.Start")));
+bool ACombatEnemy::ExecuteAICommand(
+    ECombatAICommand Command, const FStateTreeWeakExecutionContext &Waiter) {
+  SCOPE_CYCLE_COUNTER(STAT_CombatAICommand);
+
+  // a command still pending belongs to a task that already moved on
+  ReleaseAICommand();
+
+  UAbilitySystemComponent *ASC = GetAbilitySystemComponent();
+  const FGameplayAbilitySpecHandle Handle =
+      AICommandHandles[static_cast<uint8>(Command)];
+  PendingCommandHandle = Handle;
+  PendingCommandWaiter = Waiter;
+
+  if (!ASC || !Handle.IsValid()) {
+    FinishAICommand(false);
+    return false;
+  }
+
+  ASC->TryActivateAbility(Handle);
+
+  // an ability that ended during activation already finished the command
+  if (!PendingCommandHandle.IsValid()) {
+    return false;
+  }
+
+  const FGameplayAbilitySpec *Spec = ASC->FindAbilitySpecFromHandle(Handle);
+  if (!Spec || !Spec->IsActive()) {
+    FinishAICommand(false);
+    return false;
+  }
+
+  return true;
 }
 
-void ACombatEnemy::DoAIChargedAttack() {
-  // Send gameplay event to activate charged attack ability
-  SendGameplayEvent(
-      FGameplayTag::RequestGameplayTag(FName("Event.Attack.Charged.Start")));
+void ACombatEnemy::ReleaseAICommand() {
+  PendingCommandHandle = FGameplayAbilitySpecHandle();
+  PendingCommandWaiter = FStateTreeWeakExecutionContext();
 }
 
-void ACombatEnemy::AttackMontageEnded(UAnimMontage *Montage,
-                                      bool bInterrupted) {
-  Super::AttackMontageEnded(Montage, bInterrupted);
+void ACombatEnemy::CacheAICommandHandles() {
+  UAbilitySystemComponent *ASC = GetAbilitySystemComponent();
+  if (!ASC) {
+    return;
+  }
+
+  // one scan at grant time instead of a trigger tag lookup per attack
+  for (FGameplayAbilitySpecHandle &Handle : AICommandHandles) {
+    Handle = FGameplayAbilitySpecHandle();
+  }
 
-  // call the attack completed delegate so the StateTree can continue execution
-  OnAttackCompleted.ExecuteIfBound();
+  for (const FGameplayAbilitySpec &Spec : ASC->GetActivatableAbilities()) {
+    if (Cast<UCombatComboAttackAbility>(Spec.Ability)) {
+      AICommandHandles[static_cast<uint8>(ECombatAICommand::ComboAttack)] =
+          Spec.Handle;
+    } else if (Cast<UCombatChargedAttackAbility>(Spec.Ability)) {
+      AICommandHandles[static_cast<uint8>(ECombatAICommand::ChargedAttack)] =
+          Spec.Handle;
+    }
+  }
 }
 
-void ACombatEnemy::Tick(float DeltaTime) {
-  Super::Tick(DeltaTime);
-
-#if !UE_BUILD_SHIPPING
-  // Debug display for stamina used and damage taken
-  if (UAbilitySystemComponent *ASC = GetAbilitySystemComponent()) {
-    float Stamina =
-        ASC->GetNumericAttribute(UStaminaAttributeSet::GetStaminaAttribute());
-    float MaxStamina = ASC->GetNumericAttribute(
-        UStaminaAttributeSet::GetMaxStaminaAttribute());
-    float StaminaUsed = ASC->GetNumericAttribute(
-        UStaminaAttributeSet::GetStaminaUsedAttribute());
-    float Health =
-        ASC->GetNumericAttribute(UHealthAttributeSet::GetHealthAttribute());
-    float MaxHealth =
-        ASC->GetNumericAttribute(UHealthAttributeSet::GetMaxHealthAttribute());
-
-    FString DebugText =
-        FString::Printf(TEXT("Enemy - Stamina: %.1f/%.1f, Stamina Used: %.1f, "
-                             "Health: %.1f/%.1f"),
-                        Stamina, MaxStamina, StaminaUsed, Health, MaxHealth);
-
-    DrawDebugString(GetWorld(), GetActorLocation() + FVector(0, 0, 150),
-                    DebugText, nullptr, FColor::Red, 0.0f, true, 1.0f);
+void ACombatEnemy::HandleAbilityEnded(const FAbilityEndedData &EndedData) {
+  if (PendingCommandHandle.IsValid() &&
+      EndedData.AbilitySpecHandle == PendingCommandHandle) {
+    // interrupted attacks still hand control back to the StateTree
+    FinishAICommand(true);
   }
-#endif
+}
+
+void ACombatEnemy::FinishAICommand(bool bSucceeded) {
+  // the task may finish into a state that issues the next command right away
+  const FStateTreeWeakExecutionContext Waiter = PendingCommandWaiter;
+  ReleaseAICommand();
+
+  Waiter.FinishTask(bSucceeded ? EStateTreeFinishTaskType::Succeeded
+                               : EStateTreeFinishTaskType::Failed);
+}
+
+void ACombatEnemy::GetDebugDisplay(FString &OutLabel, FColor &OutColor) const {
+  OutLabel = TEXT("Enemy");
+  OutColor = FColor::Red;
 }
 
 void ACombatEnemy::HandleDeath() {
@@ -128,12 +241,30 @@ void ACombatEnemy::HandleDeath() {
   Super::HandleDeath();
 
   // hide the life bar
-  LifeBar->SetHiddenInGame(true);
+  if (LifeBar) {
+    LifeBar->SetHiddenInGame(true);
+  }
 
   // call the died delegate to notify any subscribers
   OnEnemyDied.Broadcast();
 }
 
+void ACombatEnemy::ApplyDamageReaction(float Damage,
+                                       const FVector &ImpactPoint,
+                                       const FVector &DamageImpulse) {
+  Super::ApplyDamageReaction(Damage, ImpactPoint, DamageImpulse);
+
+  if (HealthComponent && HealthComponent->IsDead()) {
+    return;
+  }
+
+  // stop the attack montages to interrupt the attack
+  if (UAnimInstance *AnimInstance = GetMesh()->GetAnimInstance()) {
+    AnimInstance->Montage_Stop(0.1f, ComboAttackMontage.Get());
+    AnimInstance->Montage_Stop(0.1f, ChargedAttackMontage.Get());
+  }
+}
+
 void ACombatEnemy::Landed(const FHitResult &Hit) {
   Super::Landed(Hit);
 
@@ -153,17 +284,24 @@ void ACombatEnemy::BeginPlay() {
   // Initialize ability system components
   InitializeAbilitySystemComponents();
 
-  // Initialize pawn data if available
-  InitializePawnData();
+  // Initialize pawn data if available, otherwise once it finishes streaming
+  if (HasCombatAssetsLoaded()) {
+    InitializePawnData();
+  }
+
+  // AI commands report back when their ability ends
+  if (AbilitySystemComponent) {
+    AbilitySystemComponent->OnAbilityEnded.AddUObject(
+        this, &ACombatEnemy::HandleAbilityEnded);
+  }
 
   Super::BeginPlay();
 }
 
-void ACombatEnemy::EndPlay(EEndPlayReason::Type EndPlayReason) {
-  Super::EndPlay(EndPlayReason);
+void ACombatEnemy::OnCombatAssetsLoaded() {
+  Super::OnCombatAssetsLoaded();
 
-  // clear the death timer
-  GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+  InitializePawnData();
 }
 
 void ACombatEnemy::InitializeAbilitySystemComponents() {
@@ -205,35 +343,34 @@ void ACombatEnemy::InitializeAbilitySystemComponents() {
 }
 
 void ACombatEnemy::InitializePawnData() {
-  if (!PawnData) {
-    return;
-  }
+  const UCombatPawnData *Data = GetPawnData();
 
   UAbilitySystemComponent *ASC = GetAbilitySystemComponent();
   if (!ASC) {
     return;
   }
 
-  // Load from data table if specified
-  PawnData->LoadFromDataTable();
-
   // Grant ability sets (server-only for multiplayer safety)
   if (HasAuthority()) {
     bool bHasAbilitySets = false;
+
+    // one grant index shared by every set
+    FCombatAbilityGrantIndex GrantIndex;
     for (const FCombatAbilitySetWithInput &AbilitySetWithInput :
-         PawnData->AbilitySets) {
-      if (AbilitySetWithInput.AbilitySet) {
+         Data->AbilitySets) {
+      // already resident when the spawner preloaded the Gameplay bundle
+      if (const UCombatAbilitySet *AbilitySet =
+              AbilitySetWithInput.AbilitySet.LoadSynchronous()) {
         FCombatAbilitySetHandle AbilitySetHandle;
-        AbilitySetWithInput.AbilitySet->GiveToAbilitySystem(
-            ASC, AbilitySetHandle, this);
+        AbilitySet->GiveToAbilitySystem(ASC, AbilitySetHandle, this,
+                                        &GrantIndex);
         bHasAbilitySets = true;
       }
     }
 
     // Fallback: If no ability sets are configured, add attribute sets directly
     if (!bHasAbilitySets) {
-      for (TSubclassOf<UAttributeSet> AttributeSetClass :
-           PawnData->AttributeSets) {
+      for (TSubclassOf<UAttributeSet> AttributeSetClass : Data->AttributeSets) {
         if (AttributeSetClass) {
           UAttributeSet *NewAttributeSet =
               NewObject<UAttributeSet>(ASC->GetOwner(), AttributeSetClass);
@@ -242,23 +379,10 @@ void ACombatEnemy::InitializePawnData() {
       }
     }
 
-    // Set attributes from pawn data
-    ASC->SetNumericAttributeBase(UHealthAttributeSet::GetHealthAttribute(),
-                                 PawnData->DefaultHealth);
-    ASC->SetNumericAttributeBase(UHealthAttributeSet::GetMaxHealthAttribute(),
-                                 PawnData->DefaultMaxHealth);
-    ASC->SetNumericAttributeBase(UStaminaAttributeSet::GetStaminaAttribute(),
-                                 PawnData->DefaultStamina);
-    ASC->SetNumericAttributeBase(UStaminaAttributeSet::GetMaxStaminaAttribute(),
-                                 PawnData->DefaultMaxStamina);
-    ASC->SetNumericAttributeBase(UDamageAttributeSet::GetDamageAttribute(),
-                                 PawnData->DefaultDamage);
-    ASC->SetNumericAttributeBase(
-        UDamageAttributeSet::GetKnockbackImpulseAttribute(),
-        PawnData->DefaultKnockbackImpulse);
-    ASC->SetNumericAttributeBase(
-        UDamageAttributeSet::GetLaunchImpulseAttribute(),
-        PawnData->DefaultLaunchImpulse);
+    // Set attributes from pawn data and per-instance overrides
+    Data->InitializeAttributes(ASC, PawnDataOverrides);
+
+    CacheAICommandHandles();
   }
 }
 
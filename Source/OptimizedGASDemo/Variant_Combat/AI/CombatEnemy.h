@@ -9,7 +9,6 @@
 #include "CombatAttacker.h"
 #include "CombatDamageable.h"
 #include "Animation/AnimMontage.h"
-#include "Engine/TimerHandle.h"
 #include "Data/CombatPawnData.h"
 #include "Health/CombatHealthComponent.h"
 #include "Data/CombatDamageEventData.h"
@@ -24,10 +23,11 @@
 #include "Abilities/CombatChargedAttackAbility.h"
 #include "Abilities/CombatComboAttackAbility.h"
 #include "Abilities/CombatNotifyEnemiesAbility.h"
+#include "StateTreeAsyncExecutionContext.h"
 #include "CombatEnemy.generated.h"
 
-/** Completed attack animation delegate for StateTree */
-DECLARE_DELEGATE(FOnEnemyAttackCompleted);
+/** Commands the StateTree gives an enemy through its cached ability handles */
+enum class ECombatAICommand : uint8 { ComboAttack, ChargedAttack };
 
 /** Landed delegate for StateTree */
 DECLARE_DELEGATE(FOnEnemyLanded);
@@ -81,9 +81,6 @@ public:
   virtual UAbilitySystemComponent *GetAbilitySystemComponent() const override;
   // ~end IAbilitySystemInterface
 
-  /** Attack completed internal delegate to notify StateTree tasks */
-  FOnEnemyAttackCompleted OnAttackCompleted;
-
   /** Landed internal delegate to notify StateTree tasks. We use this instead of
    * the built-in Landed delegate so we can bind to a Lambda in StateTree tasks
    */
@@ -95,7 +92,9 @@ public:
   FOnEnemyDied OnEnemyDied;
 
   /** Get combo attack montage */
-  UAnimMontage *GetComboAttackMontage() const { return ComboAttackMontage; }
+  UAnimMontage *GetComboAttackMontage() const {
+    return ComboAttackMontage.Get();
+  }
 
   /** Get combo section names */
   const TArray<FName> &GetComboSectionNames() const {
@@ -103,7 +102,9 @@ public:
   }
 
   /** Get charged attack montage */
-  UAnimMontage *GetChargedAttackMontage() const { return ChargedAttackMontage; }
+  UAnimMontage *GetChargedAttackMontage() const {
+    return ChargedAttackMontage.Get();
+  }
 
   /** Get charge loop section name */
   FName GetChargeLoopSection() const { return ChargeLoopSection; }
@@ -137,17 +138,33 @@ public:
   int32 CurrentChargeLoop = 0;
 
 public:
-  /** Performs an AI-initiated combo attack. Number of hits will be decided by
-   * this character */
-  void DoAIComboAttack();
+  /** Activates the ability behind an AI command by its cached spec handle.
+   * The waiting StateTree task is finished when the ability ends, or right
+   * away if it could not activate. Returns true if the ability is running */
+  bool ExecuteAICommand(ECombatAICommand Command,
+                        const FStateTreeWeakExecutionContext &Waiter);
+
+  /** Stops reporting the pending command to the task that issued it */
+  void ReleaseAICommand();
+
+protected:
+  /** Cache the spec handles of the abilities AI commands activate */
+  void CacheAICommandHandles();
 
-  /** Performs an AI-initiated charged attack. Charge time will be decided by
-   * this character */
-  void DoAIChargedAttack();
+  /** Finish the pending command when its ability ends */
+  void HandleAbilityEnded(const FAbilityEndedData &EndedData);
 
-  /** Called from a delegate when the attack montage ends */
-  virtual void AttackMontageEnded(UAnimMontage *Montage,
-                                  bool bInterrupted) override;
+  /** Finish the pending command's task and forget it */
+  void FinishAICommand(bool bSucceeded);
+
+  /** Spec handles of the command abilities, indexed by ECombatAICommand */
+  FGameplayAbilitySpecHandle AICommandHandles[2];
+
+  /** Ability of the command in progress */
+  FGameplayAbilitySpecHandle PendingCommandHandle;
+
+  /** StateTree task waiting on the command in progress */
+  FStateTreeWeakExecutionContext PendingCommandWaiter;
 
 public:
   // ~begin ICombatAttacker interface
@@ -162,15 +179,13 @@ public:
   /** Overrides landing to reset damage ragdoll physics */
   virtual void Landed(const FHitResult &Hit) override;
 
-  /** Tick function for debug display */
-  virtual void Tick(float DeltaTime) override;
-
 protected:
   /** Gameplay initialization */
   virtual void BeginPlay() override;
 
-  /** EndPlay cleanup */
-  virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+  /** Label the attribute debug text as an enemy */
+  virtual void GetDebugDisplay(FString &OutLabel,
+                               FColor &OutColor) const override;
 
   /** Initialize the ability system components */
   void InitializeAbilitySystemComponents();
@@ -178,9 +193,16 @@ protected:
   /** Initialize pawn data and grant abilities/effects */
   void InitializePawnData();
 
+  /** Grants the pawn data that was still streaming at BeginPlay */
+  virtual void OnCombatAssetsLoaded() override;
+
   /** Handles death events */
   virtual void HandleDeath() override;
 
+  /** Interrupts attacks when hit */
+  virtual void ApplyDamageReaction(float Damage, const FVector &ImpactPoint,
+                                   const FVector &DamageImpulse) override;
+
   /** Handle movement speed attribute changes */
   void HandleMovementSpeedChanged(const FOnAttributeChangeData &Data);
 };
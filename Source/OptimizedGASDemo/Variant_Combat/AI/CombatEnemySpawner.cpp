@@ -6,8 +6,9 @@
 #include "Components/SceneComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/ArrowComponent.h"
-#include "TimerManager.h"
+#include "Engine/AssetManager.h"
 #include "CombatEnemy.h"
+#include "Data/CombatPawnData.h"
 
 ACombatEnemySpawner::ACombatEnemySpawner()
 {
@@ -35,8 +36,11 @@ void ACombatEnemySpawner::BeginPlay()
 	// should we spawn an enemy right away?
 	if (bShouldSpawnEnemiesImmediately)
 	{
-		// schedule the first enemy spawn
-		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, InitialSpawnDelay);
+		// start loading the enemy so it is ready by the first spawn
+		PreloadEnemyAssets();
+
+		// start the first wave after the initial delay
+		StartWaves(InitialSpawnDelay);
 	}
 
 }
@@ -45,49 +49,86 @@ void ACombatEnemySpawner::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	// clear the spawn timer
-	GetWorld()->GetTimerManager().ClearTimer(SpawnTimer);
+	// clear the activation timer
+	if (UCombatTimerSubsystem* Timers = GetWorld()->GetSubsystem<UCombatTimerSubsystem>())
+	{
+		Timers->ClearTimer(SpawnTimer);
+	}
+
+	// stop our waves and drop any spawns still queued for us
+	if (UCombatSpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<UCombatSpawnDirectorSubsystem>())
+	{
+		Director->StopWaves(this);
+	}
+
+	// release anything we are still holding on to
+	ReleaseEnemyAssets();
 }
 
-void ACombatEnemySpawner::SpawnEnemy()
+FTransform ACombatEnemySpawner::GetSpawnTransform() const
 {
-	// ensure the enemy class is valid
-	if (IsValid(EnemyClass))
+	return SpawnCapsule->GetComponentTransform();
+}
+
+void ACombatEnemySpawner::StartWaves(float InitialDelay)
+{
+	if (UCombatSpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<UCombatSpawnDirectorSubsystem>())
 	{
-		// spawn the enemy at the reference capsule's transform
-		FActorSpawnParameters SpawnParams;
-		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		Director->StartWaves(this, EnemyClass, GetWavesToRun(), InitialDelay);
+	}
+}
 
-		ACombatEnemy* SpawnedEnemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, SpawnCapsule->GetComponentTransform(), SpawnParams);
+TArray<FCombatSpawnWave> ACombatEnemySpawner::GetWavesToRun() const
+{
+	if (Waves.Num() > 0)
+	{
+		return Waves;
+	}
 
-		// was the enemy successfully created?
-		if (SpawnedEnemy)
-		{
-			// subscribe to the death delegate
-			SpawnedEnemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
-		}
+	// spawners without waves spawn their enemies one at a time
+	TArray<FCombatSpawnWave> SingleWave;
+	if (SpawnCount > 0)
+	{
+		FCombatSpawnWave& Wave = SingleWave.AddDefaulted_GetRef();
+		Wave.Count = SpawnCount;
+		Wave.MaxAlive = 1;
+		Wave.RespawnDelay = RespawnDelay;
 	}
+
+	return SingleWave;
 }
 
-void ACombatEnemySpawner::OnEnemyDied()
+void ACombatEnemySpawner::HandleEnemySpawned(ACombatEnemy* SpawnedEnemy)
 {
-	// decrease the spawn counter
-	--SpawnCount;
+	// subscribe to the death delegate
+	SpawnedEnemy->OnEnemyDied.AddDynamic(this, &ACombatEnemySpawner::OnEnemyDied);
+}
 
-	// is this the last enemy we should spawn?
-	if (SpawnCount <= 0)
+void ACombatEnemySpawner::OnEnemyDied()
+{
+	// let the director schedule the replacement or clear the wave
+	if (UCombatSpawnDirectorSubsystem* Director = GetWorld()->GetSubsystem<UCombatSpawnDirectorSubsystem>())
 	{
-		// schedule the activation on depleted message
-		GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnerDepleted, ActivationDelay);
-		return;
+		Director->NotifyEnemyDied(this);
 	}
+}
+
+void ACombatEnemySpawner::HandleWavesCleared()
+{
+	bDepleted = true;
 
-	// schedule the next enemy spawn
-	GetWorld()->GetTimerManager().SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnEnemy, RespawnDelay);
+	// schedule the activation on depleted message
+	if (UCombatTimerSubsystem* Timers = GetWorld()->GetSubsystem<UCombatTimerSubsystem>())
+	{
+		Timers->SetTimer(SpawnTimer, this, &ACombatEnemySpawner::SpawnerDepleted, ActivationDelay);
+	}
 }
 
 void ACombatEnemySpawner::SpawnerDepleted()
 {
+	// no more enemies will be spawned, so let the assets unload once the last one is gone
+	ReleaseEnemyAssets();
+
 	// process the actors to activate list
 	for (AActor* CurrentActor : ActorsToActivateWhenDepleted)
 	{
@@ -116,11 +157,111 @@ void ACombatEnemySpawner::ActivateInteraction(AActor* ActivationInstigator)
 	// raise the activation flag
 	bHasBeenActivated = true;
 
-	// spawn the first enemy
-	SpawnEnemy();
+	// in case no activation volume preloaded us ahead of time
+	PreloadEnemyAssets();
+
+	// start the first wave right away
+	StartWaves(0.0f);
 }
 
 void ACombatEnemySpawner::DeactivateInteraction(AActor* ActivationInstigator)
 {
 	// stub
 }
+
+void ACombatEnemySpawner::PreloadInteraction(AActor* ActivationInstigator)
+{
+	// only deferred spawners need a preload, the others start loading on BeginPlay
+	if (bHasBeenActivated || bShouldSpawnEnemiesImmediately)
+	{
+		return;
+	}
+
+	PreloadEnemyAssets();
+}
+
+void ACombatEnemySpawner::PreloadEnemyAssets()
+{
+	// skip repeated requests and spawners with nothing left to spawn
+	if (PreloadHandles.Num() > 0 || EnemyClass.IsNull() || bDepleted || GetWavesToRun().Num() == 0)
+	{
+		return;
+	}
+
+	// load the class first, its defaults tell us which pawn data and montages to load
+	TSharedPtr<FStreamableHandle> ClassHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		EnemyClass.ToSoftObjectPath(), FStreamableDelegate::CreateUObject(this, &ACombatEnemySpawner::OnEnemyClassLoaded));
+
+	if (ClassHandle.IsValid())
+	{
+		PreloadHandles.Add(ClassHandle);
+	}
+}
+
+void ACombatEnemySpawner::OnEnemyClassLoaded()
+{
+	UClass* LoadedEnemyClass = EnemyClass.Get();
+
+	// ignore loads that finish after the spawner was depleted
+	if (!LoadedEnemyClass || bDepleted)
+	{
+		return;
+	}
+
+	const ACombatEnemy* EnemyDefaults = LoadedEnemyClass->GetDefaultObject<ACombatEnemy>();
+	UAssetManager& AssetManager = UAssetManager::Get();
+
+	TSet<FSoftObjectPath> PathsToLoad;
+
+	// resolve the pawn data bundles through the asset manager
+	const FSoftObjectPath PawnDataPath = EnemyDefaults->GetPawnDataAsset().ToSoftObjectPath();
+	const FPrimaryAssetId PawnDataId = AssetManager.GetPrimaryAssetIdForPath(PawnDataPath);
+	if (PawnDataId.IsValid())
+	{
+		AssetManager.GetPrimaryAssetLoadSet(PathsToLoad, PawnDataId, { UCombatPawnData::GameplayBundle }, true);
+	}
+	else if (!PawnDataPath.IsNull())
+	{
+		// not registered with the asset manager, so only the asset itself can be preloaded
+		PathsToLoad.Add(PawnDataPath);
+	}
+
+	// montages live on the character
+	TArray<FSoftObjectPath> MontagePaths;
+	EnemyDefaults->GetMontagesToLoad(MontagePaths);
+	PathsToLoad.Append(MontagePaths);
+
+	if (PathsToLoad.Num() > 0)
+	{
+		// use our own handle so spawners sharing the same pawn data release independently
+		TSharedPtr<FStreamableHandle> AssetsHandle = AssetManager.GetStreamableManager().RequestAsyncLoad(PathsToLoad.Array());
+
+		if (AssetsHandle.IsValid())
+		{
+			PreloadHandles.Add(AssetsHandle);
+		}
+	}
+}
+
+void ACombatEnemySpawner::ReleaseEnemyAssets()
+{
+	for (TSharedPtr<FStreamableHandle>& Handle : PreloadHandles)
+	{
+		if (!Handle.IsValid())
+		{
+			continue;
+		}
+
+		// stop pending loads, release finished ones
+		if (Handle->IsLoadingInProgress())
+		{
+			Handle->CancelHandle();
+		}
+		else
+		{
+			Handle->ReleaseHandle();
+		}
+	}
+
+	PreloadHandles.Empty();
+}
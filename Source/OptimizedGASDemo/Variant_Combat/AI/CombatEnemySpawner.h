@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatActivatable.h"
+#include "Engine/StreamableManager.h"
+#include "CombatTimerSubsystem.h"
+#include "CombatSpawnDirectorSubsystem.h"
 #include "CombatEnemySpawner.generated.h"
 
 class UCapsuleComponent;
@@ -13,9 +16,11 @@ class ACombatEnemy;
 
 /**
  *  A basic Actor in charge of spawning Enemy Characters and monitoring their deaths.
- *  Enemies will be spawned one by one, and the spawner will wait until the enemy dies before spawning a new one.
+ *  Enemies are spawned in waves run by the spawn director, which spreads the spawns of every spawner across frames.
+ *  Without waves, enemies will be spawned one by one, and the spawner will wait until the enemy dies before spawning a new one.
  *  The spawner can be remotely activated through the ICombatActivatable interface
  *  When the last spawned enemy dies, the spawner can also activate other ICombatActivatables
+ *  The enemy class, pawn data bundles and montages are loaded asynchronously ahead of the first spawn and released when the spawner is depleted
  */
 UCLASS(abstract)
 class ACombatEnemySpawner : public AActor, public ICombatActivatable
@@ -32,7 +37,7 @@ protected:
 
 	/** Type of enemy to spawn */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner")
-	TSubclassOf<ACombatEnemy> EnemyClass;
+	TSoftClassPtr<ACombatEnemy> EnemyClass;
 
 	/** If true, the first enemy will be spawned as soon as the game starts */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner")
@@ -42,14 +47,18 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 0, ClampMax = 10))
 	float InitialSpawnDelay = 5.0f;
 
-	/** Number of enemies to spawn */
+	/** Number of enemies to spawn one at a time. Only used when no waves are set */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 0, ClampMax = 100))
 	int32 SpawnCount = 1;
 
-	/** Time to wait before spawning the next enemy after the current one dies */
+	/** Time to wait before spawning the next enemy after the current one dies. Only used when no waves are set */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner", meta = (ClampMin = 0, ClampMax = 10))
 	float RespawnDelay = 5.0f;
 
+	/** Waves of enemies to spawn in order. Each wave starts once every enemy of the previous one is dead */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Enemy Spawner")
+	TArray<FCombatSpawnWave> Waves;
+
 	/** Time to wait after this spawner is depleted before activating the actor list */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Activation", meta = (ClampMin = 0, ClampMax = 10))
 	float ActivationDelay = 1.0f;
@@ -61,14 +70,35 @@ protected:
 	/** Flag to ensure this is only activated once */
 	bool bHasBeenActivated = false;
 
-	/** Timer to spawn enemies after a delay */
-	FTimerHandle SpawnTimer;
+	/** Set once the last wave is cleared */
+	bool bDepleted = false;
+
+	/** Timer to activate the actor list after a delay */
+	FCombatTimerHandle SpawnTimer;
+
+	/** Streaming handles keeping the enemy assets loaded until the spawner is depleted */
+	TArray<TSharedPtr<FStreamableHandle>> PreloadHandles;
 
 public:	
 	
 	/** Constructor */
 	ACombatEnemySpawner();
 
+	/** Returns the type of enemy this spawner spawns */
+	const TSoftClassPtr<ACombatEnemy>& GetEnemyClass() const { return EnemyClass; }
+
+	/** Returns true if this spawner starts spawning on BeginPlay instead of waiting for an activation */
+	bool ShouldSpawnEnemiesImmediately() const { return bShouldSpawnEnemiesImmediately; }
+
+	/** Returns the transform of the reference spawn capsule */
+	FTransform GetSpawnTransform() const;
+
+	/** Called by the spawn director when it spawned an enemy for this spawner */
+	void HandleEnemySpawned(ACombatEnemy* SpawnedEnemy);
+
+	/** Called by the spawn director after the last wave is cleared */
+	void HandleWavesCleared();
+
 public:
 
 	/** Initialization */
@@ -79,16 +109,28 @@ public:
 
 protected:
 
-	/** Spawn an enemy and subscribe to its death event */
-	void SpawnEnemy();
+	/** Hands the waves to the spawn director */
+	void StartWaves(float InitialDelay);
 
-	/** Called when the spawned enemy has died */
+	/** Returns the waves to run, or a single wave built from SpawnCount and RespawnDelay */
+	TArray<FCombatSpawnWave> GetWavesToRun() const;
+
+	/** Called when a spawned enemy has died */
 	UFUNCTION()
 	void OnEnemyDied();
 
 	/** Called after the last spawned enemy has died */
 	void SpawnerDepleted();
 
+	/** Starts loading the enemy class asynchronously */
+	void PreloadEnemyAssets();
+
+	/** Loads the pawn data bundles and montages once the enemy class is loaded */
+	void OnEnemyClassLoaded();
+
+	/** Releases the preloaded enemy assets */
+	void ReleaseEnemyAssets();
+
 public:
 
 	// ~begin ICombatActivatable interface
@@ -105,5 +147,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Activatable")
 	virtual void DeactivateInteraction(AActor* ActivationInstigator) override;
 
+	/** Preloads the enemy assets ahead of a deferred activation */
+	virtual void PreloadInteraction(AActor* ActivationInstigator) override;
+
 	// ~end IActivatable interface
 };
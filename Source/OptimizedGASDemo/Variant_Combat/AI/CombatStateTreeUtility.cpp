@@ -72,17 +72,8 @@ EStateTreeRunStatus FStateTreeComboAttackTask::EnterState(FStateTreeExecutionCon
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-		// bind to the on attack completed delegate
-		InstanceData.Character->OnAttackCompleted.BindLambda(
-			[WeakContext = Context.MakeWeakExecutionContext()]()
-			{
-				WeakContext.FinishTask(EStateTreeFinishTaskType::Succeeded);
-			}
-		);
-
-
-		// tell the character to do a combo attack
-		InstanceData.Character->DoAIComboAttack();
+		// tell the character to do a combo attack. The character finishes this task when the attack ability ends
+		InstanceData.Character->ExecuteAICommand(ECombatAICommand::ComboAttack, Context.MakeWeakExecutionContext());
 	}
 
 	return EStateTreeRunStatus::Running;
@@ -96,8 +87,8 @@ void FStateTreeComboAttackTask::ExitState(FStateTreeExecutionContext& Context, c
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-		// unbind the on attack completed delegate
-		InstanceData.Character->OnAttackCompleted.Unbind();
+		// stop the character from finishing this task once the state is left
+		InstanceData.Character->ReleaseAICommand();
 	}
 }
 
@@ -118,16 +109,8 @@ EStateTreeRunStatus FStateTreeChargedAttackTask::EnterState(FStateTreeExecutionC
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-		// bind to the on attack completed delegate
-		InstanceData.Character->OnAttackCompleted.BindLambda(
-			[WeakContext = Context.MakeWeakExecutionContext()]()
-			{
-				WeakContext.FinishTask(EStateTreeFinishTaskType::Succeeded);
-			}
-		);
-
-		// tell the character to do a combo attack
-		InstanceData.Character->DoAIChargedAttack();
+		// tell the character to do a charged attack. The character finishes this task when the attack ability ends
+		InstanceData.Character->ExecuteAICommand(ECombatAICommand::ChargedAttack, Context.MakeWeakExecutionContext());
 	}
 
 	return EStateTreeRunStatus::Running;
@@ -141,8 +124,8 @@ void FStateTreeChargedAttackTask::ExitState(FStateTreeExecutionContext& Context,
 		// get the instance data
 		FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 
-		// unbind the on attack completed delegate
-		InstanceData.Character->OnAttackCompleted.Unbind();
+		// stop the character from finishing this task once the state is left
+		InstanceData.Character->ReleaseAICommand();
 	}
 }
 
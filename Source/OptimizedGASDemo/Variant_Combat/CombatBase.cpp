@@ -20,12 +20,30 @@
 #include "Abilities/CombatComboAttackAbility.h"
 #include "Abilities/CombatStaminaRegenerationAbility.h"
 #include "Effects/CombatStaminaCostGameplayEffect.h"
+#include "Effects/CombatDamageGameplayEffect.h"
 #include "Data/CombatAttackEventData.h"
 #include "Data/CombatDamageEventData.h"
 #include "UI/CombatLifeBar.h"
+#include "CombatCosmetics.h"
+#include "CombatProjectileSubsystem.h"
+#include "CombatRagdollSubsystem.h"
+#include "CombatSpatialIndexSubsystem.h"
+#include "CombatTickSubsystem.h"
+#include "CombatTimerSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "DrawDebugHelpers.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Actor Tick"), STAT_CombatActorTick,
+                   STATGROUP_Combat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Actor Ticks"), STAT_CombatActorTicks,
+                           STATGROUP_Combat);
 
 ACombatBase::ACombatBase() {
+  // per-frame work runs from UCombatTickSubsystem, the actor tick is only
+  // enabled for comparison or Blueprint Event Tick
   PrimaryActorTick.bCanEverTick = true;
+  PrimaryActorTick.bStartWithTickEnabled = false;
 
   // bind the attack montage ended delegate
   OnAttackMontageEnded.BindUObject(this, &ACombatBase::AttackMontageEnded);
@@ -33,9 +51,11 @@ ACombatBase::ACombatBase() {
   // Set size for collision capsule
   GetCapsuleComponent()->InitCapsuleSize(35.0f, 90.0f);
 
+#if WITH_COMBAT_COSMETICS
   // create the life bar widget component
   LifeBar = CreateDefaultSubobject<UWidgetComponent>(TEXT("LifeBar"));
   LifeBar->SetupAttachment(RootComponent);
+#endif
 
   // create the health component
   HealthComponent =
@@ -45,34 +65,59 @@ ACombatBase::ACombatBase() {
   StaminaComponent =
       CreateDefaultSubobject<UCombatStaminaComponent>(TEXT("StaminaComponent"));
 
-  // Create default pawn data with abilities
-  PawnData = CreateDefaultSubobject<UCombatPawnData>(TEXT("PawnData"));
-  if (PawnData) {
-    // Set attribute sets
-    PawnData->AttributeSets.Add(UHealthAttributeSet::StaticClass());
-    PawnData->AttributeSets.Add(UDamageAttributeSet::StaticClass());
-    PawnData->AttributeSets.Add(UStaminaAttributeSet::StaticClass());
-    PawnData->AttributeSets.Add(UMovementAttributeSet::StaticClass());
+  // create the melee hitbox component
+  HitboxComponent =
+      CreateDefaultSubobject<UCombatHitboxComponent>(TEXT("HitboxComponent"));
 
-    // Set default attributes
-    PawnData->DefaultHealth = MaxHP;
-    PawnData->DefaultMaxHealth = MaxHP;
-    PawnData->DefaultStamina = 100.0f;
-    PawnData->DefaultMaxStamina = 100.0f;
-    PawnData->DefaultDamage = MeleeDamage;
-    PawnData->DefaultKnockbackImpulse = MeleeKnockbackImpulse;
-    PawnData->DefaultLaunchImpulse = MeleeLaunchImpulse;
-
-    // Note: AbilitySets should be configured in the editor or derived classes
-    // Note: Lock ability is set in subclasses (LockToggle for player, Lockable
-    // for enemy)
-  }
+  // Pawn data is a shared asset assigned in Blueprint defaults. AbilitySets
+  // should be configured there (LockToggle for player, Lockable for enemy)
 }
 
 UAbilitySystemComponent *ACombatBase::GetAbilitySystemComponent() const {
   return nullptr;
 }
 
+const UCombatPawnData *ACombatBase::GetPawnData() const {
+  if (const UCombatPawnData *Data = PawnData.Get()) {
+    return Data;
+  }
+  return GetDefault<UCombatDefaultPawnData>();
+}
+
+void ACombatBase::GetMontagesToLoad(TArray<FSoftObjectPath> &OutPaths) const {
+  if (!ComboAttackMontage.IsNull()) {
+    OutPaths.Add(ComboAttackMontage.ToSoftObjectPath());
+  }
+  if (!ChargedAttackMontage.IsNull()) {
+    OutPaths.Add(ChargedAttackMontage.ToSoftObjectPath());
+  }
+}
+
+void ACombatBase::PostInitializeComponents() {
+  Super::PostInitializeComponents();
+
+  CombatQueryParams =
+      FCollisionQueryParams(SCENE_QUERY_STAT(CombatAbility), false, this);
+
+  // spawners and the level warmup preload these, so the request usually
+  // completes at once. Anything still streaming is picked up in BeginPlay
+  TArray<FSoftObjectPath> Paths;
+  if (!PawnData.IsNull()) {
+    Paths.Add(PawnData.ToSoftObjectPath());
+  }
+  GetMontagesToLoad(Paths);
+
+  if (Paths.Num() > 0) {
+    CombatAssetsHandle =
+        UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths);
+  }
+}
+
+bool ACombatBase::HasCombatAssetsLoaded() const {
+  return !CombatAssetsHandle.IsValid() ||
+         CombatAssetsHandle->HasLoadCompleted();
+}
+
 void ACombatBase::DoAttackTrace(FName DamageSourceBone) {
   // Create attack event data with damage source bone
   UCombatAttackEventData *AttackData = NewObject<UCombatAttackEventData>(this);
@@ -103,16 +148,53 @@ void ACombatBase::CheckChargedAttack() {
 void ACombatBase::ApplyDamage(float Damage, AActor *DamageCauser,
                               const FVector &DamageLocation,
                               const FVector &DamageImpulse) {
-  UCombatDamageEventData *DamageData = NewObject<UCombatDamageEventData>();
-  DamageData->Location = DamageLocation;
-  DamageData->Impulse = DamageImpulse;
+  // damage from non-GAS sources goes through the same damage spec as attacks
+  UAbilitySystemComponent *ASC = GetAbilitySystemComponent();
+  if (!ASC || !HasAuthority()) {
+    return;
+  }
 
-  SendGameplayEvent(
-      FGameplayTag::RequestGameplayTag(FName("Event.Damage.Received")), Damage,
-      DamageData, DamageCauser);
+  // encode the impulse as a hit against its horizontal direction
+  const FVector Knockback(DamageImpulse.X, DamageImpulse.Y, 0.0f);
+  FHitResult HitResult;
+  HitResult.ImpactPoint = DamageLocation;
+  HitResult.ImpactNormal = -Knockback.GetSafeNormal();
+
+  // causers with an ability system (e.g. the shooter of a projectile) are the
+  // source so their damage multiplier applies, anything else (lava, props)
+  // makes the victim its own source
+  UAbilitySystemComponent *SourceASC =
+      UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(DamageCauser);
+  if (!SourceASC) {
+    SourceASC = ASC;
+  }
+
+  FGameplayEffectSpecHandle SpecHandle =
+      UCombatDamageGameplayEffect::MakeDamageSpec(
+          SourceASC, UCombatDamageGameplayEffect::StaticClass(), Damage,
+          HitResult, Knockback.Size(), DamageImpulse.Z, DamageCauser,
+          DamageCauser);
+  if (SpecHandle.IsValid()) {
+    SourceASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), ASC);
+  }
 }
 
 void ACombatBase::HandleDeath() {
+  // the dead are no longer area attack targets
+  if (UCombatSpatialIndexSubsystem *SpatialIndex =
+          GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>()) {
+    SpatialIndex->UnregisterTarget(SpatialHandle);
+  }
+
+  // attacks pass through the dead
+  HitboxComponent->SetHitboxesEnabled(false);
+
+  // the death ragdoll takes its own slot
+  if (UCombatRagdollSubsystem *Ragdolls =
+          GetWorld()->GetSubsystem<UCombatRagdollSubsystem>()) {
+    Ragdolls->StopKnockback(GetMesh());
+  }
+
   SendGameplayEvent(FGameplayTag::RequestGameplayTag(FName("Event.Death")));
 }
 
@@ -139,24 +221,65 @@ void ACombatBase::Landed(const FHitResult &Hit) {
   if (GetMesh()) {
     GetMesh()->SetWorldTransform(GetMesh()->GetComponentTransform());
   }
+
+  // the knockback blend ends on landing, free its ragdoll slot
+  if (UCombatRagdollSubsystem *Ragdolls =
+          GetWorld()->GetSubsystem<UCombatRagdollSubsystem>()) {
+    Ragdolls->StopKnockback(GetMesh());
+  }
 }
 
 void ACombatBase::BeginPlay() {
   Super::BeginPlay();
 
-  // get the life bar widget from the widget comp
-  LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
-  check(LifeBarWidget);
+  if (LifeBar && !CombatCosmetics::ShouldRun(GetWorld())) {
+    // dedicated servers never display the life bar, so drop the component
+    // instead of ticking it
+    LifeBar->DestroyComponent();
+    LifeBar = nullptr;
+  }
+
+  if (LifeBar) {
+    // get the life bar widget from the widget comp
+    LifeBarWidget = Cast<UCombatLifeBar>(LifeBar->GetUserWidgetObject());
+    check(LifeBarWidget);
+
+    // fill the life bar
+    LifeBarWidget->SetLifePercentage(1.0f);
+  }
+
+  // melee traces hit these instead of the capsule
+  HitboxComponent->BuildHitboxes(GetMesh(), TeamId);
+
+  // the server decides hits with the bone hitboxes, so keep the bones posed
+  // even though a dedicated server never renders the mesh
+  if (HasAuthority()) {
+    GetMesh()->VisibilityBasedAnimTickOption =
+        EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+  }
+
+  // camera, debug and life bar updates run from the batched combat tick
+  if (UCombatTickSubsystem *TickManager =
+          GetWorld()->GetSubsystem<UCombatTickSubsystem>()) {
+    TickManager->RegisterCombatant(this);
+  }
 
-  // fill the life bar
-  LifeBarWidget->SetLifePercentage(1.0f);
+  // area attacks find us through the spatial index instead of a sweep
+  if (UCombatSpatialIndexSubsystem *SpatialIndex =
+          GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>()) {
+    SpatialHandle = SpatialIndex->RegisterTarget(this, TeamId);
+  }
 
-  // Bind to health component delegates for UI updates
+  // Bind to health component delegates for UI updates, damage and death
   if (HealthComponent) {
     HealthComponent->OnHealthChanged.AddUObject(
         this, &ACombatBase::OnHealthComponentChanged);
     HealthComponent->OnMaxHealthChanged.AddUObject(
         this, &ACombatBase::OnMaxHealthComponentChanged);
+    HealthComponent->OnDamageTaken.AddUObject(this,
+                                              &ACombatBase::HandleDamageTaken);
+    HealthComponent->OnOutOfHealth.AddUObject(this,
+                                              &ACombatBase::HandleOutOfHealth);
   }
 
   // Bind to stamina component delegates
@@ -166,10 +289,212 @@ void ACombatBase::BeginPlay() {
     StaminaComponent->OnMaxStaminaChanged.AddUObject(
         this, &ACombatBase::OnMaxStaminaComponentChanged);
   }
+
+  // finish the pawn data setup once the assets arrive
+  if (!HasCombatAssetsLoaded()) {
+    CombatAssetsHandle->BindCompleteDelegate(
+        FStreamableDelegate::CreateUObject(this,
+                                           &ACombatBase::OnCombatAssetsLoaded));
+  }
 }
 
 void ACombatBase::EndPlay(const EEndPlayReason::Type EndPlayReason) {
   Super::EndPlay(EndPlayReason);
+
+  if (UCombatTickSubsystem *TickManager =
+          GetWorld()->GetSubsystem<UCombatTickSubsystem>()) {
+    TickManager->UnregisterCombatant(this);
+  }
+
+  if (UCombatSpatialIndexSubsystem *SpatialIndex =
+          GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>()) {
+    SpatialIndex->UnregisterTarget(SpatialHandle);
+  }
+
+  if (UCombatRagdollSubsystem *Ragdolls =
+          GetWorld()->GetSubsystem<UCombatRagdollSubsystem>()) {
+    Ragdolls->StopKnockback(GetMesh());
+  }
+
+  // cancel timers owned by this character and its components
+  if (UCombatTimerSubsystem *Timers =
+          GetWorld()->GetSubsystem<UCombatTimerSubsystem>()) {
+    Timers->ClearAllTimers(this);
+  }
+
+  if (CombatAssetsHandle.IsValid()) {
+    CombatAssetsHandle->ReleaseHandle();
+    CombatAssetsHandle.Reset();
+  }
+}
+
+void ACombatBase::Tick(float DeltaTime) {
+  SCOPE_CYCLE_COUNTER(STAT_CombatActorTick);
+  INC_DWORD_STAT(STAT_CombatActorTicks);
+
+  Super::Tick(DeltaTime);
+
+  // the tick manager runs this work when batching is on
+  if (UCombatTickSubsystem::IsBatchingEnabled()) {
+    return;
+  }
+
+  if (NeedsCameraUpdate()) {
+    UpdateCamera(DeltaTime);
+  }
+
+#if ENABLE_DRAW_DEBUG
+  if (CombatCosmetics::ShouldDrawDebug(GetWorld())) {
+    DrawDebugAttributes();
+  }
+#endif
+
+  if (CombatCosmetics::ShouldRun(GetWorld())) {
+    TArray<FVector, TInlineAllocator<4>> ViewLocations;
+    UCombatTickSubsystem::GetViewLocations(GetWorld(), ViewLocations);
+    UCombatTickSubsystem::UpdateLifeBarLOD(this, ViewLocations);
+  }
+}
+
+void ACombatBase::MulticastFireProjectiles_Implementation(
+    FVector_NetQuantize Muzzle,
+    const TArray<FVector_NetQuantizeNormal> &Directions,
+    const FCombatProjectileParams &Params) {
+  // the server already fired them and owns their hits
+  if (HasAuthority()) {
+    return;
+  }
+
+  if (UCombatProjectileSubsystem *Projectiles =
+          GetWorld()->GetSubsystem<UCombatProjectileSubsystem>()) {
+    for (const FVector_NetQuantizeNormal &Direction : Directions) {
+      Projectiles->FireProjectile(Muzzle, Direction, Params, this);
+    }
+  }
+}
+
+void ACombatBase::SetGenericTeamId(const FGenericTeamId &NewTeamID) {
+  TeamId = NewTeamID;
+  HitboxComponent->SetTeam(TeamId);
+
+  if (UCombatSpatialIndexSubsystem *SpatialIndex =
+          GetWorld() ? GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>()
+                     : nullptr) {
+    SpatialIndex->SetTeam(SpatialHandle, TeamId);
+  }
+}
+
+void ACombatBase::GetDebugDisplay(FString &OutLabel, FColor &OutColor) const {
+  OutLabel = TEXT("Combatant");
+  OutColor = FColor::White;
+}
+
+void ACombatBase::DrawDebugAttributes() const {
+#if ENABLE_DRAW_DEBUG
+  // Debug display for stamina used and damage taken
+  UAbilitySystemComponent *ASC = GetAbilitySystemComponent();
+  if (!ASC) {
+    return;
+  }
+
+  float Stamina =
+      ASC->GetNumericAttribute(UStaminaAttributeSet::GetStaminaAttribute());
+  float MaxStamina =
+      ASC->GetNumericAttribute(UStaminaAttributeSet::GetMaxStaminaAttribute());
+  float StaminaUsed =
+      ASC->GetNumericAttribute(UStaminaAttributeSet::GetStaminaUsedAttribute());
+  float Health =
+      ASC->GetNumericAttribute(UHealthAttributeSet::GetHealthAttribute());
+  float MaxHealth =
+      ASC->GetNumericAttribute(UHealthAttributeSet::GetMaxHealthAttribute());
+
+  FString Label;
+  FColor Color;
+  GetDebugDisplay(Label, Color);
+
+  FString DebugText = FString::Printf(
+      TEXT("%s - Stamina: %.1f/%.1f, Stamina Used: %.1f, Health: %.1f/%.1f"),
+      *Label, Stamina, MaxStamina, StaminaUsed, Health, MaxHealth);
+
+  DrawDebugString(GetWorld(), GetActorLocation() + FVector(0, 0, 150),
+                  DebugText, nullptr, Color, 0.0f, true, 1.0f);
+#endif
+}
+
+void ACombatBase::HandleDamageTaken(AActor *DamageInstigator,
+                                    AActor *DamageCauser,
+                                    const FGameplayEffectSpec &DamageSpec,
+                                    float DamageMagnitude) {
+  const FVector ImpactPoint = UCombatDamageGameplayEffect::GetDamageLocation(
+      DamageSpec, GetActorLocation());
+  const FVector Impulse = UCombatDamageGameplayEffect::GetDamageImpulse(
+      DamageSpec, GetActorLocation());
+
+  ApplyDamageReaction(DamageMagnitude, ImpactPoint, Impulse);
+  MulticastDamageReaction(DamageMagnitude, ImpactPoint, Impulse,
+                          DamageInstigator);
+}
+
+void ACombatBase::HandleOutOfHealth(AActor *DamageInstigator,
+                                    AActor *DamageCauser,
+                                    const FGameplayEffectSpec &DamageSpec,
+                                    float DamageMagnitude) {
+  HandleDeath();
+}
+
+void ACombatBase::ApplyDamageReaction(float Damage, const FVector &ImpactPoint,
+                                      const FVector &DamageImpulse) {
+  // apply knockback impulse, character movement replicates the result
+  GetCharacterMovement()->AddImpulse(DamageImpulse, true);
+}
+
+void ACombatBase::MulticastDamageReaction_Implementation(
+    float Damage, FVector_NetQuantize ImpactPoint,
+    FVector_NetQuantize10 DamageImpulse, AActor *DamageInstigator) {
+  // dedicated servers have nobody to show the reaction to
+  if (!CombatCosmetics::ShouldRun(GetWorld())) {
+    return;
+  }
+
+  PlayDamageReaction(Damage, ImpactPoint, DamageImpulse, DamageInstigator);
+}
+
+void ACombatBase::PlayDamageReaction(float Damage, const FVector &ImpactPoint,
+                                     const FVector &DamageImpulse,
+                                     AActor *DamageInstigator) {
+  // Blend the mesh into physics but keep the pelvis vertical. The blend is
+  // skipped when the ragdoll budget is full
+  UCombatRagdollSubsystem *Ragdolls =
+      GetWorld()->GetSubsystem<UCombatRagdollSubsystem>();
+  if (Ragdolls && Ragdolls->TryStartKnockback(GetMesh())) {
+    GetMesh()->SetPhysicsBlendWeight(0.5f);
+    GetMesh()->SetBodySimulatePhysics(PelvisBoneName, false);
+  }
+
+  // is the character ragdolling?
+  if (GetMesh()->IsSimulatingPhysics()) {
+    // apply an impulse to the ragdoll
+    GetMesh()->AddImpulseAtLocation(DamageImpulse * GetMesh()->GetMass(),
+                                    ImpactPoint);
+  }
+
+  const bool bDead = HealthComponent && HealthComponent->IsDead();
+  if (!bDead) {
+    ReceivedDamage(Damage, ImpactPoint, DamageImpulse);
+  }
+
+  // the receive damage ability plays camera shakes where this machine owns
+  // the ability spec. The event is handled before SendGameplayEvent returns,
+  // so one payload per actor is enough
+  if (!DamageEventData) {
+    DamageEventData = NewObject<UCombatDamageEventData>(this);
+  }
+  DamageEventData->Location = ImpactPoint;
+  DamageEventData->Impulse = DamageImpulse;
+
+  SendGameplayEvent(
+      FGameplayTag::RequestGameplayTag(FName("Event.Damage.Received")), Damage,
+      DamageEventData, DamageInstigator);
 }
 
 void ACombatBase::SendGameplayEvent(FGameplayTag EventTag, float EventMagnitude,
@@ -229,7 +554,9 @@ void ACombatBase::ResetHP() {
   }
 
   // update the life bar
-  LifeBarWidget->SetLifePercentage(1.0f);
+  if (LifeBarWidget) {
+    LifeBarWidget->SetLifePercentage(1.0f);
+  }
 }
 
 void ACombatBase::ResetStamina() {
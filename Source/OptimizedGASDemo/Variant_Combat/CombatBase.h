@@ -10,8 +10,13 @@
 #include "Animation/AnimInstance.h"
 #include "Health/CombatHealthComponent.h"
 #include "Stamina/CombatStaminaComponent.h"
+#include "Hitbox/CombatHitboxComponent.h"
+#include "CombatProjectileSubsystem.h"
+#include "CombatSpatialIndexSubsystem.h"
 #include "Data/CombatPawnData.h"
 #include "Data/CombatDamageEventData.h"
+#include "Engine/StreamableManager.h"
+#include "GenericTeamAgentInterface.h"
 #include "CombatBase.generated.h"
 
 class UWidgetComponent;
@@ -25,7 +30,8 @@ UCLASS(abstract)
 class ACombatBase : public ACharacter,
                     public IAbilitySystemInterface,
                     public ICombatAttacker,
-                    public ICombatDamageable {
+                    public ICombatDamageable,
+                    public IGenericTeamAgentInterface {
   GENERATED_BODY()
 
 protected:
@@ -44,9 +50,20 @@ protected:
             meta = (AllowPrivateAccess = "true"))
   UCombatStaminaComponent *StaminaComponent;
 
-  /** Pawn data for attributes and abilities */
+  /** Simplified melee hitboxes copied from the mesh's physics asset */
+  UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components",
+            meta = (AllowPrivateAccess = "true"))
+  UCombatHitboxComponent *HitboxComponent;
+
+  /** Shared pawn data asset for attributes and abilities, read only at
+   * runtime. Falls back to UCombatDefaultPawnData when not set */
   UPROPERTY(EditDefaultsOnly, Category = "GAS")
-  TObjectPtr<UCombatPawnData> PawnData;
+  TSoftObjectPtr<UCombatPawnData> PawnData;
+
+  /** Per-instance overrides applied on top of the shared pawn data */
+  UPROPERTY(EditAnywhere, Category = "GAS")
+  FCombatPawnDataOverrides PawnDataOverrides;
+
   /** Name of the pelvis bone, for damage ragdoll physics */
   UPROPERTY(EditAnywhere, Category = "Damage")
   FName PelvisBoneName;
@@ -84,14 +101,15 @@ protected:
             meta = (ClampMin = 0, ClampMax = 1000, Units = "cm/s"))
   float MeleeLaunchImpulse = 300.0f;
 
+  /** Team the character fights for. Attacks skip friendly hitboxes */
+  UPROPERTY(EditAnywhere, Category = "Team")
+  FGenericTeamId TeamId;
+
   /** Time to wait before removing this character from the level after it dies
    */
   UPROPERTY(EditAnywhere, Category = "Death")
   float DeathRemovalTime = 5.0f;
 
-  /** Character death timer */
-  FTimerHandle DeathTimer;
-
   /** Last recorded location we're being attacked from */
   FVector LastDangerLocation = FVector::ZeroVector;
 
@@ -122,7 +140,7 @@ protected:
 
   /** AnimMontage that will play for combo attacks */
   UPROPERTY(EditAnywhere, Category = "Melee Attack|Combo")
-  UAnimMontage *ComboAttackMontage;
+  TSoftObjectPtr<UAnimMontage> ComboAttackMontage;
 
   /** Names of the AnimMontage sections that correspond to each stage of the
    * combo attack */
@@ -131,7 +149,7 @@ protected:
 
   /** AnimMontage that will play for charged attacks */
   UPROPERTY(EditAnywhere, Category = "Melee Attack|Charged")
-  UAnimMontage *ChargedAttackMontage;
+  TSoftObjectPtr<UAnimMontage> ChargedAttackMontage;
 
   /** Name of the AnimMontage section that corresponds to the charge loop */
   UPROPERTY(EditAnywhere, Category = "Melee Attack|Charged")
@@ -144,6 +162,15 @@ protected:
   /** Attack montage ended delegate */
   FOnMontageEnded OnAttackMontageEnded;
 
+  /** Keeps pawn data and montages resident while this character exists */
+  TSharedPtr<FStreamableHandle> CombatAssetsHandle;
+
+  /** Slot in the spatial index queried by area attacks */
+  FCombatSpatialHandle SpatialHandle;
+
+  /** Query params ignoring this character, shared by its abilities */
+  FCollisionQueryParams CombatQueryParams;
+
 public:
   /** Constructor */
   ACombatBase();
@@ -153,7 +180,9 @@ public:
   // ~end IAbilitySystemInterface
 
   /** Get combo attack montage */
-  UAnimMontage *GetComboAttackMontage() const { return ComboAttackMontage; }
+  UAnimMontage *GetComboAttackMontage() const {
+    return ComboAttackMontage.Get();
+  }
 
   /** Get combo section names */
   const TArray<FName> &GetComboSectionNames() const {
@@ -161,7 +190,9 @@ public:
   }
 
   /** Get charged attack montage */
-  UAnimMontage *GetChargedAttackMontage() const { return ChargedAttackMontage; }
+  UAnimMontage *GetChargedAttackMontage() const {
+    return ChargedAttackMontage.Get();
+  }
 
   /** Get charge loop section name */
   FName GetChargeLoopSection() const { return ChargeLoopSection; }
@@ -190,9 +221,66 @@ public:
   /** Get current HP */
   float GetCurrentHP() const { return CurrentHP; }
 
+  /** Get the shared pawn data, never null. Falls back to the defaults while
+   * the pawn data is still streaming */
+  const UCombatPawnData *GetPawnData() const;
+
+  /** True once the pawn data and montages are resident */
+  bool HasCombatAssetsLoaded() const;
+
+  /** Query params that ignore this character, built once per character so
+   * per-execution abilities don't rebuild them on every activation */
+  const FCollisionQueryParams &GetCombatQueryParams() const {
+    return CombatQueryParams;
+  }
+
+  /** Get the soft reference to the pawn data asset, valid on the CDO */
+  const TSoftObjectPtr<UCombatPawnData> &GetPawnDataAsset() const {
+    return PawnData;
+  }
+
+  /** Collect the montages this character plays. Called on the CDO by
+   * spawners to preload them with the pawn data bundles */
+  virtual void GetMontagesToLoad(TArray<FSoftObjectPath> &OutPaths) const;
+
+  /** Get the per-instance pawn data overrides */
+  const FCombatPawnDataOverrides &GetPawnDataOverrides() const {
+    return PawnDataOverrides;
+  }
+
   /** Get health component */
   UCombatHealthComponent *GetHealthComponent() const { return HealthComponent; }
 
+  /** Get the life bar component, null on dedicated servers */
+  UWidgetComponent *GetLifeBar() const { return LifeBar; }
+
+  /** Whether UpdateCamera has work to do this frame */
+  virtual bool NeedsCameraUpdate() const { return false; }
+
+  /** Per-frame camera work, run by UCombatTickSubsystem */
+  virtual void UpdateCamera(float DeltaTime) {}
+
+  /** Draw the attribute debug text above the character */
+  void DrawDebugAttributes() const;
+
+  /** Replays projectiles fired on the server so clients can draw them.
+   * Unreliable since a dropped launch only loses a visual */
+  UFUNCTION(NetMulticast, Unreliable)
+  void MulticastFireProjectiles(
+      FVector_NetQuantize Muzzle,
+      const TArray<FVector_NetQuantizeNormal> &Directions,
+      const FCombatProjectileParams &Params);
+
+  // ~begin IGenericTeamAgentInterface
+
+  /** Moves the character and its hitboxes to another team */
+  virtual void SetGenericTeamId(const FGenericTeamId &NewTeamID) override;
+
+  /** Returns the character's team */
+  virtual FGenericTeamId GetGenericTeamId() const override { return TeamId; }
+
+  // ~end IGenericTeamAgentInterface
+
 protected:
   // ~begin CombatAttacker interface
 
@@ -227,17 +315,61 @@ protected:
   // ~end CombatDamageable interface
 
 protected:
+  /** Resolves pawn data and montages before the character is possessed */
+  virtual void PostInitializeComponents() override;
+
   /** Initialization */
   virtual void BeginPlay() override;
 
+  /** Called when pawn data that was still streaming at BeginPlay arrives */
+  virtual void OnCombatAssetsLoaded() {}
+
   /** Cleanup */
   virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+  /** Only enabled when Combat.BatchedTick is off or a Blueprint implements
+   * Event Tick, the combat work is otherwise run by UCombatTickSubsystem */
+  virtual void Tick(float DeltaTime) override;
+
+  /** Label and color of the attribute debug text */
+  virtual void GetDebugDisplay(FString &OutLabel, FColor &OutColor) const;
+
+  /** Called on the server when the health set applies incoming damage */
+  void HandleDamageTaken(AActor *DamageInstigator, AActor *DamageCauser,
+                         const FGameplayEffectSpec &DamageSpec,
+                         float DamageMagnitude);
+
+  /** Called on the server when the health set runs out of health */
+  void HandleOutOfHealth(AActor *DamageInstigator, AActor *DamageCauser,
+                         const FGameplayEffectSpec &DamageSpec,
+                         float DamageMagnitude);
+
+  /** Applies the authoritative knockback for damage taken on the server */
+  virtual void ApplyDamageReaction(float Damage, const FVector &ImpactPoint,
+                                   const FVector &DamageImpulse);
+
+  /** Sends the hit reaction to every machine. Unreliable since a dropped
+   * reaction only loses a cosmetic */
+  UFUNCTION(NetMulticast, Unreliable)
+  void MulticastDamageReaction(float Damage, FVector_NetQuantize ImpactPoint,
+                               FVector_NetQuantize10 DamageImpulse,
+                               AActor *DamageInstigator);
+
+  /** Plays the cosmetic hit reaction where it can be seen */
+  virtual void PlayDamageReaction(float Damage, const FVector &ImpactPoint,
+                                  const FVector &DamageImpulse,
+                                  AActor *DamageInstigator);
+
   /** Helper method to send gameplay events */
   void SendGameplayEvent(FGameplayTag EventTag, float EventMagnitude = 0.0f,
                          UObject *OptionalObject = nullptr,
                          AActor *EventInstigator = nullptr);
 
+  /** Hit reaction payload, reused by every damage event on this actor since
+   * the receive damage ability reads it synchronously */
+  UPROPERTY(Transient)
+  TObjectPtr<UCombatDamageEventData> DamageEventData;
+
 private:
   /** Default effect level for granted effects */
   static constexpr float DefaultEffectLevel = 1.0f;
@@ -4,6 +4,8 @@
 #include "AbilitySystemComponent.h"
 #include "Camera/CameraComponent.h"
 #include "CombatLifeBar.h"
+#include "CombatCosmetics.h"
+#include "OptimizedGASDemo.h"
 #include "CombatPlayerController.h"
 #include "CombatPlayerState.h"
 #include "Attributes/HealthAttributeSet.h"
@@ -18,7 +20,6 @@
 #include "EnhancedInputSubsystems.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
-#include "TimerManager.h"
 #include "Abilities/CombatReceiveDamageAbility.h"
 #include "Abilities/CombatDeathAbility.h"
 #include "Abilities/CombatTraceAttackAbility.h"
@@ -28,12 +29,22 @@
 #include "Abilities/CombatLockToggleAbility.h"
 #include "Effects/CombatDamageGameplayEffect.h"
 #include "Data/CombatAttackEventData.h"
+#include "CombatTeams.h"
+#include "CombatRagdollSubsystem.h"
+#include "CombatSpatialIndexSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Player Respawn"), STAT_CombatPlayerRespawn,
+                   STATGROUP_Combat);
+
 ACombatCharacter::ACombatCharacter() {
   PrimaryActorTick.bCanEverTick = true;
 
   // bind the attack montage ended delegate
   OnAttackMontageEnded.BindUObject(this, &ACombatCharacter::AttackMontageEnded);
 
+  // players fight on their own team
+  TeamId = CombatTeams::Players;
+
   // Configure character movement
   OriginalMaxWalkSpeed = 600.0f;
   GetCharacterMovement()->MaxWalkSpeed =
@@ -183,33 +194,21 @@ void ACombatCharacter::AttackMontageEnded(UAnimMontage *Montage,
   Super::AttackMontageEnded(Montage, bInterrupted);
 }
 
-void ACombatCharacter::Tick(float DeltaTime) {
-  Super::Tick(DeltaTime);
+bool ACombatCharacter::NeedsCameraUpdate() const {
+  // locked, or still easing back to the exploration distance
+  return HasLockedTarget() || bCameraLocked ||
+         (CameraBoom && !FMath::IsNearlyEqual(CameraBoom->TargetArmLength,
+                                              ExplorationCameraDistance, 0.1f));
+}
+
+void ACombatCharacter::UpdateCamera(float DeltaTime) {
   UpdateCameraLock(DeltaTime);
+}
 
-#if !UE_BUILD_SHIPPING
-  // Debug display for stamina used and damage taken
-  if (UAbilitySystemComponent *ASC = GetAbilitySystemComponent()) {
-    float Stamina =
-        ASC->GetNumericAttribute(UStaminaAttributeSet::GetStaminaAttribute());
-    float MaxStamina = ASC->GetNumericAttribute(
-        UStaminaAttributeSet::GetMaxStaminaAttribute());
-    float StaminaUsed = ASC->GetNumericAttribute(
-        UStaminaAttributeSet::GetStaminaUsedAttribute());
-    float Health =
-        ASC->GetNumericAttribute(UHealthAttributeSet::GetHealthAttribute());
-    float MaxHealth =
-        ASC->GetNumericAttribute(UHealthAttributeSet::GetMaxHealthAttribute());
-
-    FString DebugText =
-        FString::Printf(TEXT("Player - Stamina: %.1f/%.1f, Stamina Used: %.1f, "
-                             "Health: %.1f/%.1f"),
-                        Stamina, MaxStamina, StaminaUsed, Health, MaxHealth);
-
-    DrawDebugString(GetWorld(), GetActorLocation() + FVector(0, 0, 150),
-                    DebugText, nullptr, FColor::Yellow, 0.0f, true, 1.0f);
-  }
-#endif
+void ACombatCharacter::GetDebugDisplay(FString &OutLabel,
+                                       FColor &OutColor) const {
+  OutLabel = TEXT("Player");
+  OutColor = FColor::Yellow;
 }
 
 void ACombatCharacter::DoMove(float Right, float Forward) {
@@ -240,6 +239,16 @@ void ACombatCharacter::DoLook(float Yaw, float Pitch) {
   }
 }
 
+void ACombatCharacter::DoAbilityTrigger(FGameplayTag TriggerTag) {
+  // route the input
+  SendAbilityTrigger(TriggerTag);
+}
+
+void ACombatCharacter::DoLockToggle() {
+  // route the input
+  LockPressed();
+}
+
 void ACombatCharacter::Landed(const FHitResult &Hit) {
   Super::Landed(Hit);
 
@@ -262,17 +271,18 @@ void ACombatCharacter::BeginPlay() {
   MeshStartingTransform = GetMesh()->GetRelativeTransform();
 
   // set the life bar color
-  LifeBarWidget->SetBarColor(LifeBarColor);
+  if (LifeBarWidget) {
+    LifeBarWidget->SetBarColor(LifeBarColor);
+  }
 
   // reset HP to maximum
   ResetHP();
-}
-
-void ACombatCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason) {
-  Super::EndPlay(EndPlayReason);
 
-  // clear the respawn timer
-  GetWorld()->GetTimerManager().ClearTimer(RespawnTimer);
+  // in-place respawns bring the mesh back from the ragdoll on revive
+  if (HealthComponent) {
+    HealthComponent->OnHealthChanged.AddUObject(
+        this, &ACombatCharacter::HandleHealthChangedForRevive);
+  }
 }
 
 void ACombatCharacter::SetupPlayerInputComponent(
@@ -283,7 +293,7 @@ void ACombatCharacter::SetupPlayerInputComponent(
   if (UEnhancedInputComponent *EnhancedInputComponent =
           Cast<UEnhancedInputComponent>(PlayerInputComponent)) {
     // Bind inputs from InputConfig if available
-    if (PawnData && PawnData->InputConfig) {
+    if (GetPawnData()->InputConfig) {
       BindInputsFromConfig(EnhancedInputComponent);
     } else {
       // Fallback to basic movement inputs only
@@ -292,6 +302,24 @@ void ACombatCharacter::SetupPlayerInputComponent(
   }
 }
 
+void ACombatCharacter::OnCombatAssetsLoaded() {
+  Super::OnCombatAssetsLoaded();
+
+  // possession ran on the default pawn data while ours was streaming
+  if (HasAuthority()) {
+    if (ACombatPlayerState *PS = Cast<ACombatPlayerState>(GetPlayerState())) {
+      PS->SetPawnData(GetPawnData(), PawnDataOverrides);
+    }
+  }
+
+  // rebind from the loaded input config
+  if (UEnhancedInputComponent *EnhancedInputComponent =
+          Cast<UEnhancedInputComponent>(InputComponent)) {
+    EnhancedInputComponent->ClearBindingsForObject(this);
+    SetupPlayerInputComponent(EnhancedInputComponent);
+  }
+}
+
 void ACombatCharacter::BindInputsFromConfig(
     UEnhancedInputComponent *EnhancedInputComponent) {
   UAbilitySystemComponent *ASC = GetAbilitySystemComponent();
@@ -303,7 +331,7 @@ void ACombatCharacter::BindInputsFromConfig(
 
   // Bind each input mapping
   for (const FCombatInputMapping &Mapping :
-       PawnData->InputConfig->InputMappings) {
+       GetPawnData()->InputConfig->InputMappings) {
     if (!Mapping.InputAction)
       continue;
 
@@ -313,6 +341,11 @@ void ACombatCharacter::BindInputsFromConfig(
         EnhancedInputComponent->BindAction(
             Mapping.InputAction, Trigger.TriggerEvent, this,
             &ACombatCharacter::SendAbilityTrigger, Trigger.TriggerTag);
+
+        // releasing the input reaches the abilities it started
+        EnhancedInputComponent->BindAction(
+            Mapping.InputAction, ETriggerEvent::Completed, this,
+            &ACombatCharacter::ReleaseAbilityTrigger, Trigger.TriggerTag);
       } else if (Trigger.TriggerEvent == ETriggerEvent::Completed) {
         EnhancedInputComponent->BindAction(
             Mapping.InputAction, Trigger.TriggerEvent, this,
@@ -347,8 +380,18 @@ void ACombatCharacter::BindBasicMovementInputs(
 }
 
 void ACombatCharacter::SendAbilityTrigger(FGameplayTag TriggerTag) {
-  // Send gameplay event with the trigger tag
-  SendGameplayEvent(TriggerTag);
+  // queue for the batched input pass of the player controller
+  ACombatPlayerState *PS = GetPlayerState<ACombatPlayerState>();
+  if (PS && IsLocallyControlled()) {
+    PS->GetInputRouter().InputTagTriggered(TriggerTag);
+  }
+}
+
+void ACombatCharacter::ReleaseAbilityTrigger(FGameplayTag TriggerTag) {
+  ACombatPlayerState *PS = GetPlayerState<ACombatPlayerState>();
+  if (PS && IsLocallyControlled()) {
+    PS->GetInputRouter().InputTagReleased(TriggerTag);
+  }
 }
 
 void ACombatCharacter::NotifyControllerChanged() {
@@ -356,7 +399,7 @@ void ACombatCharacter::NotifyControllerChanged() {
 
   // Set pawn data on player state for GAS management per Lyra standard
   if (ACombatPlayerState *PS = Cast<ACombatPlayerState>(GetPlayerState())) {
-    PS->SetPawnData(PawnData);
+    PS->SetPawnData(GetPawnData(), PawnDataOverrides);
   }
 
   // update the respawn transform on the Player Controller
@@ -367,10 +410,73 @@ void ACombatCharacter::NotifyControllerChanged() {
 }
 
 void ACombatCharacter::RespawnCharacter() {
-  // Destroy the current character
-  Destroy();
+  SCOPE_CYCLE_COUNTER(STAT_CombatPlayerRespawn);
+
+  ACombatPlayerController *PC = Cast<ACombatPlayerController>(GetController());
+  if (!PC) {
+    // Destroy the current character, the PlayerController will handle
+    // spawning a new one
+    Destroy();
+    return;
+  }
+
+  ResetForRespawn(PC->GetRespawnTransform());
+}
+
+void ACombatCharacter::ResetForRespawn(const FTransform &SpawnTransform) {
+  // undo what the death ability turned off
+  const ACombatCharacter *Defaults =
+      GetClass()->GetDefaultObject<ACombatCharacter>();
+  GetCapsuleComponent()->SetCollisionEnabled(
+      Defaults->GetCapsuleComponent()->GetCollisionEnabled());
+  HitboxComponent->SetHitboxesEnabled(true);
+  GetCharacterMovement()->StopMovementImmediately();
+  GetCharacterMovement()->SetDefaultMovementMode();
+
+  TeleportTo(SpawnTransform.GetLocation(), SpawnTransform.Rotator(), false,
+             true);
+  if (AController *PC = GetController()) {
+    PC->SetControlRotation(SpawnTransform.Rotator());
+  }
+
+  GetCameraBoom()->TargetArmLength = DefaultCameraDistance;
+
+  // the dead were taken out of the spatial index
+  if (UCombatSpatialIndexSubsystem *SpatialIndex =
+          GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>()) {
+    if (!SpatialHandle.IsValid()) {
+      SpatialHandle = SpatialIndex->RegisterTarget(this, TeamId);
+    }
+  }
+
+  // refilling health revives the character and restores the mesh
+  if (ACombatPlayerState *PS = Cast<ACombatPlayerState>(GetPlayerState())) {
+    PS->ResetAttributesToDefault();
+  }
+}
+
+void ACombatCharacter::HandleHealthChangedForRevive(float NewHealth) {
+  if (NewHealth <= 0.0f) {
+    bAwaitingRevive = true;
+    return;
+  }
+
+  if (!bAwaitingRevive) {
+    return;
+  }
+
+  bAwaitingRevive = false;
+
+  // the health component already stopped the ragdoll, put the mesh back on
+  // the capsule where BeginPlay found it
+  if (UCombatRagdollSubsystem *Ragdolls =
+          GetWorld()->GetSubsystem<UCombatRagdollSubsystem>()) {
+    Ragdolls->StopRagdoll(GetMesh());
+  }
 
-  // The PlayerController will handle spawning a new one
+  GetMesh()->AttachToComponent(GetCapsuleComponent(),
+                               FAttachmentTransformRules::KeepWorldTransform);
+  GetMesh()->SetRelativeTransform(MeshStartingTransform);
 }
 
 bool ACombatCharacter::HasLockedTarget() const {
@@ -382,7 +488,7 @@ void ACombatCharacter::PossessedBy(AController *NewController) {
 
   // Set pawn data on player state for GAS management (needed for respawn)
   if (ACombatPlayerState *PS = Cast<ACombatPlayerState>(GetPlayerState())) {
-    PS->SetPawnData(PawnData);
+    PS->SetPawnData(GetPawnData(), PawnDataOverrides);
 
     // Re-initialize ability actor info with the new pawn (important for
     // respawn)
@@ -106,13 +106,13 @@ protected:
             meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
   float RespawnTime = 3.0f;
 
-  /** Character respawn timer */
-  FTimerHandle RespawnTimer;
-
   /** Copy of the mesh's transform so we can reset it after ragdoll animations
    */
   FTransform MeshStartingTransform;
 
+  /** Set while dead so the mesh is restored when health comes back */
+  bool bAwaitingRevive = false;
+
   /** Max amount of time that may elapse for a non-combo attack input to not be
    * considered stale */
   UPROPERTY(EditAnywhere, Category = "Melee Attack",
@@ -178,7 +178,9 @@ public:
   float GetDangerTraceRadius() const { return DangerTraceRadius; }
 
   /** Get charged attack montage */
-  UAnimMontage *GetChargedAttackMontage() const { return ChargedAttackMontage; }
+  UAnimMontage *GetChargedAttackMontage() const {
+    return ChargedAttackMontage.Get();
+  }
 
   /** Get charge loop section name */
   FName GetChargeLoopSection() const { return ChargeLoopSection; }
@@ -200,10 +202,14 @@ protected:
   /** Bind a minimal set of movement/look inputs (fallback) */
   void BindBasicMovementInputs(UEnhancedInputComponent *EnhancedInputComponent);
 
-  /** Send a gameplay event trigger tag to the ASC (bound from input mappings)
-   */
+  /** Queue a trigger tag on the player state's input router (bound from
+   * input mappings) */
   void SendAbilityTrigger(FGameplayTag TriggerTag);
 
+  /** Tell the abilities fired by the trigger tag that their input was
+   * released */
+  void ReleaseAbilityTrigger(FGameplayTag TriggerTag);
+
   /** Called for toggle camera side input */
   void ToggleCamera();
 
@@ -230,6 +236,14 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Input")
   virtual void DoLook(float Yaw, float Pitch);
 
+  /** Handles ability trigger inputs from either controls or bots */
+  UFUNCTION(BlueprintCallable, Category = "Input")
+  void DoAbilityTrigger(FGameplayTag TriggerTag);
+
+  /** Handles lock target inputs from either controls or bots */
+  UFUNCTION(BlueprintCallable, Category = "Input")
+  void DoLockToggle();
+
 protected:
   // ~begin CombatAttacker interface
 
@@ -239,7 +253,8 @@ protected:
   // ~end CombatAttacker interface
 
 public:
-  /** Called from the respawn timer to destroy and re-create the character */
+  /** Called from the respawn timer. Resets the character in place at the
+   * respawn transform, or destroys it when it has no player controller */
   void RespawnCharacter();
 
   /** Overrides landing to reset damage ragdoll physics */
@@ -249,8 +264,9 @@ protected:
   /** Initialization */
   virtual void BeginPlay() override;
 
-  /** Cleanup */
-  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+  /** Label the attribute debug text as the player */
+  virtual void GetDebugDisplay(FString &OutLabel,
+                               FColor &OutColor) const override;
 
   /** Handles input bindings */
   virtual void SetupPlayerInputComponent(
@@ -259,6 +275,9 @@ protected:
   /** Handles possessed initialization */
   virtual void NotifyControllerChanged() override;
 
+  /** Swaps the fallback pawn data and input bindings for the streamed ones */
+  virtual void OnCombatAssetsLoaded() override;
+
 public:
   /** Returns CameraBoom subobject **/
   FORCEINLINE class USpringArmComponent *GetCameraBoom() const {
@@ -280,8 +299,11 @@ public:
     return AttackCameraShake;
   }
 
-  /** Tick function */
-  virtual void Tick(float DeltaTime) override;
+  /** Camera work is only needed while locked or easing back */
+  virtual bool NeedsCameraUpdate() const override;
+
+  /** Updates the lock-on camera */
+  virtual void UpdateCamera(float DeltaTime) override;
 
   /** Check if has a locked target */
   bool HasLockedTarget() const;
@@ -295,4 +317,12 @@ public:
 private:
   /** Handle movement speed attribute changes */
   void HandleMovementSpeedChanged(const FOnAttributeChangeData &ChangeData);
+
+  /** Teleport to the transform and undo everything death changed on the
+   * server, keeping the ability system state of the player state */
+  void ResetForRespawn(const FTransform &SpawnTransform);
+
+  /** Restore the mesh from the death ragdoll once health comes back. Runs on
+   * every machine since health replicates */
+  void HandleHealthChangedForRevive(float NewHealth);
 };
@@ -0,0 +1,19 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+// Object channels of the simplified melee hitboxes, one per team so attacks
+// can leave out friendly hitboxes in the query itself. Must match the
+// channels in DefaultEngine.ini
+
+/** Hitboxes of teamless actors, such as props */
+#define ECC_CombatHitbox ECC_GameTraceChannel2
+
+/** Hitboxes of the player team */
+#define ECC_CombatHitboxPlayers ECC_GameTraceChannel3
+
+/** Hitboxes of the enemy team */
+#define ECC_CombatHitboxEnemies ECC_GameTraceChannel4
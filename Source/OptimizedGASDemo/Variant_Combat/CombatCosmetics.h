@@ -0,0 +1,33 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+
+/** Cosmetic code (life bars, debug draws, camera shakes, decals) is compiled
+ * out of Server target builds */
+#define WITH_COMBAT_COSMETICS !UE_SERVER
+
+namespace CombatCosmetics {
+
+/** Returns true if cosmetic work should run in the given world. Always false
+ * on Server targets and on editor/game binaries running with -server */
+inline bool ShouldRun(const UWorld *World) {
+#if WITH_COMBAT_COSMETICS
+  return World && World->GetNetMode() != NM_DedicatedServer;
+#else
+  return false;
+#endif
+}
+
+/** Returns true if debug shapes should be drawn in the given world */
+inline bool ShouldDrawDebug(const UWorld *World) {
+#if ENABLE_DRAW_DEBUG
+  return ShouldRun(World);
+#else
+  return false;
+#endif
+}
+
+} // namespace CombatCosmetics
@@ -14,6 +14,7 @@
 #include "Attributes/HealthAttributeSet.h"
 #include "Attributes/StaminaAttributeSet.h"
 #include "CombatPlayerState.h"
+#include "Bot/CombatBotInputComponent.h"
 
 void ACombatPlayerController::BeginPlay() {
   Super::BeginPlay();
@@ -35,6 +36,13 @@ void ACombatPlayerController::BeginPlay() {
              TEXT("Could not spawn mobile controls widget."));
     }
   }
+
+  // headless load test clients drive their own input
+  if (IsLocalPlayerController() && UCombatBotInputComponent::IsBotClient()) {
+    BotInputComponent = NewObject<UCombatBotInputComponent>(
+        this, TEXT("BotInputComponent"));
+    BotInputComponent->RegisterComponent();
+  }
 }
 
 void ACombatPlayerController::SetupInputComponent() {
@@ -69,6 +77,16 @@ void ACombatPlayerController::OnPossess(APawn *InPawn) {
                                  &ACombatPlayerController::OnPawnDestroyed);
 }
 
+void ACombatPlayerController::PostProcessInput(const float DeltaTime,
+                                               const bool bGamePaused) {
+  // abilities see this frame's input after every binding has fired
+  if (ACombatPlayerState *PS = GetPlayerState<ACombatPlayerState>()) {
+    PS->ProcessAbilityInput();
+  }
+
+  Super::PostProcessInput(DeltaTime, bGamePaused);
+}
+
 void ACombatPlayerController::SetRespawnTransform(
     const FTransform &NewRespawn) {
   // save the new respawn transform
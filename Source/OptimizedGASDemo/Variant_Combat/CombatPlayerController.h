@@ -8,6 +8,7 @@
 
 class UInputMappingContext;
 class ACombatCharacter;
+class UCombatBotInputComponent;
 
 /**
  *  Simple Player Controller for a third person combat game
@@ -41,6 +42,10 @@ protected:
   /** Transform to respawn the character at. Can be set to create checkpoints */
   FTransform RespawnTransform;
 
+  /** Bot input driver, only created on -CombatBot load test clients */
+  UPROPERTY(Transient)
+  TObjectPtr<UCombatBotInputComponent> BotInputComponent;
+
 protected:
   /** Gameplay initialization */
   virtual void BeginPlay() override;
@@ -51,10 +56,17 @@ protected:
   /** Pawn initialization */
   virtual void OnPossess(APawn *InPawn) override;
 
+  /** Routes the ability input gathered this frame in one batch */
+  virtual void PostProcessInput(const float DeltaTime,
+                                const bool bGamePaused) override;
+
 public:
   /** Updates the character respawn transform */
   void SetRespawnTransform(const FTransform &NewRespawn);
 
+  /** Returns the transform the character respawns at */
+  const FTransform &GetRespawnTransform() const { return RespawnTransform; }
+
 protected:
   /** Called if the possessed pawn is destroyed */
   UFUNCTION()
@@ -6,6 +6,14 @@
 #include "Attributes/StaminaAttributeSet.h"
 #include "Attributes/DamageAttributeSet.h"
 #include "Attributes/MovementAttributeSet.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pawn Data Change"), STAT_CombatPawnDataChange,
+                   STATGROUP_Combat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ability Sets Granted"),
+                           STAT_CombatAbilitySetsGranted, STATGROUP_Combat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ability Sets Taken"),
+                           STAT_CombatAbilitySetsTaken, STATGROUP_Combat);
 
 ACombatPlayerState::ACombatPlayerState() {
   AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>(
@@ -25,13 +33,24 @@ void ACombatPlayerState::BeginPlay() {
   }
 }
 
-void ACombatPlayerState::SetPawnData(const UCombatPawnData *InPawnData) {
+void ACombatPlayerState::SetPawnData(
+    const UCombatPawnData *InPawnData,
+    const FCombatPawnDataOverrides &InOverrides) {
   if (!AbilitySystemComponent) {
     return;
   }
 
-  // Clear any previously granted abilities/effects
-  ClearPawnData();
+  // same pawn data, e.g. a respawn or a repeated possession: keep the granted
+  // abilities and attribute sets, only re-apply the attribute values
+  if (InPawnData && InPawnData == PawnData) {
+    InitializePawnAttributes(InPawnData, InOverrides);
+    return;
+  }
+
+  if (!InPawnData) {
+    // Clear any previously granted abilities/effects
+    ClearPawnData();
+  }
 
   PawnData = InPawnData;
 
@@ -39,55 +58,80 @@ void ACombatPlayerState::SetPawnData(const UCombatPawnData *InPawnData) {
     return;
   }
 
-  // Grant ability sets with input mapping
+  SCOPE_CYCLE_COUNTER(STAT_CombatPawnDataChange);
+
+  // resolves immediately when the Gameplay bundle is already loaded
+  TArray<const UCombatAbilitySet *, TInlineAllocator<8>> NewSets;
+  TSet<TObjectKey<UCombatAbilitySet>> NewSetKeys;
   for (const FCombatAbilitySetWithInput &AbilitySetWithInput :
        InPawnData->AbilitySets) {
-    if (AbilitySetWithInput.AbilitySet) {
-      FCombatAbilitySetHandle AbilitySetHandle;
-      AbilitySetWithInput.AbilitySet->GiveToAbilitySystem(
-          AbilitySystemComponent, AbilitySetHandle, this);
-      if (AbilitySetHandle.IsValid()) {
-        GrantedAbilitySetHandles.Add(AbilitySetHandle);
-      }
+    const UCombatAbilitySet *AbilitySet =
+        AbilitySetWithInput.AbilitySet.LoadSynchronous();
+    bool bAlreadyInSet = false;
+    if (AbilitySet) {
+      NewSetKeys.Add(AbilitySet, &bAlreadyInSet);
+    }
+    if (AbilitySet && !bAlreadyInSet) {
+      NewSets.Add(AbilitySet);
+    }
+  }
+
+  // grant the sets we don't have yet before taking the old ones, so
+  // abilities shared between them stay granted
+  for (const UCombatAbilitySet *AbilitySet : NewSets) {
+    if (GrantedAbilitySets.Contains(AbilitySet)) {
+      continue;
+    }
+
+    FCombatAbilitySetHandle AbilitySetHandle;
+    AbilitySet->GiveToAbilitySystem(AbilitySystemComponent, AbilitySetHandle,
+                                    this, &GrantIndex);
+    INC_DWORD_STAT(STAT_CombatAbilitySetsGranted);
+    if (AbilitySetHandle.IsValid()) {
+      GrantedAbilitySets.Add(AbilitySet, MoveTemp(AbilitySetHandle));
+    }
+  }
+
+  // take the sets the new pawn data doesn't have
+  for (auto It = GrantedAbilitySets.CreateIterator(); It; ++It) {
+    if (!NewSetKeys.Contains(It.Key())) {
+      It.Value().TakeFromAbilitySystem(AbilitySystemComponent, &GrantIndex);
+      It.RemoveCurrent();
+      INC_DWORD_STAT(STAT_CombatAbilitySetsTaken);
     }
   }
 
-  // Add attribute sets from PawnData
+  // input goes straight to the specs granted above
+  InputRouter.Rebuild(AbilitySystemComponent, InPawnData->InputConfig);
+
+  // Add attribute sets from PawnData. Sets outlive pawn data changes, so
+  // only classes the ASC doesn't have yet are created
   for (TSubclassOf<UAttributeSet> AttributeSetClass :
        InPawnData->AttributeSets) {
-    if (AttributeSetClass) {
+    if (AttributeSetClass &&
+        !AbilitySystemComponent->GetAttributeSet(AttributeSetClass)) {
       UAttributeSet *NewAttributeSet =
           NewObject<UAttributeSet>(this, AttributeSetClass);
       AbilitySystemComponent->AddAttributeSetSubobject(NewAttributeSet);
     }
   }
 
+  InitializePawnAttributes(InPawnData, InOverrides);
+}
+
+void ACombatPlayerState::InitializePawnAttributes(
+    const UCombatPawnData *InPawnData,
+    const FCombatPawnDataOverrides &InOverrides) {
   // Set attributes from pawn data
   if (HasAuthority()) {
-    AbilitySystemComponent->SetNumericAttributeBase(
-        UHealthAttributeSet::GetHealthAttribute(), InPawnData->DefaultHealth);
-    AbilitySystemComponent->SetNumericAttributeBase(
-        UHealthAttributeSet::GetMaxHealthAttribute(),
-        InPawnData->DefaultMaxHealth);
-    AbilitySystemComponent->SetNumericAttributeBase(
-        UStaminaAttributeSet::GetStaminaAttribute(),
-        InPawnData->DefaultStamina);
-    AbilitySystemComponent->SetNumericAttributeBase(
-        UStaminaAttributeSet::GetMaxStaminaAttribute(),
-        InPawnData->DefaultMaxStamina);
-    AbilitySystemComponent->SetNumericAttributeBase(
-        UDamageAttributeSet::GetDamageAttribute(), InPawnData->DefaultDamage);
-    AbilitySystemComponent->SetNumericAttributeBase(
-        UDamageAttributeSet::GetKnockbackImpulseAttribute(),
-        InPawnData->DefaultKnockbackImpulse);
-    AbilitySystemComponent->SetNumericAttributeBase(
-        UDamageAttributeSet::GetLaunchImpulseAttribute(),
-        InPawnData->DefaultLaunchImpulse);
+    InPawnData->InitializeAttributes(AbilitySystemComponent, InOverrides);
   }
 
   // Update default values from pawn data
-  DefaultMaxHP = InPawnData->DefaultMaxHealth;
-  DefaultMaxStamina = InPawnData->DefaultMaxStamina;
+  const FCombatPawnAttributeDefaults Defaults =
+      InPawnData->GetAttributeDefaults(InOverrides);
+  DefaultMaxHP = Defaults.MaxHealth;
+  DefaultMaxStamina = Defaults.MaxStamina;
 }
 
 void ACombatPlayerState::ClearPawnData() {
@@ -96,16 +140,21 @@ void ACombatPlayerState::ClearPawnData() {
   }
 
   // Remove all granted ability sets
-  for (FCombatAbilitySetHandle &AbilitySetHandle : GrantedAbilitySetHandles) {
-    if (AbilitySetHandle.IsValid()) {
-      AbilitySetHandle.TakeFromAbilitySystem(AbilitySystemComponent);
-    }
+  for (TPair<TObjectKey<UCombatAbilitySet>, FCombatAbilitySetHandle> &Pair :
+       GrantedAbilitySets) {
+    Pair.Value.TakeFromAbilitySystem(AbilitySystemComponent, &GrantIndex);
+    INC_DWORD_STAT(STAT_CombatAbilitySetsTaken);
   }
 
-  GrantedAbilitySetHandles.Reset();
+  GrantedAbilitySets.Reset();
+  InputRouter.Reset();
   PawnData = nullptr;
 }
 
+void ACombatPlayerState::ProcessAbilityInput() {
+  InputRouter.ProcessAbilityInput(AbilitySystemComponent, GetPawn());
+}
+
 void ACombatPlayerState::ResetAttributesToDefault() {
   if (!AbilitySystemComponent) {
     return;
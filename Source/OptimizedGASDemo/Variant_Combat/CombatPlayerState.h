@@ -7,6 +7,7 @@
 #include "AbilitySystemInterface.h"
 #include "Data/CombatPawnData.h"
 #include "Gameplay/Abilities/CombatAbilitySet.h"
+#include "Gameplay/Abilities/CombatAbilityInputRouter.h"
 #include "CombatPlayerState.generated.h"
 
 class UAbilitySystemComponent;
@@ -26,12 +27,18 @@ public:
   virtual UAbilitySystemComponent *GetAbilitySystemComponent() const override;
   // ~end IAbilitySystemInterface
 
-  /** Set pawn data and grant abilities/effects */
-  void SetPawnData(const UCombatPawnData *InPawnData);
+  /** Set pawn data and grant abilities/effects. Setting the current pawn
+   * data again keeps what was granted and only re-applies the attributes */
+  void SetPawnData(const UCombatPawnData *InPawnData,
+                   const FCombatPawnDataOverrides &InOverrides =
+                       FCombatPawnDataOverrides());
 
   /** Clear all granted abilities/effects from previous pawn data */
   void ClearPawnData();
 
+  /** Number of ability sets currently granted */
+  int32 GetNumGrantedAbilitySets() const { return GrantedAbilitySets.Num(); }
+
   /** Get default max HP */
   float GetDefaultMaxHP() const { return DefaultMaxHP; }
 
@@ -44,6 +51,13 @@ public:
   /** Get pawn data */
   const UCombatPawnData *GetPawnData() const { return PawnData; }
 
+  /** Input router feeding the local player's input to the granted abilities */
+  FCombatAbilityInputRouter &GetInputRouter() { return InputRouter; }
+
+  /** Route the ability input queued this frame, called once per frame by the
+   * player controller */
+  void ProcessAbilityInput();
+
 protected:
   /** The ability system component for this player state */
   UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GAS",
@@ -63,11 +77,24 @@ protected:
 protected:
   virtual void BeginPlay() override;
 
+  /** Apply the pawn data attribute values and cache the defaults used by
+   * ResetAttributesToDefault */
+  void InitializePawnAttributes(const UCombatPawnData *InPawnData,
+                                const FCombatPawnDataOverrides &InOverrides);
+
 private:
   /** Current pawn data */
   UPROPERTY()
   const UCombatPawnData *PawnData = nullptr;
 
-  /** Handles for currently granted ability sets */
-  TArray<FCombatAbilitySetHandle> GrantedAbilitySetHandles;
+  /** Handles for currently granted ability sets, keyed by set so pawn data
+   * changes only grant and take the sets that differ */
+  TMap<TObjectKey<UCombatAbilitySet>, FCombatAbilitySetHandle>
+      GrantedAbilitySets;
+
+  /** Abilities and effects granted through the sets, shared between them */
+  FCombatAbilityGrantIndex GrantIndex;
+
+  /** Input tag to ability spec table, rebuilt when the granted sets change */
+  FCombatAbilityInputRouter InputRouter;
 };
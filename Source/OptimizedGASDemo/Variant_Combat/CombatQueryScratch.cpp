@@ -0,0 +1,44 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatQueryScratch.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Queries"), STAT_CombatQueries,
+                           STATGROUP_Combat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Combat Query Heap Allocations"),
+                           STAT_CombatQueryAllocations, STATGROUP_Combat);
+
+namespace {
+/** Buffers by nesting depth, boxed so they stay put when the pool grows */
+TArray<TUniquePtr<TArray<FHitResult>>> HitBufferPool;
+
+/** Number of buffers currently borrowed */
+int32 HitBufferDepth = 0;
+} // namespace
+
+namespace CombatQueryScratch {
+
+FScopedHitBuffer::FScopedHitBuffer() {
+  check(IsInGameThread());
+
+  if (!HitBufferPool.IsValidIndex(HitBufferDepth)) {
+    HitBufferPool.Add(MakeUnique<TArray<FHitResult>>());
+    INC_DWORD_STAT(STAT_CombatQueryAllocations);
+  }
+
+  Hits = HitBufferPool[HitBufferDepth++].Get();
+  Hits->Reset();
+  StartCapacity = Hits->Max();
+
+  INC_DWORD_STAT(STAT_CombatQueries);
+}
+
+FScopedHitBuffer::~FScopedHitBuffer() {
+  if (Hits->Max() > StartCapacity) {
+    INC_DWORD_STAT(STAT_CombatQueryAllocations);
+  }
+
+  --HitBufferDepth;
+}
+
+} // namespace CombatQueryScratch
@@ -0,0 +1,39 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/HitResult.h"
+#include "Misc/MemStack.h"
+
+class AActor;
+
+namespace CombatQueryScratch {
+
+/**
+ *  Hit result buffer borrowed from a game thread pool for one scope.
+ *  Buffers keep their capacity between queries, so traces in steady state
+ *  do not allocate. Nested scopes borrow separate buffers.
+ */
+class FScopedHitBuffer {
+public:
+  FScopedHitBuffer();
+  ~FScopedHitBuffer();
+
+  UE_NONCOPYABLE(FScopedHitBuffer);
+
+  /** Returns the empty buffer to pass to the query */
+  TArray<FHitResult> &Get() const { return *Hits; }
+
+private:
+  /** Pooled buffer for this scope */
+  TArray<FHitResult> *Hits;
+
+  /** Buffer capacity when borrowed, growth counts as a heap allocation */
+  int32 StartCapacity;
+};
+
+/** Actor list on the frame scratch stack, freed by the enclosing FMemMark */
+using FActorArray = TArray<AActor *, TMemStackAllocator<>>;
+
+} // namespace CombatQueryScratch
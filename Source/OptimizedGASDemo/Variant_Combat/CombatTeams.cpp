@@ -0,0 +1,37 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatTeams.h"
+#include "HAL/IConsoleManager.h"
+
+namespace {
+TAutoConsoleVariable<bool> CVarTeamQueryFilter(
+    TEXT("Combat.TeamQueryFilter"), true,
+    TEXT("Leave friendly hitboxes out of attack and danger queries. When ")
+        TEXT("off, attacks query every team's hitboxes"));
+} // namespace
+
+FCollisionObjectQueryParams
+CombatTeams::GetHostileHitboxParams(FGenericTeamId Team,
+                                    bool bIncludeTeamless) {
+  const bool bFilter = CVarTeamQueryFilter.GetValueOnGameThread();
+
+  FCollisionObjectQueryParams Params;
+  if (bIncludeTeamless) {
+    Params.AddObjectTypesToQuery(ECC_CombatHitbox);
+  }
+  if (!bFilter || Team != Players) {
+    Params.AddObjectTypesToQuery(ECC_CombatHitboxPlayers);
+  }
+  if (!bFilter || Team != Enemies) {
+    Params.AddObjectTypesToQuery(ECC_CombatHitboxEnemies);
+  }
+  return Params;
+}
+
+bool CombatTeams::IsHostile(FGenericTeamId Team, FGenericTeamId TargetTeam,
+                            bool bIncludeTeamless) {
+  if (TargetTeam == FGenericTeamId::NoTeam) {
+    return bIncludeTeamless;
+  }
+  return !CVarTeamQueryFilter.GetValueOnGameThread() || Team != TargetTeam;
+}
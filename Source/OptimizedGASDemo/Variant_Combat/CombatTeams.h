@@ -0,0 +1,39 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionQueryParams.h"
+#include "CombatCollisionChannels.h"
+#include "GenericTeamAgentInterface.h"
+
+namespace CombatTeams {
+
+/** Player characters */
+inline const FGenericTeamId Players(0);
+
+/** AI enemies */
+inline const FGenericTeamId Enemies(1);
+
+/** Returns the hitbox object channel for members of the given team */
+inline ECollisionChannel GetHitboxChannel(FGenericTeamId Team) {
+  if (Team == Players) {
+    return ECC_CombatHitboxPlayers;
+  }
+  if (Team == Enemies) {
+    return ECC_CombatHitboxEnemies;
+  }
+  return ECC_CombatHitbox;
+}
+
+/** Returns query params for the hitboxes a team can hit. Friendly hitboxes
+ * are left out of the query, teamless attackers hit every team */
+FCollisionObjectQueryParams GetHostileHitboxParams(FGenericTeamId Team,
+                                                   bool bIncludeTeamless);
+
+/** Returns true if an attacker on the given team may damage a target. Same
+ * rules as the hitbox params, for queries that don't go through physics */
+bool IsHostile(FGenericTeamId Team, FGenericTeamId TargetTeam,
+               bool bIncludeTeamless);
+
+} // namespace CombatTeams
@@ -0,0 +1,184 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatBotInputComponent.h"
+#include "CombatCharacter.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "OptimizedGASDemo.h"
+
+UCombatBotInputComponent::UCombatBotInputComponent() {
+  PrimaryComponentTick.bCanEverTick = true;
+  PrimaryComponentTick.bStartWithTickEnabled = true;
+
+  RandomWeights.Add(ECombatBotAction::Idle, 1.0f);
+  RandomWeights.Add(ECombatBotAction::Move, 4.0f);
+  RandomWeights.Add(ECombatBotAction::Lock, 1.0f);
+  RandomWeights.Add(ECombatBotAction::Combo, 3.0f);
+  RandomWeights.Add(ECombatBotAction::Charge, 2.0f);
+}
+
+bool UCombatBotInputComponent::IsBotClient() {
+  return FParse::Param(FCommandLine::Get(), TEXT("CombatBot"));
+}
+
+void UCombatBotInputComponent::BeginPlay() {
+  Super::BeginPlay();
+
+  ComboStartTag =
+      FGameplayTag::RequestGameplayTag(FName("Event.Attack.Combo.Start"));
+  ChargedStartTag =
+      FGameplayTag::RequestGameplayTag(FName("Event.Attack.Charged.Start"));
+  ChargedReleaseTag =
+      FGameplayTag::RequestGameplayTag(FName("Event.Attack.Charged.Release"));
+
+  // seed from the command line so each client gets a distinct but
+  // reproducible pattern
+  int32 Seed = 0;
+  FParse::Value(FCommandLine::Get(), TEXT("CombatBotSeed="), Seed);
+  Stream.Initialize(Seed);
+
+  // -CombatBotScript switches to the scripted pattern
+  if (FParse::Param(FCommandLine::Get(), TEXT("CombatBotScript"))) {
+    bUseScript = true;
+  }
+
+  if (bUseScript && Script.IsEmpty()) {
+    // default script: approach, lock, combo, charge, back off
+    Script.Add({ECombatBotAction::Move, 1.5f});
+    Script.Add({ECombatBotAction::Lock, 0.2f});
+    Script.Add({ECombatBotAction::Combo, 2.0f});
+    Script.Add({ECombatBotAction::Charge, 1.5f});
+    Script.Add({ECombatBotAction::Move, 1.0f});
+    Script.Add({ECombatBotAction::Idle, 0.5f});
+  }
+
+  UE_LOG(LogOptimizedGASDemo, Log,
+         TEXT("Combat bot started (seed %d, %s pattern)"), Seed,
+         bUseScript ? TEXT("scripted") : TEXT("random"));
+}
+
+void UCombatBotInputComponent::TickComponent(
+    float DeltaTime, ELevelTick TickType,
+    FActorComponentTickFunction *ThisTickFunction) {
+  Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+  TimeSinceReport += DeltaTime;
+  if (TimeSinceReport >= ReportInterval) {
+    ReportInputRate();
+  }
+
+  APlayerController *PC = Cast<APlayerController>(GetOwner());
+  ACombatCharacter *Character =
+      PC ? PC->GetPawn<ACombatCharacter>() : nullptr;
+  if (!Character) {
+    // waiting for a pawn (initial spawn or respawn)
+    CurrentAction = ECombatBotAction::Idle;
+    ActionTimeRemaining = 0.0f;
+    return;
+  }
+
+  ActionTimeRemaining -= DeltaTime;
+  if (ActionTimeRemaining <= 0.0f) {
+    EndAction(Character);
+    AdvanceStep();
+    BeginAction(Character, CurrentAction);
+  }
+
+  switch (CurrentAction) {
+  case ECombatBotAction::Move:
+    Character->DoMove(MoveInput.X, MoveInput.Y);
+    break;
+
+  case ECombatBotAction::Combo:
+    ComboPressTimer -= DeltaTime;
+    if (ComboPressTimer <= 0.0f) {
+      Character->DoAbilityTrigger(ComboStartTag);
+      ComboPressTimer = ComboPressInterval;
+      ++InputsSinceReport;
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+void UCombatBotInputComponent::AdvanceStep() {
+  if (bUseScript && Script.Num() > 0) {
+    const FCombatBotStep &Step = Script[ScriptIndex];
+    ScriptIndex = (ScriptIndex + 1) % Script.Num();
+
+    CurrentAction = Step.Action;
+    ActionTimeRemaining = Step.Duration;
+    return;
+  }
+
+  // weighted random pick
+  float TotalWeight = 0.0f;
+  for (const TPair<ECombatBotAction, float> &Pair : RandomWeights) {
+    TotalWeight += FMath::Max(Pair.Value, 0.0f);
+  }
+
+  CurrentAction = ECombatBotAction::Idle;
+  float Roll = Stream.FRandRange(0.0f, TotalWeight);
+  for (const TPair<ECombatBotAction, float> &Pair : RandomWeights) {
+    Roll -= FMath::Max(Pair.Value, 0.0f);
+    if (Roll <= 0.0f) {
+      CurrentAction = Pair.Key;
+      break;
+    }
+  }
+
+  ActionTimeRemaining = Stream.FRandRange(RandomDuration.X, RandomDuration.Y);
+}
+
+void UCombatBotInputComponent::BeginAction(ACombatCharacter *Character,
+                                           ECombatBotAction Action) {
+  switch (Action) {
+  case ECombatBotAction::Move:
+    MoveInput = FVector2D(Stream.FRandRange(-1.0f, 1.0f),
+                          Stream.FRandRange(-1.0f, 1.0f))
+                    .GetSafeNormal();
+    Character->DoLook(Stream.FRandRange(-45.0f, 45.0f), 0.0f);
+    ++InputsSinceReport;
+    break;
+
+  case ECombatBotAction::Lock:
+    Character->DoLockToggle();
+    ++InputsSinceReport;
+    break;
+
+  case ECombatBotAction::Combo:
+    // press immediately, then keep pressing to chain the combo
+    ComboPressTimer = 0.0f;
+    break;
+
+  case ECombatBotAction::Charge:
+    Character->DoAbilityTrigger(ChargedStartTag);
+    ++InputsSinceReport;
+    break;
+
+  default:
+    break;
+  }
+}
+
+void UCombatBotInputComponent::EndAction(ACombatCharacter *Character) {
+  // release the charge button if we were holding it
+  if (CurrentAction == ECombatBotAction::Charge) {
+    Character->DoAbilityTrigger(ChargedReleaseTag);
+    ++InputsSinceReport;
+  }
+
+  MoveInput = FVector2D::ZeroVector;
+}
+
+void UCombatBotInputComponent::ReportInputRate() {
+  UE_LOG(LogOptimizedGASDemo, Log,
+         TEXT("CombatBot: %.1f inputs/s over the last %.1fs"),
+         InputsSinceReport / TimeSinceReport, TimeSinceReport);
+
+  InputsSinceReport = 0;
+  TimeSinceReport = 0.0f;
+}
@@ -0,0 +1,127 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GameplayTagContainer.h"
+#include "CombatBotInputComponent.generated.h"
+
+class ACombatCharacter;
+
+/** Single input the bot can drive on its character */
+UENUM(BlueprintType)
+enum class ECombatBotAction : uint8 {
+  Idle,
+  Move,
+  Lock,
+  Combo,
+  Charge
+};
+
+/** One step of a scripted bot pattern */
+USTRUCT(BlueprintType)
+struct FCombatBotStep {
+  GENERATED_BODY()
+
+  /** Action to perform */
+  UPROPERTY(EditAnywhere, Category = "Bot")
+  ECombatBotAction Action = ECombatBotAction::Idle;
+
+  /** How long the action is held before moving to the next step */
+  UPROPERTY(EditAnywhere, Category = "Bot",
+            meta = (ClampMin = 0, Units = "s"))
+  float Duration = 1.0f;
+};
+
+/**
+ * Drives a combat character's input from scripted or randomized patterns so
+ * headless (-nullrhi) clients can generate replication load without players.
+ * Added to the local player controller when launched with -CombatBot.
+ */
+UCLASS(ClassGroup = (Combat), meta = (BlueprintSpawnableComponent))
+class UCombatBotInputComponent : public UActorComponent {
+  GENERATED_BODY()
+
+public:
+  UCombatBotInputComponent();
+
+  /** Returns true if this process was launched as a bot client */
+  static bool IsBotClient();
+
+  virtual void TickComponent(float DeltaTime, enum ELevelTick TickType,
+                             FActorComponentTickFunction *ThisTickFunction)
+      override;
+
+protected:
+  virtual void BeginPlay() override;
+
+  /** Pick the next action, either from the script or at random */
+  void AdvanceStep();
+
+  /** Start the given action on the character */
+  void BeginAction(ACombatCharacter *Character, ECombatBotAction Action);
+
+  /** Release anything still held by the current action */
+  void EndAction(ACombatCharacter *Character);
+
+  /** Log inputs sent per second for this client */
+  void ReportInputRate();
+
+  /** Scripted pattern. Used when bUseScript is set, otherwise random */
+  UPROPERTY(EditAnywhere, Category = "Bot")
+  TArray<FCombatBotStep> Script;
+
+  /** Whether to follow the script instead of randomized actions */
+  UPROPERTY(EditAnywhere, Category = "Bot")
+  bool bUseScript = false;
+
+  /** Relative weight of each action when picking at random */
+  UPROPERTY(EditAnywhere, Category = "Bot|Random")
+  TMap<ECombatBotAction, float> RandomWeights;
+
+  /** Random action duration range */
+  UPROPERTY(EditAnywhere, Category = "Bot|Random",
+            meta = (ClampMin = 0, Units = "s"))
+  FVector2D RandomDuration = FVector2D(0.5f, 2.0f);
+
+  /** Time between combo presses while comboing */
+  UPROPERTY(EditAnywhere, Category = "Bot",
+            meta = (ClampMin = 0.05, Units = "s"))
+  float ComboPressInterval = 0.35f;
+
+  /** Interval between input rate log lines */
+  UPROPERTY(EditAnywhere, Category = "Bot",
+            meta = (ClampMin = 1, Units = "s"))
+  float ReportInterval = 5.0f;
+
+private:
+  /** Random stream seeded from -CombatBotSeed so runs are reproducible */
+  FRandomStream Stream;
+
+  /** Action currently being performed */
+  ECombatBotAction CurrentAction = ECombatBotAction::Idle;
+
+  /** Time left on the current action */
+  float ActionTimeRemaining = 0.0f;
+
+  /** Time until the next combo press */
+  float ComboPressTimer = 0.0f;
+
+  /** Movement direction held during a move action */
+  FVector2D MoveInput = FVector2D::ZeroVector;
+
+  /** Next script step to run */
+  int32 ScriptIndex = 0;
+
+  /** Inputs sent since the last report */
+  int32 InputsSinceReport = 0;
+
+  /** Time accumulated since the last report */
+  float TimeSinceReport = 0.0f;
+
+  /** Cached trigger tags */
+  FGameplayTag ComboStartTag;
+  FGameplayTag ChargedStartTag;
+  FGameplayTag ChargedReleaseTag;
+};
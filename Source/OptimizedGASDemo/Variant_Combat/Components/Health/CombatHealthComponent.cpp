@@ -6,6 +6,7 @@
 #include "GameplayTagsManager.h"
 #include "GameFramework/Character.h"
 #include "Attributes/HealthAttributeSet.h"
+#include "CombatRagdollSubsystem.h"
 
 UCombatHealthComponent::UCombatHealthComponent(
     const FObjectInitializer &ObjectInitializer)
@@ -35,14 +36,7 @@ void UCombatHealthComponent::BeginPlay() {
 }
 
 void UCombatHealthComponent::EndPlay(const EEndPlayReason::Type EndPlayReason) {
-  if (AbilitySystemComponent) {
-    AbilitySystemComponent
-        ->GetGameplayAttributeValueChangeDelegate(HealthAttribute)
-        .Remove(HealthChangedDelegateHandle);
-    AbilitySystemComponent
-        ->GetGameplayAttributeValueChangeDelegate(MaxHealthAttribute)
-        .Remove(MaxHealthChangedDelegateHandle);
-  }
+  UninitializeFromAbilitySystem();
 
   Super::EndPlay(EndPlayReason);
 }
@@ -50,14 +44,7 @@ void UCombatHealthComponent::EndPlay(const EEndPlayReason::Type EndPlayReason) {
 void UCombatHealthComponent::InitializeWithAbilitySystem(
     UAbilitySystemComponent *InASC) {
   // Clean up old bindings if they exist
-  if (AbilitySystemComponent) {
-    AbilitySystemComponent
-        ->GetGameplayAttributeValueChangeDelegate(HealthAttribute)
-        .Remove(HealthChangedDelegateHandle);
-    AbilitySystemComponent
-        ->GetGameplayAttributeValueChangeDelegate(MaxHealthAttribute)
-        .Remove(MaxHealthChangedDelegateHandle);
-  }
+  UninitializeFromAbilitySystem();
 
   AbilitySystemComponent = InASC;
 
@@ -72,6 +59,15 @@ void UCombatHealthComponent::InitializeWithAbilitySystem(
             ->GetGameplayAttributeValueChangeDelegate(MaxHealthAttribute)
             .AddUObject(this, &UCombatHealthComponent::HandleMaxHealthChanged);
 
+    // Bind to damage and death raised by the attribute set
+    HealthSet = AbilitySystemComponent->GetSet<UHealthAttributeSet>();
+    if (HealthSet) {
+      DamageTakenDelegateHandle = HealthSet->OnDamageTaken.AddUObject(
+          this, &UCombatHealthComponent::HandleDamageTaken);
+      OutOfHealthDelegateHandle = HealthSet->OnOutOfHealth.AddUObject(
+          this, &UCombatHealthComponent::HandleOutOfHealth);
+    }
+
     // Initial check
     if (IsDead()) {
       HandleDeath();
@@ -79,6 +75,25 @@ void UCombatHealthComponent::InitializeWithAbilitySystem(
   }
 }
 
+void UCombatHealthComponent::UninitializeFromAbilitySystem() {
+  if (AbilitySystemComponent) {
+    AbilitySystemComponent
+        ->GetGameplayAttributeValueChangeDelegate(HealthAttribute)
+        .Remove(HealthChangedDelegateHandle);
+    AbilitySystemComponent
+        ->GetGameplayAttributeValueChangeDelegate(MaxHealthAttribute)
+        .Remove(MaxHealthChangedDelegateHandle);
+  }
+
+  if (HealthSet) {
+    HealthSet->OnDamageTaken.Remove(DamageTakenDelegateHandle);
+    HealthSet->OnOutOfHealth.Remove(OutOfHealthDelegateHandle);
+  }
+
+  HealthSet = nullptr;
+  AbilitySystemComponent = nullptr;
+}
+
 float UCombatHealthComponent::GetHealth() const {
   if (AbilitySystemComponent) {
     return AbilitySystemComponent->GetNumericAttribute(HealthAttribute);
@@ -127,19 +142,32 @@ void UCombatHealthComponent::HandleMaxHealthChanged(
   OnMaxHealthChanged.Broadcast(NewMaxHealth);
 }
 
+void UCombatHealthComponent::HandleDamageTaken(
+    AActor *DamageInstigator, AActor *DamageCauser,
+    const FGameplayEffectSpec &DamageSpec, float DamageMagnitude) {
+  OnDamageTaken.Broadcast(DamageInstigator, DamageCauser, DamageSpec,
+                          DamageMagnitude);
+}
+
+void UCombatHealthComponent::HandleOutOfHealth(
+    AActor *DamageInstigator, AActor *DamageCauser,
+    const FGameplayEffectSpec &DamageSpec, float DamageMagnitude) {
+  OnOutOfHealth.Broadcast(DamageInstigator, DamageCauser, DamageSpec,
+                          DamageMagnitude);
+}
+
 void UCombatHealthComponent::HandleDeath() {
   // Handle death logic here
   // For example, disable input, play death animation, etc.
   // This can be overridden in subclasses or use delegates
 
-  // Enable ragdoll physics on death
-  AActor *Owner = GetOwner();
-  if (Owner) {
-    ACharacter *Character = Cast<ACharacter>(Owner);
-    if (Character && Character->GetMesh()) {
-      Character->GetMesh()->SetPhysicsBlendWeight(1.0f);
-      Character->GetMesh()->SetSimulatePhysics(true);
-    }
+  // Enable ragdoll physics on death, within the ragdoll budget
+  ACharacter *Character = Cast<ACharacter>(GetOwner());
+  UCombatRagdollSubsystem *Ragdolls =
+      GetWorld() ? GetWorld()->GetSubsystem<UCombatRagdollSubsystem>()
+                 : nullptr;
+  if (Character && Ragdolls) {
+    Ragdolls->StartRagdoll(Character->GetMesh());
   }
 }
 
@@ -147,13 +175,12 @@ void UCombatHealthComponent::HandleRevive() {
   // Handle revive logic here
   // For example, enable input, reset animations, etc.
 
-  // Disable ragdoll physics
-  AActor *Owner = GetOwner();
-  if (Owner) {
-    ACharacter *Character = Cast<ACharacter>(Owner);
-    if (Character && Character->GetMesh()) {
-      Character->GetMesh()->SetPhysicsBlendWeight(0.0f);
-      Character->GetMesh()->SetSimulatePhysics(false);
-    }
+  // Disable ragdoll physics and release the ragdoll slot
+  ACharacter *Character = Cast<ACharacter>(GetOwner());
+  UCombatRagdollSubsystem *Ragdolls =
+      GetWorld() ? GetWorld()->GetSubsystem<UCombatRagdollSubsystem>()
+                 : nullptr;
+  if (Character && Ragdolls) {
+    Ragdolls->StopRagdoll(Character->GetMesh());
   }
 }
@@ -8,12 +8,20 @@
 #include "CombatHealthComponent.generated.h"
 
 class UAbilitySystemComponent;
+class UHealthAttributeSet;
+struct FGameplayEffectSpec;
 struct FOnAttributeChangeData;
 
 // Delegates for health changes
 DECLARE_MULTICAST_DELEGATE_OneParam(FHealth_HealthChanged, float);
 DECLARE_MULTICAST_DELEGATE_OneParam(FHealth_MaxHealthChanged, float);
 
+// Delegates for damage and death raised by the health attribute set (server)
+DECLARE_MULTICAST_DELEGATE_FourParams(FHealth_DamageTaken, AActor *, AActor *,
+                                      const FGameplayEffectSpec &, float);
+DECLARE_MULTICAST_DELEGATE_FourParams(FHealth_OutOfHealth, AActor *, AActor *,
+                                      const FGameplayEffectSpec &, float);
+
 /**
  * Component that manages health for characters using the Ability System.
  * Follows Lyra's HealthComponent pattern.
@@ -54,6 +62,10 @@ public:
   FHealth_HealthChanged OnHealthChanged;
   FHealth_MaxHealthChanged OnMaxHealthChanged;
 
+  // Delegates for damage taken and death (instigator, causer, spec, damage)
+  FHealth_DamageTaken OnDamageTaken;
+  FHealth_OutOfHealth OnOutOfHealth;
+
 protected:
   // Handle health attribute changes
   void HandleHealthChanged(const FOnAttributeChangeData &ChangeData);
@@ -61,6 +73,19 @@ protected:
   // Handle max health attribute changes
   void HandleMaxHealthChanged(const FOnAttributeChangeData &ChangeData);
 
+  // Handle damage applied by the health attribute set
+  void HandleDamageTaken(AActor *DamageInstigator, AActor *DamageCauser,
+                         const FGameplayEffectSpec &DamageSpec,
+                         float DamageMagnitude);
+
+  // Handle health reaching zero in the health attribute set
+  void HandleOutOfHealth(AActor *DamageInstigator, AActor *DamageCauser,
+                         const FGameplayEffectSpec &DamageSpec,
+                         float DamageMagnitude);
+
+  // Remove all ability system bindings
+  void UninitializeFromAbilitySystem();
+
   // Called when the owner dies
   void HandleDeath();
 
@@ -72,6 +97,10 @@ protected:
   UPROPERTY()
   UAbilitySystemComponent *AbilitySystemComponent;
 
+  // Cached health attribute set, source of damage and death events
+  UPROPERTY()
+  TObjectPtr<const UHealthAttributeSet> HealthSet;
+
   // Cached health attribute
   FGameplayAttribute HealthAttribute;
 
@@ -81,4 +110,8 @@ protected:
   // Delegate handles for attribute changes
   FDelegateHandle HealthChangedDelegateHandle;
   FDelegateHandle MaxHealthChangedDelegateHandle;
+
+  // Delegate handles for attribute set events
+  FDelegateHandle DamageTakenDelegateHandle;
+  FDelegateHandle OutOfHealthDelegateHandle;
 };
@@ -0,0 +1,146 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatHitboxComponent.h"
+#include "CombatTeams.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+
+namespace {
+/** Collision profile of the hitbox shapes, ignores every other channel */
+const FName HitboxProfileName(TEXT("CombatHitbox"));
+} // namespace
+
+UCombatHitboxComponent::UCombatHitboxComponent() {
+  PrimaryComponentTick.bCanEverTick = false;
+
+  // head, torso and limbs of the default mannequin
+  Bones = {
+      {FName(TEXT("head")), 1.5f},        {FName(TEXT("spine_03")), 1.0f},
+      {FName(TEXT("pelvis")), 1.0f},      {FName(TEXT("upperarm_l")), 0.75f},
+      {FName(TEXT("upperarm_r")), 0.75f}, {FName(TEXT("thigh_l")), 0.75f},
+      {FName(TEXT("thigh_r")), 0.75f}};
+}
+
+void UCombatHitboxComponent::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+  DestroyHitboxes();
+
+  Super::EndPlay(EndPlayReason);
+}
+
+void UCombatHitboxComponent::BuildHitboxes(UPrimitiveComponent *Target,
+                                           FGenericTeamId Team) {
+  DestroyHitboxes();
+  HitboxChannel = CombatTeams::GetHitboxChannel(Team);
+
+  if (!Target) {
+    return;
+  }
+
+  USkeletalMeshComponent *Mesh = Cast<USkeletalMeshComponent>(Target);
+  if (const UPhysicsAsset *PhysicsAsset =
+          Mesh ? Mesh->GetPhysicsAsset() : nullptr) {
+    for (const FCombatHitboxBone &Bone : Bones) {
+      const int32 BodyIndex = PhysicsAsset->FindBodyIndex(Bone.Bone);
+      if (BodyIndex != INDEX_NONE) {
+        AddBodyHitbox(Mesh, Bone,
+                      PhysicsAsset->SkeletalBodySetups[BodyIndex]->AggGeom);
+      }
+    }
+  }
+
+  // props, and meshes without matching bodies, get one box over the mesh
+  if (Hitboxes.IsEmpty()) {
+    AddBoundsHitbox(Target);
+  }
+}
+
+void UCombatHitboxComponent::SetTeam(FGenericTeamId Team) {
+  HitboxChannel = CombatTeams::GetHitboxChannel(Team);
+  for (UShapeComponent *Hitbox : Hitboxes) {
+    if (Hitbox) {
+      Hitbox->SetCollisionObjectType(HitboxChannel);
+    }
+  }
+}
+
+void UCombatHitboxComponent::SetHitboxesEnabled(bool bEnabled) {
+  for (UShapeComponent *Hitbox : Hitboxes) {
+    if (Hitbox) {
+      Hitbox->SetCollisionEnabled(bEnabled ? ECollisionEnabled::QueryOnly
+                                           : ECollisionEnabled::NoCollision);
+    }
+  }
+}
+
+float UCombatHitboxComponent::GetDamageMultiplier(
+    const UPrimitiveComponent *Hitbox) const {
+  const int32 Index = Hitboxes.IndexOfByKey(Hitbox);
+  return Index != INDEX_NONE ? DamageMultipliers[Index] : 1.0f;
+}
+
+void UCombatHitboxComponent::AddBodyHitbox(USkeletalMeshComponent *Mesh,
+                                           const FCombatHitboxBone &Bone,
+                                           const FKAggregateGeom &AggGeom) {
+  // one simplified shape per bone is enough for melee
+  if (AggGeom.SphylElems.Num() > 0) {
+    const FKSphylElem &Elem = AggGeom.SphylElems[0];
+    UCapsuleComponent *Capsule = NewObject<UCapsuleComponent>(GetOwner());
+    Capsule->InitCapsuleSize(Elem.Radius, Elem.Radius + Elem.Length * 0.5f);
+    AddHitbox(Capsule, Mesh, Bone.Bone, Elem.GetTransform(),
+              Bone.DamageMultiplier);
+  } else if (AggGeom.SphereElems.Num() > 0) {
+    const FKSphereElem &Elem = AggGeom.SphereElems[0];
+    USphereComponent *Sphere = NewObject<USphereComponent>(GetOwner());
+    Sphere->InitSphereRadius(Elem.Radius);
+    AddHitbox(Sphere, Mesh, Bone.Bone, Elem.GetTransform(),
+              Bone.DamageMultiplier);
+  } else if (AggGeom.BoxElems.Num() > 0) {
+    const FKBoxElem &Elem = AggGeom.BoxElems[0];
+    UBoxComponent *Box = NewObject<UBoxComponent>(GetOwner());
+    Box->InitBoxExtent(FVector(Elem.X, Elem.Y, Elem.Z) * 0.5f);
+    AddHitbox(Box, Mesh, Bone.Bone, Elem.GetTransform(),
+              Bone.DamageMultiplier);
+  }
+}
+
+void UCombatHitboxComponent::AddBoundsHitbox(UPrimitiveComponent *Target) {
+  // unscaled bounds, the target's scale is inherited through the attachment
+  const FBoxSphereBounds LocalBounds = Target->CalcBounds(FTransform::Identity);
+
+  UBoxComponent *Box = NewObject<UBoxComponent>(GetOwner());
+  Box->InitBoxExtent(LocalBounds.BoxExtent);
+  AddHitbox(Box, Target, NAME_None, FTransform(LocalBounds.Origin), 1.0f);
+}
+
+void UCombatHitboxComponent::AddHitbox(UShapeComponent *Shape,
+                                       UPrimitiveComponent *Parent,
+                                       FName Socket,
+                                       const FTransform &Transform,
+                                       float DamageMultiplier) {
+  Shape->SetCollisionProfileName(HitboxProfileName);
+  Shape->SetCollisionObjectType(HitboxChannel);
+  Shape->SetGenerateOverlapEvents(false);
+  Shape->SetCanEverAffectNavigation(false);
+  Shape->CanCharacterStepUpOn = ECB_No;
+  Shape->SetupAttachment(Parent, Socket);
+  Shape->SetRelativeTransform(Transform);
+  Shape->RegisterComponent();
+
+  Hitboxes.Add(Shape);
+  DamageMultipliers.Add(DamageMultiplier);
+}
+
+void UCombatHitboxComponent::DestroyHitboxes() {
+  for (UShapeComponent *Hitbox : Hitboxes) {
+    if (Hitbox) {
+      Hitbox->DestroyComponent();
+    }
+  }
+
+  Hitboxes.Reset();
+  DamageMultipliers.Reset();
+}
@@ -0,0 +1,90 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "GenericTeamAgentInterface.h"
+#include "CombatHitboxComponent.generated.h"
+
+class UPrimitiveComponent;
+class USkeletalMeshComponent;
+class UShapeComponent;
+struct FKAggregateGeom;
+
+/** A bone covered by a melee hitbox */
+USTRUCT(BlueprintType)
+struct FCombatHitboxBone {
+  GENERATED_BODY()
+
+  /** Bone whose physics body the hitbox copies */
+  UPROPERTY(EditAnywhere, Category = "Hitbox")
+  FName Bone;
+
+  /** Damage multiplier for hits landing on this bone */
+  UPROPERTY(EditAnywhere, Category = "Hitbox", meta = (ClampMin = 0))
+  float DamageMultiplier = 1.0f;
+};
+
+/**
+ *  Builds a small set of query-only shapes on the CombatHitbox object
+ *  channel. Skeletal meshes get one shape per listed bone, copied from the
+ *  bone's physics body. Other meshes get a single box over their bounds.
+ *  Each team has its own hitbox channel, so attacks can skip friendly
+ *  hitboxes in the query.
+ */
+UCLASS(ClassGroup = (Combat), meta = (BlueprintSpawnableComponent))
+class UCombatHitboxComponent : public UActorComponent {
+  GENERATED_BODY()
+
+public:
+  UCombatHitboxComponent();
+
+  /** Bones that get a hitbox, a subset of the physics asset bodies */
+  UPROPERTY(EditAnywhere, Category = "Hitbox")
+  TArray<FCombatHitboxBone> Bones;
+
+  /** Creates the hitboxes on the given mesh, replacing any existing ones */
+  void BuildHitboxes(UPrimitiveComponent *Target,
+                     FGenericTeamId Team = FGenericTeamId::NoTeam);
+
+  /** Moves the hitboxes to the given team's channel */
+  void SetTeam(FGenericTeamId Team);
+
+  /** Turns the hitbox queries off for the dead and back on when revived */
+  void SetHitboxesEnabled(bool bEnabled);
+
+  /** Returns the damage multiplier of the hitbox that was hit */
+  float GetDamageMultiplier(const UPrimitiveComponent *Hitbox) const;
+
+protected:
+  // ~begin UActorComponent interface
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+  // ~end UActorComponent interface
+
+  /** Adds a hitbox copied from the first shape of a bone's physics body */
+  void AddBodyHitbox(USkeletalMeshComponent *Mesh,
+                     const FCombatHitboxBone &Bone,
+                     const FKAggregateGeom &AggGeom);
+
+  /** Adds a single box covering the target's local bounds */
+  void AddBoundsHitbox(UPrimitiveComponent *Target);
+
+  /** Configures, attaches and registers a new hitbox shape */
+  void AddHitbox(UShapeComponent *Shape, UPrimitiveComponent *Parent,
+                 FName Socket, const FTransform &Transform,
+                 float DamageMultiplier);
+
+  /** Destroys every hitbox shape */
+  void DestroyHitboxes();
+
+  /** Hitbox shapes */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<UShapeComponent>> Hitboxes;
+
+  /** Damage multiplier for each hitbox shape */
+  TArray<float> DamageMultipliers;
+
+  /** Object channel of the hitbox shapes, from the owner's team */
+  TEnumAsByte<ECollisionChannel> HitboxChannel = ECC_CombatHitbox;
+};
@@ -8,7 +8,6 @@
 #include "AbilitySystemGlobals.h"
 #include "DrawDebugHelpers.h"
 #include "Net/UnrealNetwork.h"
-#include "TimerManager.h"
 #include "CombatCharacter.h"
 
 UCombatLockSystemComponent::UCombatLockSystemComponent() {
@@ -29,10 +28,12 @@ void UCombatLockSystemComponent::BeginPlay() {
   StateDeadTag = FGameplayTag::RequestGameplayTag(FName("State.Dead"));
 
   // Set up timer to check locked target validity periodically
-  GetWorld()->GetTimerManager().SetTimer(
-      CheckTimerHandle, this,
-      &UCombatLockSystemComponent::CheckLockedTargetValidity, CheckInterval,
-      true);
+  if (UCombatTimerSubsystem *Timers =
+          GetWorld()->GetSubsystem<UCombatTimerSubsystem>()) {
+    Timers->SetTimer(CheckTimerHandle, this,
+                     &UCombatLockSystemComponent::CheckLockedTargetValidity,
+                     CheckInterval, true);
+  }
 }
 
 void UCombatLockSystemComponent::EndPlay(
@@ -40,8 +41,9 @@ void UCombatLockSystemComponent::EndPlay(
   Super::EndPlay(EndPlayReason);
 
   // Clear the timer
-  if (CheckTimerHandle.IsValid()) {
-    GetWorld()->GetTimerManager().ClearTimer(CheckTimerHandle);
+  if (UCombatTimerSubsystem *Timers =
+          GetWorld()->GetSubsystem<UCombatTimerSubsystem>()) {
+    Timers->ClearTimer(CheckTimerHandle);
   }
 }
 
@@ -7,6 +7,7 @@
 #include "Components/ActorComponent.h"
 #include "Components/DecalComponent.h"
 #include "AI/CombatEnemy.h"
+#include "CombatTimerSubsystem.h"
 #include "CombatLockSystemComponent.generated.h"
 
 // Forward declarations
@@ -117,5 +118,5 @@ protected:
   FGameplayTag StateDeadTag;
 
   /** Timer handle for checking locked target validity */
-  FTimerHandle CheckTimerHandle;
+  FCombatTimerHandle CheckTimerHandle;
 };
@@ -0,0 +1,150 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatAbilityInputRouter.h"
+#include "AbilitySystemComponent.h"
+#include "CombatGameplayAbility.h"
+#include "Data/CombatInputConfig.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Process Ability Input"), STAT_CombatAbilityInput,
+                   STATGROUP_Combat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Routed Ability Inputs"),
+                           STAT_CombatRoutedInputs, STATGROUP_Combat);
+
+void FCombatAbilityInputRouter::Rebuild(const UAbilitySystemComponent *ASC,
+                                        const UCombatInputConfig *InputConfig) {
+  TagToHandles.Reset();
+  CachedInputConfig = InputConfig;
+  CachedNumSpecs = INDEX_NONE;
+
+  if (!ASC) {
+    return;
+  }
+
+  // only tags an input can fire are worth a table entry
+  TSet<FGameplayTag> InputTags;
+  if (InputConfig) {
+    for (const FCombatInputMapping &Mapping : InputConfig->InputMappings) {
+      for (const FCombatAbilityTriggerData &Trigger : Mapping.AbilityTriggers) {
+        InputTags.Add(Trigger.TriggerTag);
+      }
+    }
+  }
+
+  const TArray<FGameplayAbilitySpec> &Specs = ASC->GetActivatableAbilities();
+  CachedNumSpecs = Specs.Num();
+
+  for (const FGameplayAbilitySpec &Spec : Specs) {
+    const UCombatGameplayAbility *Ability =
+        Cast<UCombatGameplayAbility>(Spec.Ability);
+    if (!Ability) {
+      continue;
+    }
+
+    for (const FAbilityTriggerData &Trigger : Ability->GetAbilityTriggers()) {
+      if (Trigger.TriggerSource ==
+              EGameplayAbilityTriggerSource::GameplayEvent &&
+          (!InputConfig || InputTags.Contains(Trigger.TriggerTag))) {
+        TagToHandles.FindOrAdd(Trigger.TriggerTag).Add(Spec.Handle);
+      }
+    }
+  }
+}
+
+void FCombatAbilityInputRouter::Reset() {
+  TagToHandles.Reset();
+  TriggeredTags.Reset();
+  ReleasedTags.Reset();
+  CachedInputConfig.Reset();
+  CachedNumSpecs = INDEX_NONE;
+}
+
+void FCombatAbilityInputRouter::InputTagTriggered(const FGameplayTag &Tag) {
+  if (Tag.IsValid()) {
+    TriggeredTags.Add(Tag);
+  }
+}
+
+void FCombatAbilityInputRouter::InputTagReleased(const FGameplayTag &Tag) {
+  if (Tag.IsValid()) {
+    ReleasedTags.Add(Tag);
+  }
+}
+
+void FCombatAbilityInputRouter::ProcessAbilityInput(
+    UAbilitySystemComponent *ASC, AActor *Avatar) {
+  if (!ASC || (TriggeredTags.Num() == 0 && ReleasedTags.Num() == 0)) {
+    TriggeredTags.Reset();
+    ReleasedTags.Reset();
+    return;
+  }
+
+  SCOPE_CYCLE_COUNTER(STAT_CombatAbilityInput);
+
+  // specs replicated or changed since the table was built
+  if (CachedNumSpecs != ASC->GetActivatableAbilities().Num()) {
+    Rebuild(ASC, CachedInputConfig.Get());
+  }
+
+  for (const FGameplayTag &Tag : TriggeredTags) {
+    RouteTriggeredTag(ASC, Avatar, Tag);
+  }
+
+  for (const FGameplayTag &Tag : ReleasedTags) {
+    if (const auto *Handles = TagToHandles.Find(Tag)) {
+      for (const FGameplayAbilitySpecHandle &Handle : *Handles) {
+        FGameplayAbilitySpec *Spec = ASC->FindAbilitySpecFromHandle(Handle);
+        if (Spec && Spec->IsActive()) {
+          ASC->AbilitySpecInputReleased(*Spec);
+        }
+      }
+    }
+  }
+
+  INC_DWORD_STAT_BY(STAT_CombatRoutedInputs,
+                    TriggeredTags.Num() + ReleasedTags.Num());
+  TriggeredTags.Reset();
+  ReleasedTags.Reset();
+}
+
+void FCombatAbilityInputRouter::RouteTriggeredTag(
+    UAbilitySystemComponent *ASC, AActor *Avatar, const FGameplayTag &Tag) {
+  FGameplayEventData EventData;
+  EventData.EventTag = Tag;
+  EventData.Instigator = Avatar;
+  EventData.Target = Avatar;
+
+  // active abilities and wait tasks listen for the event itself, so it goes
+  // through the ASC whenever something is listening or a handle went stale
+  const auto *Handles = TagToHandles.Find(Tag);
+  const FGameplayEventMulticastDelegate *Listeners =
+      ASC->GenericGameplayEventCallbacks.Find(Tag);
+  bool bSendEvent = !Handles || (Listeners && Listeners->IsBound());
+
+  TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>> IdleHandles;
+  if (Handles) {
+    for (const FGameplayAbilitySpecHandle &Handle : *Handles) {
+      FGameplayAbilitySpec *Spec = ASC->FindAbilitySpecFromHandle(Handle);
+      if (!Spec) {
+        bSendEvent = true;
+        CachedNumSpecs = INDEX_NONE;
+      } else if (Spec->IsActive()) {
+        ASC->AbilitySpecInputPressed(*Spec);
+        bSendEvent = true;
+      } else {
+        IdleHandles.Add(Handle);
+      }
+    }
+  }
+
+  if (bSendEvent) {
+    ASC->HandleGameplayEvent(Tag, &EventData);
+    return;
+  }
+
+  // nothing listens, so trigger the idle abilities by their cached handles
+  for (const FGameplayAbilitySpecHandle &Handle : IdleHandles) {
+    ASC->TriggerAbilityFromGameplayEvent(Handle, ASC->AbilityActorInfo.Get(),
+                                         Tag, &EventData, *ASC);
+  }
+}
@@ -0,0 +1,61 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayAbilitySpecHandle.h"
+#include "GameplayTagContainer.h"
+
+class AActor;
+class UAbilitySystemComponent;
+class UCombatInputConfig;
+
+/**
+ * Routes input trigger tags straight to the ability specs they activate.
+ * The tag to spec handle table is built when abilities are granted, input
+ * is queued as it arrives and processed once per frame: idle abilities are
+ * triggered by handle, and active ones get AbilitySpecInputPressed/Released
+ * plus the gameplay event their listeners wait for.
+ */
+class FCombatAbilityInputRouter {
+public:
+  /** Rebuild the tag table from the ASC's specs, keeping only tags the input
+   * config triggers when one is given */
+  void Rebuild(const UAbilitySystemComponent *ASC,
+               const UCombatInputConfig *InputConfig);
+
+  /** Forget the table and any queued input */
+  void Reset();
+
+  /** Queue an input that fires the trigger tag */
+  void InputTagTriggered(const FGameplayTag &Tag);
+
+  /** Queue the release of an input that fired the trigger tag */
+  void InputTagReleased(const FGameplayTag &Tag);
+
+  /** Route the input queued this frame */
+  void ProcessAbilityInput(UAbilitySystemComponent *ASC, AActor *Avatar);
+
+  /** Number of trigger tags with cached spec handles */
+  int32 GetNumRoutedTags() const { return TagToHandles.Num(); }
+
+private:
+  /** Trigger or forward one tag */
+  void RouteTriggeredTag(UAbilitySystemComponent *ASC, AActor *Avatar,
+                         const FGameplayTag &Tag);
+
+  /** Event-triggered specs per input trigger tag */
+  TMap<FGameplayTag, TArray<FGameplayAbilitySpecHandle, TInlineAllocator<2>>>
+      TagToHandles;
+
+  /** Input queued since the last ProcessAbilityInput */
+  TArray<FGameplayTag, TInlineAllocator<4>> TriggeredTags;
+  TArray<FGameplayTag, TInlineAllocator<4>> ReleasedTags;
+
+  /** Input config the table was built for */
+  TWeakObjectPtr<const UCombatInputConfig> CachedInputConfig;
+
+  /** Spec count the table was built from. Specs replicate to clients after
+   * the grant, so a change triggers a rebuild */
+  int32 CachedNumSpecs = INDEX_NONE;
+};
@@ -4,6 +4,11 @@
 #include "AbilitySystemComponent.h"
 #include "GameplayEffect.h"
 
+void FCombatAbilityGrantIndex::Reset() {
+  Abilities.Reset();
+  Effects.Reset();
+}
+
 void FCombatAbilitySetHandle::AddAbilitySpecHandle(
     const FGameplayAbilitySpecHandle &Handle) {
   AbilitySpecHandles.Add(Handle);
@@ -18,12 +23,44 @@ void FCombatAbilitySetHandle::AddAttributeSet(UAttributeSet *AttributeSet) {
   GrantedAttributeSets.Add(AttributeSet);
 }
 
+void FCombatAbilitySetHandle::AddIndexedAbility(const UClass *AbilityClass) {
+  IndexedAbilities.Add(AbilityClass);
+}
+
+void FCombatAbilitySetHandle::AddIndexedEffect(const UClass *EffectClass) {
+  IndexedEffects.Add(EffectClass);
+}
+
 void FCombatAbilitySetHandle::TakeFromAbilitySystem(
-    UAbilitySystemComponent *ASC) {
+    UAbilitySystemComponent *ASC, FCombatAbilityGrantIndex *GrantIndex) {
   if (!ASC) {
     return;
   }
 
+  if (GrantIndex) {
+    // drop our references, entries shared with other sets stay granted
+    for (const TObjectKey<UClass> &AbilityClass : IndexedAbilities) {
+      FCombatAbilityGrantIndex::FAbilityEntry *Entry =
+          GrantIndex->Abilities.Find(AbilityClass);
+      if (Entry && --Entry->RefCount <= 0) {
+        ASC->ClearAbility(Entry->Handle);
+        GrantIndex->Abilities.Remove(AbilityClass);
+      }
+    }
+
+    for (const TObjectKey<UClass> &EffectClass : IndexedEffects) {
+      FCombatAbilityGrantIndex::FEffectEntry *Entry =
+          GrantIndex->Effects.Find(EffectClass);
+      if (Entry && --Entry->RefCount <= 0) {
+        ASC->RemoveActiveGameplayEffect(Entry->Handle);
+        GrantIndex->Effects.Remove(EffectClass);
+      }
+    }
+
+    Reset();
+    return;
+  }
+
   // Remove abilities
   for (const FGameplayAbilitySpecHandle &Handle : AbilitySpecHandles) {
     if (Handle.IsValid()) {
@@ -46,37 +83,63 @@ void FCombatAbilitySetHandle::TakeFromAbilitySystem(
 
 bool FCombatAbilitySetHandle::IsValid() const {
   return AbilitySpecHandles.Num() > 0 || GameplayEffectHandles.Num() > 0 ||
-         GrantedAttributeSets.Num() > 0;
+         GrantedAttributeSets.Num() > 0 || IndexedAbilities.Num() > 0 ||
+         IndexedEffects.Num() > 0;
 }
 
 void FCombatAbilitySetHandle::Reset() {
   AbilitySpecHandles.Reset();
   GameplayEffectHandles.Reset();
   GrantedAttributeSets.Reset();
+  IndexedAbilities.Reset();
+  IndexedEffects.Reset();
 }
 
 UCombatAbilitySet::UCombatAbilitySet() {}
 
 void UCombatAbilitySet::GiveToAbilitySystem(
     UAbilitySystemComponent *ASC, FCombatAbilitySetHandle &OutAbilitySetHandle,
-    UObject *SourceObject) const {
+    UObject *SourceObject, FCombatAbilityGrantIndex *GrantIndex) const {
   if (!ASC) {
     return;
   }
 
+  // without a shared index, track this call's grants only
+  FCombatAbilityGrantIndex LocalIndex;
+  if (!GrantIndex) {
+    GrantIndex = &LocalIndex;
+  }
+
   // Grant abilities from the base GameplayAbilitySet
   for (const FGameplayAbilityBindInfo &BindInfo : Abilities) {
     if (BindInfo.GameplayAbilityClass) {
-      // Check if ability is already granted
-      if (!ASC->FindAbilitySpecFromClass(BindInfo.GameplayAbilityClass)) {
+      const UClass *AbilityClass = BindInfo.GameplayAbilityClass.Get();
+      FCombatAbilityGrantIndex::FAbilityEntry *Entry =
+          GrantIndex->Abilities.Find(AbilityClass);
+      const bool bLive =
+          Entry && ASC->FindAbilitySpecFromHandle(Entry->Handle) != nullptr;
+      if (!bLive) {
+        // granted outside of ability sets, leave it to its owner
+        if (!Entry && ASC->FindAbilitySpecFromClass(
+                          BindInfo.GameplayAbilityClass)) {
+          continue;
+        }
+
+        // new, or removed since another set granted it: grant it again and
+        // keep the other sets' references
         FGameplayAbilitySpec AbilitySpec(BindInfo.GameplayAbilityClass, 1,
                                          (int32)BindInfo.Command);
-        FGameplayAbilitySpecHandle AbilitySpecHandle =
-            ASC->GiveAbility(AbilitySpec);
-        if (AbilitySpecHandle.IsValid()) {
-          OutAbilitySetHandle.AddAbilitySpecHandle(AbilitySpecHandle);
+        const FGameplayAbilitySpecHandle Handle = ASC->GiveAbility(AbilitySpec);
+        if (!Handle.IsValid()) {
+          continue;
         }
+        Entry = &GrantIndex->Abilities.FindOrAdd(AbilityClass);
+        Entry->Handle = Handle;
+        OutAbilitySetHandle.AddAbilitySpecHandle(Handle);
       }
+
+      ++Entry->RefCount;
+      OutAbilitySetHandle.AddIndexedAbility(AbilityClass);
     }
   }
 
@@ -100,22 +163,39 @@ void UCombatAbilitySet::GiveToAbilitySystem(
   for (const FGameplayEffectApplicationInfo &EffectInfo :
        GrantedGameplayEffects) {
     if (EffectInfo.GameplayEffect) {
-      // Check if effect is already active
-      FGameplayEffectQuery Query;
-      Query.EffectDefinition = EffectInfo.GameplayEffect;
-      TArray<FActiveGameplayEffectHandle> ActiveEffects =
-          ASC->GetActiveEffects(Query);
-      if (ActiveEffects.Num() == 0) {
+      const UClass *EffectClass = EffectInfo.GameplayEffect.Get();
+      FCombatAbilityGrantIndex::FEffectEntry *Entry =
+          GrantIndex->Effects.Find(EffectClass);
+      const bool bLive =
+          Entry && ASC->GetActiveGameplayEffect(Entry->Handle) != nullptr;
+      if (!bLive) {
+        // applied outside of ability sets, leave it to its owner
+        if (!Entry) {
+          FGameplayEffectQuery Query;
+          Query.EffectDefinition = EffectInfo.GameplayEffect;
+          if (ASC->GetActiveEffects(Query).Num() > 0) {
+            continue;
+          }
+        }
+
+        // new, or removed since another set applied it: apply it again and
+        // keep the other sets' references
         FGameplayEffectSpecHandle SpecHandle = ASC->MakeOutgoingSpec(
             EffectInfo.GameplayEffect, 1.0f, ASC->MakeEffectContext());
-        if (SpecHandle.IsValid()) {
-          FActiveGameplayEffectHandle EffectHandle =
-              ASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(), ASC);
-          if (EffectHandle.IsValid()) {
-            OutAbilitySetHandle.AddGameplayEffectHandle(EffectHandle);
-          }
+        const FActiveGameplayEffectHandle Handle =
+            SpecHandle.IsValid() ? ASC->ApplyGameplayEffectSpecToTarget(
+                                       *SpecHandle.Data.Get(), ASC)
+                                 : FActiveGameplayEffectHandle();
+        if (!Handle.IsValid()) {
+          continue;
         }
+        Entry = &GrantIndex->Effects.FindOrAdd(EffectClass);
+        Entry->Handle = Handle;
+        OutAbilitySetHandle.AddGameplayEffectHandle(Handle);
       }
+
+      ++Entry->RefCount;
+      OutAbilitySetHandle.AddIndexedEffect(EffectClass);
     }
   }
 }
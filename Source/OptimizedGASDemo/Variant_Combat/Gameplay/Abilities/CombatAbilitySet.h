@@ -11,6 +11,31 @@
 class UAttributeSet;
 class UGameplayEffect;
 
+/**
+ * Hashed index of the ability and effect classes granted by ability sets,
+ * reference counted per set. Sets sharing a class can be granted and taken
+ * independently, and repeat grants look classes up by hash instead of
+ * scanning the ASC's specs and active effects. Only grants made through the
+ * index are tracked, and an entry is checked against the ASC before it is
+ * reused since its effect can be removed elsewhere.
+ */
+struct FCombatAbilityGrantIndex {
+  void Reset();
+
+  struct FAbilityEntry {
+    FGameplayAbilitySpecHandle Handle;
+    int32 RefCount = 0;
+  };
+
+  struct FEffectEntry {
+    FActiveGameplayEffectHandle Handle;
+    int32 RefCount = 0;
+  };
+
+  TMap<TObjectKey<UClass>, FAbilityEntry> Abilities;
+  TMap<TObjectKey<UClass>, FEffectEntry> Effects;
+};
+
 /** Handle for tracking granted abilities, effects, and attributes */
 USTRUCT(BlueprintType)
 struct FCombatAbilitySetHandle {
@@ -19,7 +44,15 @@ struct FCombatAbilitySetHandle {
   void AddAbilitySpecHandle(const FGameplayAbilitySpecHandle &Handle);
   void AddGameplayEffectHandle(const FActiveGameplayEffectHandle &Handle);
   void AddAttributeSet(UAttributeSet *AttributeSet);
-  void TakeFromAbilitySystem(UAbilitySystemComponent *ASC);
+
+  /** Record a reference the set holds in a grant index */
+  void AddIndexedAbility(const UClass *AbilityClass);
+  void AddIndexedEffect(const UClass *EffectClass);
+
+  /** Remove what the set granted. With the grant index the set was given
+   * with, entries are only removed once no other set references them */
+  void TakeFromAbilitySystem(UAbilitySystemComponent *ASC,
+                             FCombatAbilityGrantIndex *GrantIndex = nullptr);
   bool IsValid() const;
   void Reset();
 
@@ -27,6 +60,8 @@ private:
   TArray<FGameplayAbilitySpecHandle> AbilitySpecHandles;
   TArray<FActiveGameplayEffectHandle> GameplayEffectHandles;
   TArray<TObjectPtr<UAttributeSet>> GrantedAttributeSets;
+  TArray<TObjectKey<UClass>> IndexedAbilities;
+  TArray<TObjectKey<UClass>> IndexedEffects;
 };
 
 /** Application info for attribute sets */
@@ -69,10 +104,14 @@ class UCombatAbilitySet : public UGameplayAbilitySet {
 public:
   UCombatAbilitySet();
 
-  /** Grants the ability set to the specified ability system component */
-  void GiveToAbilitySystem(UAbilitySystemComponent *ASC,
-                           FCombatAbilitySetHandle &OutAbilitySetHandle,
-                           UObject *SourceObject = nullptr) const;
+  /** Grants the ability set to the specified ability system component.
+   * Pass a grant index kept alongside the ASC to share it across sets and
+   * calls, otherwise only this call's grants are deduplicated */
+  void
+  GiveToAbilitySystem(UAbilitySystemComponent *ASC,
+                      FCombatAbilitySetHandle &OutAbilitySetHandle,
+                      UObject *SourceObject = nullptr,
+                      FCombatAbilityGrantIndex *GrantIndex = nullptr) const;
 
   /** Takes the ability set from the specified ability system component */
   void TakeFromAbilitySystem(UAbilitySystemComponent *ASC,
@@ -0,0 +1,358 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatAreaAttackAbility.h"
+#include "CombatBase.h"
+#include "CombatDamageable.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "Attributes/DamageAttributeSet.h"
+#include "Attributes/HealthAttributeSet.h"
+#include "Effects/CombatDamageGameplayEffect.h"
+#include "CombatCosmetics.h"
+#include "DrawDebugHelpers.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Area Attack"), STAT_CombatAreaAttack,
+                   STATGROUP_Combat);
+DECLARE_CYCLE_STAT(TEXT("Area Damage"), STAT_CombatAreaDamage,
+                   STATGROUP_Combat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Area Attack Targets"),
+                           STAT_CombatAreaTargets, STATGROUP_Combat);
+
+namespace {
+/** Time Iterations calls of Func and return the average in microseconds */
+template <typename FuncType>
+double TimeIterations(int32 Iterations, FuncType &&Func) {
+  const double StartTime = FPlatformTime::Seconds();
+  for (int32 Iteration = 0; Iteration < Iterations; ++Iteration) {
+    Func();
+  }
+  return (FPlatformTime::Seconds() - StartTime) * 1.0e6 / Iterations;
+}
+
+/** Time an area attack against N targets in radius, with 4N more outside
+ * it. Logs the candidate query against the grid and a brute force scan,
+ * then one shared damage spec against one spec per target, applied from
+ * the first pawn with a health set to up to N of its hostiles in the
+ * spatial index */
+void BenchmarkAreaAttack(const TArray<FString> &Args, UWorld *World) {
+  if (!World || World->GetNetMode() == NM_Client) {
+    return;
+  }
+
+  const int32 NumTargets =
+      Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 128;
+  const int32 Iterations =
+      Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 100;
+  const float Radius = 600.0f;
+
+  // fixed seed so runs are comparable
+  FRandomStream Random(42);
+  TArray<FVector> Points;
+  Points.Reserve(NumTargets * 5);
+  for (int32 Index = 0; Index < NumTargets; ++Index) {
+    // uniform over the disc, just inside its edge
+    const float Angle = Random.FRandRange(0.0f, UE_TWO_PI);
+    const float Distance = Radius * FMath::Sqrt(Random.FRand()) * 0.99f;
+    Points.Add(FVector(FMath::Cos(Angle) * Distance,
+                       FMath::Sin(Angle) * Distance, 0.0f));
+  }
+  for (int32 Index = 0; Index < NumTargets * 4; ++Index) {
+    Points.Add(FVector(Random.FRandRange(-20000.0f, 20000.0f),
+                       Random.FRandRange(-20000.0f, 20000.0f), 0.0f));
+  }
+
+  FCombatSpatialGrid Grid;
+  const double BuildTime = TimeIterations(Iterations, [&]() {
+    Grid.Build(Points, UCombatSpatialIndexSubsystem::GetCellSize());
+  });
+
+  int32 GridHits = 0;
+  const double GridTime = TimeIterations(Iterations, [&]() {
+    GridHits = 0;
+    Grid.ForEachInRadius(FVector::ZeroVector, Radius,
+                         [&](int32, const FVector &, double) { ++GridHits; });
+  });
+
+  int32 ScanHits = 0;
+  const double ScanTime = TimeIterations(Iterations, [&]() {
+    ScanHits = 0;
+    for (const FVector &Point : Points) {
+      ScanHits += Point.SizeSquared() <= FMath::Square(Radius) ? 1 : 0;
+    }
+  });
+
+  UE_LOG(LogOptimizedGASDemo, Log,
+         TEXT("Combat.BenchAreaAttack: %d/%d points in radius, grid build "
+              "%.2fus, grid query %.2fus, brute force %.2fus"),
+         GridHits, Points.Num(), BuildTime, GridTime, ScanTime);
+  ensure(GridHits == ScanHits);
+
+  UCombatSpatialIndexSubsystem *SpatialIndex =
+      World->GetSubsystem<UCombatSpatialIndexSubsystem>();
+  UAbilitySystemComponent *SourceASC = nullptr;
+  for (TActorIterator<APawn> It(World); It && !SourceASC; ++It) {
+    UAbilitySystemComponent *PawnASC =
+        UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(*It);
+    if (PawnASC && PawnASC->HasAttributeSetForAttribute(
+                       UHealthAttributeSet::GetIncomingDamageAttribute())) {
+      SourceASC = PawnASC;
+    }
+  }
+
+  if (!SpatialIndex || !SourceASC) {
+    UE_LOG(LogOptimizedGASDemo, Warning,
+           TEXT("Combat.BenchAreaAttack: no pawn with a health set, "
+                "skipping damage"));
+    return;
+  }
+
+  // the damage targets are the source's hostiles in the spatial index,
+  // closest first, the way the ability finds them
+  AActor *Avatar = SourceASC->GetAvatarActor();
+  FCombatSpatialQuery Query;
+  Query.Origin = Avatar->GetActorLocation();
+  // 10 km covers the level, and the grid answers it cell by cell
+  Query.Radius = 1.0e6f;
+  Query.Team = FGenericTeamId::GetTeamIdentifier(Avatar);
+  Query.IgnoreActor = Avatar;
+  TArray<FCombatSpatialResult> Results;
+  SpatialIndex->QueryTargets(Query, Results);
+
+  TArray<UAbilitySystemComponent *> TargetASCs;
+  for (const FCombatSpatialResult &Result : Results) {
+    UAbilitySystemComponent *TargetASC =
+        UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(
+            Result.Actor);
+    if (TargetASC && TargetASC != SourceASC &&
+        TargetASC->HasAttributeSetForAttribute(
+            UHealthAttributeSet::GetIncomingDamageAttribute())) {
+      TargetASCs.AddUnique(TargetASC);
+      if (TargetASCs.Num() == NumTargets) {
+        break;
+      }
+    }
+  }
+
+  if (TargetASCs.IsEmpty()) {
+    UE_LOG(LogOptimizedGASDemo, Warning,
+           TEXT("Combat.BenchAreaAttack: no hostile target with a health set "
+                "in the spatial index, skipping damage"));
+    return;
+  }
+
+  // zero damage still runs the full execution but leaves health untouched
+  const TSubclassOf<UGameplayEffect> EffectClass =
+      UCombatDamageGameplayEffect::StaticClass();
+
+  const double SharedTime = TimeIterations(Iterations, [&]() {
+    FGameplayEffectSpecHandle SpecHandle =
+        UCombatDamageGameplayEffect::MakeAreaDamageSpec(
+            SourceASC, EffectClass, 0.0f, Query.Origin, Radius, 0.25f, 0.0f,
+            0.0f, Avatar, Avatar);
+    for (UAbilitySystemComponent *TargetASC : TargetASCs) {
+      SourceASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(),
+                                                 TargetASC);
+    }
+  });
+
+  const double PerTargetTime = TimeIterations(Iterations, [&]() {
+    for (UAbilitySystemComponent *TargetASC : TargetASCs) {
+      FGameplayEffectSpecHandle SpecHandle =
+          UCombatDamageGameplayEffect::MakeDamageSpec(
+              SourceASC, EffectClass, 0.0f, FHitResult(), 0.0f, 0.0f, Avatar,
+              Avatar);
+      SourceASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(),
+                                                 TargetASC);
+    }
+  });
+
+  UE_LOG(LogOptimizedGASDemo, Log,
+         TEXT("Combat.BenchAreaAttack: damage from %s to %d of %d targets, "
+              "shared spec %.2fus, spec per target %.2fus"),
+         *GetNameSafe(Avatar), TargetASCs.Num(), NumTargets, SharedTime,
+         PerTargetTime);
+}
+
+FAutoConsoleCommandWithWorldAndArgs BenchAreaAttackCommand(
+    TEXT("Combat.BenchAreaAttack"),
+    TEXT("Times an area attack query against N targets in radius (default "
+         "128) and its damage against up to N hostile pawns, over M "
+         "iterations (default 100)"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+        &BenchmarkAreaAttack));
+} // namespace
+
+UCombatAreaAttackAbility::UCombatAreaAttackAbility() {
+  InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+  NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
+
+  // Set ability tags
+  FGameplayTagContainer AssetTags;
+  AssetTags.AddTag(
+      FGameplayTag::RequestGameplayTag(FName("Ability.Type.Attack.Area")));
+  SetAssetTags(AssetTags);
+
+  // Add state tag while active
+  ActivationOwnedTags.AddTag(
+      FGameplayTag::RequestGameplayTag(FName("State.Attacking")));
+
+  // Cancel this ability if death occurs
+  CancelAbilitiesWithTag.AddTag(
+      FGameplayTag::RequestGameplayTag(FName("Ability.Type.Death")));
+
+  // Add trigger to activate on area attack event
+  FAbilityTriggerData TriggerData;
+  TriggerData.TriggerTag =
+      FGameplayTag::RequestGameplayTag(FName("Event.Attack.Area"));
+  TriggerData.TriggerSource = EGameplayAbilityTriggerSource::GameplayEvent;
+  AbilityTriggers.Add(TriggerData);
+
+  // Set default damage gameplay effect
+  DamageGameplayEffect = UCombatDamageGameplayEffect::StaticClass();
+}
+
+void UCombatAreaAttackAbility::ActivateAbility(
+    const FGameplayAbilitySpecHandle Handle,
+    const FGameplayAbilityActorInfo *ActorInfo,
+    const FGameplayAbilityActivationInfo ActivationInfo,
+    const FGameplayEventData *TriggerEventData) {
+  Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
+
+  if (!CommitAbility(Handle, ActorInfo, ActivationInfo)) {
+    EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
+    return;
+  }
+
+  PerformAreaAttack();
+
+  // End ability immediately after the attack
+  EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
+}
+
+void UCombatAreaAttackAbility::PerformAreaAttack() {
+  SCOPE_CYCLE_COUNTER(STAT_CombatAreaAttack);
+
+  AActor *AvatarActor = GetAvatarActorFromActorInfo();
+  UCombatSpatialIndexSubsystem *SpatialIndex =
+      GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>();
+  if (!AvatarActor || !SpatialIndex) {
+    return;
+  }
+
+  // Get damage, knockback and launch from GAS attributes
+  UAbilitySystemComponent *ASC = GetAbilitySystemComponent(CurrentActorInfo);
+  float Damage = DamageAmount;
+  float Knockback = KnockbackImpulse;
+  float Launch = LaunchImpulse;
+  if (ASC) {
+    Damage +=
+        ASC->GetNumericAttribute(UDamageAttributeSet::GetDamageAttribute());
+    Knockback = ASC->GetNumericAttribute(
+        UDamageAttributeSet::GetKnockbackImpulseAttribute());
+    Launch = ASC->GetNumericAttribute(
+        UDamageAttributeSet::GetLaunchImpulseAttribute());
+  }
+
+  const FVector Forward = AvatarActor->GetActorForwardVector();
+  const FVector Origin =
+      AvatarActor->GetActorLocation() + (Forward * ForwardOffset);
+
+  // hostile and teamless targets in range, closest first
+  FCombatSpatialQuery Query;
+  Query.Origin = Origin;
+  Query.Radius = Radius;
+  Query.Direction = Forward;
+  Query.ConeHalfAngle = ConeHalfAngle;
+  Query.Team = FGenericTeamId::GetTeamIdentifier(AvatarActor);
+  Query.IgnoreActor = AvatarActor;
+  Query.MaxResults = MaxTargets;
+  SpatialIndex->QueryTargets(Query, TargetScratch);
+
+  INC_DWORD_STAT_BY(STAT_CombatAreaTargets, TargetScratch.Num());
+
+#if ENABLE_DRAW_DEBUG
+  if (CombatCosmetics::ShouldDrawDebug(GetWorld())) {
+    if (ConeHalfAngle < 180.0f) {
+      const float ConeAngle = FMath::DegreesToRadians(ConeHalfAngle);
+      DrawDebugCone(GetWorld(), Origin, Forward, Radius, ConeAngle, ConeAngle,
+                    16, FColor::Orange, false, 2.0f);
+    } else {
+      DrawDebugSphere(GetWorld(), Origin, Radius, 16, FColor::Orange, false,
+                      2.0f);
+    }
+    for (const FCombatSpatialResult &Target : TargetScratch) {
+      DrawDebugSphere(GetWorld(), Target.Location, 10.0f, 12, FColor::Red,
+                      false, 2.0f);
+    }
+  }
+#endif
+
+  // Damage is only applied by the server, predicting clients just query
+  if (TargetScratch.Num() > 0 && HasAuthority(&CurrentActivationInfo)) {
+    ApplyAreaDamage(Origin, Damage, Knockback, Launch);
+  }
+
+  // the results hold raw actor pointers, don't keep them past the attack
+  TargetScratch.Reset();
+}
+
+void UCombatAreaAttackAbility::ApplyAreaDamage(const FVector &Origin,
+                                               float Damage, float Knockback,
+                                               float Launch) {
+  SCOPE_CYCLE_COUNTER(STAT_CombatAreaDamage);
+
+  AActor *AvatarActor = GetAvatarActorFromActorInfo();
+  UAbilitySystemComponent *SourceASC =
+      GetAbilitySystemComponent(CurrentActorInfo);
+
+  // one spec for the whole area, each target's falloff is resolved from
+  // the origin on the context
+  FGameplayEffectSpecHandle SpecHandle =
+      UCombatDamageGameplayEffect::MakeAreaDamageSpec(
+          SourceASC, DamageGameplayEffect, Damage, Origin, Radius,
+          EdgeMultiplier, Knockback, Launch, AvatarActor, AvatarActor);
+  if (!SpecHandle.IsValid()) {
+    return;
+  }
+  const FGameplayEffectSpec &Spec = *SpecHandle.Data.Get();
+
+  FGameplayAbilityTargetData_ActorArray *ActorData =
+      new FGameplayAbilityTargetData_ActorArray();
+  ActorData->TargetActorArray.Reserve(TargetScratch.Num());
+  FGameplayAbilityTargetDataHandle TargetData(ActorData);
+
+  for (const FCombatSpatialResult &Target : TargetScratch) {
+    if (UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(
+            Target.Actor)) {
+      ActorData->TargetActorArray.Add(Target.Actor);
+    } else if (ICombatDamageable *Damageable =
+                   Cast<ICombatDamageable>(Target.Actor)) {
+      // props without an ability system queue the same falloff damage
+      Damageable->ApplyDamage(
+          Damage * UCombatDamageGameplayEffect::GetFalloffMultiplier(
+                       Spec, Target.Location),
+          AvatarActor, Target.Location,
+          UCombatDamageGameplayEffect::GetDamageImpulse(Spec,
+                                                        Target.Location));
+    }
+  }
+
+  // the spec is copied once and applied to every target
+  if (ActorData->TargetActorArray.Num() > 0) {
+    ApplyGameplayEffectSpecToTarget(CurrentSpecHandle, CurrentActorInfo,
+                                    CurrentActivationInfo, SpecHandle,
+                                    TargetData);
+  }
+
+  // hit feedback for the attacker once per attack
+  if (ACombatBase *CombatBase = GetCombatBaseFromActorInfo()) {
+    CombatBase->DealtDamage(Damage, Origin);
+  }
+}
@@ -0,0 +1,82 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatGameplayAbility.h"
+#include "CombatSpatialIndexSubsystem.h"
+#include "CombatAreaAttackAbility.generated.h"
+
+class UGameplayEffect;
+
+/**
+ * GameplayAbility for area of effect attacks such as slams and explosions.
+ * Targets in a sphere or cone are taken from the shared spatial index
+ * instead of a physics sweep, and every target with an ability system
+ * receives the same damage spec, scaled by distance in the damage execution.
+ */
+UCLASS()
+class UCombatAreaAttackAbility : public UCombatGameplayAbility {
+  GENERATED_BODY()
+
+public:
+  UCombatAreaAttackAbility();
+
+  virtual void
+  ActivateAbility(const FGameplayAbilitySpecHandle Handle,
+                  const FGameplayAbilityActorInfo *ActorInfo,
+                  const FGameplayAbilityActivationInfo ActivationInfo,
+                  const FGameplayEventData *TriggerEventData) override;
+
+protected:
+  /** Damage at the center of the area */
+  UPROPERTY(EditDefaultsOnly, Category = "Attack", meta = (ClampMin = 0))
+  float DamageAmount = 20.0f;
+
+  /** Knockback impulse at the center of the area */
+  UPROPERTY(EditDefaultsOnly, Category = "Attack", meta = (ClampMin = 0))
+  float KnockbackImpulse = 800.0f;
+
+  /** Launch impulse at the center of the area */
+  UPROPERTY(EditDefaultsOnly, Category = "Attack", meta = (ClampMin = 0))
+  float LaunchImpulse = 400.0f;
+
+  /** Radius of the area */
+  UPROPERTY(EditDefaultsOnly, Category = "Area",
+            meta = (ClampMin = 0, Units = "cm"))
+  float Radius = 400.0f;
+
+  /** Half angle of the cone in front of the avatar, 180 for a full circle */
+  UPROPERTY(EditDefaultsOnly, Category = "Area",
+            meta = (ClampMin = 0, ClampMax = 180, Units = "deg"))
+  float ConeHalfAngle = 180.0f;
+
+  /** Distance in front of the avatar where the area is centered */
+  UPROPERTY(EditDefaultsOnly, Category = "Area", meta = (Units = "cm"))
+  float ForwardOffset = 0.0f;
+
+  /** Damage and knockback multiplier at the edge of the area */
+  UPROPERTY(EditDefaultsOnly, Category = "Area",
+            meta = (ClampMin = 0, ClampMax = 1))
+  float EdgeMultiplier = 0.25f;
+
+  /** Maximum number of targets hit, closest first. 0 for no limit */
+  UPROPERTY(EditDefaultsOnly, Category = "Area", meta = (ClampMin = 0))
+  int32 MaxTargets = 0;
+
+  /** Damage gameplay effect applied to targets that have an ASC */
+  UPROPERTY(EditDefaultsOnly, Category = "Attack")
+  TSubclassOf<UGameplayEffect> DamageGameplayEffect;
+
+  /** Find the targets in the area and damage them */
+  void PerformAreaAttack();
+
+  /** Apply one damage spec to every target with an ability system, and
+   * the same falloff to props without one (server only) */
+  void ApplyAreaDamage(const FVector &Origin, float Damage, float Knockback,
+                       float Launch);
+
+private:
+  /** Targets of the current attack, reused between activations */
+  TArray<FCombatSpatialResult> TargetScratch;
+};
@@ -11,6 +11,8 @@
 #include "Effects/CombatStaminaCostGameplayEffect.h"
 #include "Effects/CombatStaminaUsedGameplayEffect.h"
 #include "Effects/CombatStaminaUsedResetGameplayEffect.h"
+#include "Abilities/Tasks/CombatAbilityTask_PlayMontageAndWaitForSection.h"
+#include "Abilities/Tasks/CombatAbilityTask_WaitChargeLoop.h"
 
 UCombatChargedAttackAbility::UCombatChargedAttackAbility() {
   // Set up ability tags
@@ -56,11 +58,7 @@ void UCombatChargedAttackAbility::ActivateAbility(
   UAbilitySystemComponent *ASC = GetAbilitySystemComponent(ActorInfo);
   if (ASC->HasMatchingGameplayTag(
           FGameplayTag::RequestGameplayTag(FName("State.Stunned")))) {
-    // For enemies, notify StateTree that attack is completed even when stunned
-    ACombatBase *CombatBase = GetCombatBaseFromActorInfo();
-    if (ACombatEnemy *CombatEnemy = Cast<ACombatEnemy>(CombatBase)) {
-      CombatEnemy->OnAttackCompleted.ExecuteIfBound();
-    }
+    // enemies hear about the early end through their AI command
     EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
     return;
   }
@@ -134,10 +132,10 @@ void UCombatChargedAttackAbility::ActivateAbility(
       }
     }
 
-    // Add camera shake for feedback (only for player)
+    // Add camera shake for feedback (only for the local player)
     if (ACombatCharacter *CombatChar = Cast<ACombatCharacter>(CombatBase)) {
       if (CombatChar->GetAttackCameraShake() &&
-          CombatBase->IsPlayerControlled()) {
+          CombatBase->IsLocallyControlled()) {
         if (APlayerController *PC =
                 Cast<APlayerController>(CombatBase->GetController())) {
           if (PC->PlayerCameraManager) {
@@ -162,51 +160,30 @@ void UCombatChargedAttackAbility::ActivateAbility(
   CurrentChargeLoop = 1;
   bAutoReleased = false;
 
-  // Play montage
-  if (ChargedAttackMontage) {
-    if (UAnimInstance *AnimInstance = ActorInfo->GetAnimInstance()) {
-      AnimInstance->Montage_Play(ChargedAttackMontage, 1.0f);
-
-      // Set end delegate
-      FOnMontageEnded MontageEndDelegate;
-      MontageEndDelegate.BindUObject(
-          this, &UCombatChargedAttackAbility::OnMontageEnded);
-      AnimInstance->Montage_SetEndDelegate(MontageEndDelegate,
-                                           ChargedAttackMontage);
-    }
-  } else {
-    // No montage available
-  }
-
-  // Listen for events
-  if (ASC) {
-    ASC->GenericGameplayEventCallbacks
-        .FindOrAdd(FGameplayTag::RequestGameplayTag(
-            FName("Event.Attack.Charged.Loop")))
-        .AddUObject(this,
-                    &UCombatChargedAttackAbility::HandleChargedAttackLoop);
-    ASC->GenericGameplayEventCallbacks
-        .FindOrAdd(FGameplayTag::RequestGameplayTag(
-            FName("Event.Attack.Charged.Release")))
-        .AddUObject(this,
-                    &UCombatChargedAttackAbility::HandleChargedAttackRelease);
-  }
+  // Listen for charge loops and the release
+  static const FGameplayTag LoopTag =
+      FGameplayTag::RequestGameplayTag(FName("Event.Attack.Charged.Loop"));
+  static const FGameplayTag ReleaseTag =
+      FGameplayTag::RequestGameplayTag(FName("Event.Attack.Charged.Release"));
+  UCombatAbilityTask_WaitChargeLoop *LoopTask =
+      UCombatAbilityTask_WaitChargeLoop::WaitChargeLoop(this, LoopTag,
+                                                        ReleaseTag);
+  LoopTask->OnLoop.BindUObject(
+      this, &UCombatChargedAttackAbility::HandleChargedAttackLoop);
+  LoopTask->OnRelease.BindUObject(
+      this, &UCombatChargedAttackAbility::HandleChargedAttackRelease);
+  LoopTask->ReadyForActivation();
+
+  // Play montage, ending the ability if it can't play
+  MontageTask = UCombatAbilityTask_PlayMontageAndWaitForSection::
+      PlayMontageAndWaitForSection(this, ChargedAttackMontage);
+  MontageTask->OnMontageEnded.BindUObject(
+      this, &UCombatChargedAttackAbility::OnMontageEnded);
+  MontageTask->ReadyForActivation();
 }
 
 void UCombatChargedAttackAbility::OnMontageEnded(UAnimMontage *Montage,
                                                  bool bInterrupted) {
-  // Reset stamina used for next attack via GE
-  UAbilitySystemComponent *ASC =
-      GetAbilitySystemComponent(GetCurrentActorInfo());
-  if (ASC) {
-    FGameplayEffectSpecHandle ResetSpecHandle = ASC->MakeOutgoingSpec(
-        UCombatStaminaUsedResetGameplayEffect::StaticClass(), 1.0f,
-        ASC->MakeEffectContext());
-    if (ResetSpecHandle.IsValid()) {
-      ASC->ApplyGameplayEffectSpecToTarget(*ResetSpecHandle.Data.Get(), ASC);
-    }
-  }
-
   // Call the character's attack montage ended function
   if (AActor *Avatar = GetCurrentActorInfo()->AvatarActor.Get()) {
     if (ACombatBase *CombatBase = Cast<ACombatBase>(Avatar)) {
@@ -223,40 +200,31 @@ void UCombatChargedAttackAbility::EndAbility(
     const FGameplayAbilityActorInfo *ActorInfo,
     const FGameplayAbilityActivationInfo ActivationInfo,
     bool bReplicateEndAbility, bool bWasCancelled) {
-  // Stop montage only if cancelled
+  // Stop montage only if cancelled, the tasks drop their listeners either way
   if (bWasCancelled && ChargedAttackMontage) {
     if (UAnimInstance *AnimInstance = ActorInfo->GetAnimInstance()) {
       AnimInstance->Montage_Stop(0.0f, ChargedAttackMontage);
     }
   }
 
-  // Remove montage end delegate only if cancelled
-  if (bWasCancelled && ChargedAttackMontage) {
-    if (UAnimInstance *AnimInstance = ActorInfo->GetAnimInstance()) {
-      FOnMontageEnded EmptyDelegate;
-      AnimInstance->Montage_SetEndDelegate(EmptyDelegate, ChargedAttackMontage);
+  // Reset stamina used for next attack via GE. The montage end no longer
+  // reaches an ability that ended early, so this runs on every end
+  if (UAbilitySystemComponent *ASC = GetAbilitySystemComponent(ActorInfo)) {
+    FGameplayEffectSpecHandle ResetSpecHandle = ASC->MakeOutgoingSpec(
+        UCombatStaminaUsedResetGameplayEffect::StaticClass(), 1.0f,
+        ASC->MakeEffectContext());
+    if (ResetSpecHandle.IsValid()) {
+      ASC->ApplyGameplayEffectSpecToTarget(*ResetSpecHandle.Data.Get(), ASC);
     }
   }
 
-  // Remove event listeners
-  if (UAbilitySystemComponent *ASC =
-          GetAbilitySystemComponent(CurrentActorInfo)) {
-    ASC->GenericGameplayEventCallbacks
-        .FindOrAdd(FGameplayTag::RequestGameplayTag(
-            FName("Event.Attack.Charged.Loop")))
-        .RemoveAll(this);
-    ASC->GenericGameplayEventCallbacks
-        .FindOrAdd(FGameplayTag::RequestGameplayTag(
-            FName("Event.Attack.Charged.Release")))
-        .RemoveAll(this);
-  }
+  MontageTask = nullptr;
 
   Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility,
                     bWasCancelled);
 }
 
-void UCombatChargedAttackAbility::HandleChargedAttackLoop(
-    const FGameplayEventData *EventData) {
+void UCombatChargedAttackAbility::HandleChargedAttackLoop() {
   // Apply stamina cost for each loop like a combo hit
   UAbilitySystemComponent *ASC = GetAbilitySystemComponent(CurrentActorInfo);
   if (ASC && StaminaCosts.Num() > 0) {
@@ -272,7 +240,7 @@ void UCombatChargedAttackAbility::HandleChargedAttackLoop(
         ASC->SetNumericAttributeBase(
             UStaminaAttributeSet::GetStaminaAttribute(), 0.0f);
       }
-      HandleChargedAttackRelease(EventData);
+      HandleChargedAttackRelease();
       bAutoReleased = true;
       return;
     }
@@ -294,33 +262,20 @@ void UCombatChargedAttackAbility::HandleChargedAttackLoop(
 
   if (bIsPlayerControlled) {
     // For player, always loop if still holding
-    if (UAnimInstance *AnimInstance =
-            GetCurrentActorInfo()->GetAnimInstance()) {
-      AnimInstance->Montage_JumpToSection(ChargeLoopSection,
-                                          ChargedAttackMontage);
-    }
+    MontageTask->JumpToSection(ChargeLoopSection);
   } else {
     // For AI, check if we need to loop more
     CurrentChargeLoop++;
     if (CurrentChargeLoop < TargetChargeLoops) {
-      if (UAnimInstance *AnimInstance =
-              GetCurrentActorInfo()->GetAnimInstance()) {
-        AnimInstance->Montage_JumpToSection(ChargeLoopSection,
-                                            ChargedAttackMontage);
-      }
+      MontageTask->JumpToSection(ChargeLoopSection);
     } else {
       // Go to attack
-      if (UAnimInstance *AnimInstance =
-              GetCurrentActorInfo()->GetAnimInstance()) {
-        AnimInstance->Montage_JumpToSection(ChargeAttackSection,
-                                            ChargedAttackMontage);
-      }
+      MontageTask->JumpToSection(ChargeAttackSection);
     }
   }
 }
 
-void UCombatChargedAttackAbility::HandleChargedAttackRelease(
-    const FGameplayEventData *EventData) {
+void UCombatChargedAttackAbility::HandleChargedAttackRelease() {
   // If already auto-released due to insufficient stamina, do nothing
   if (bAutoReleased) {
     return;
@@ -341,8 +296,7 @@ void UCombatChargedAttackAbility::HandleChargedAttackRelease(
   }
 
   // Release attack
-  if (UAnimInstance *AnimInstance = GetCurrentActorInfo()->GetAnimInstance()) {
-    AnimInstance->Montage_JumpToSection(ChargeAttackSection,
-                                        ChargedAttackMontage);
+  if (MontageTask) {
+    MontageTask->JumpToSection(ChargeAttackSection);
   }
 }
@@ -6,6 +6,8 @@
 #include "CombatGameplayAbility.h"
 #include "CombatChargedAttackAbility.generated.h"
 
+class UCombatAbilityTask_PlayMontageAndWaitForSection;
+
 /**
  * GameplayAbility for performing charged attacks
  */
@@ -28,11 +30,11 @@ public:
                           bool bReplicateEndAbility,
                           bool bWasCancelled) override;
 
-  /** Handle charged attack loop event */
-  void HandleChargedAttackLoop(const FGameplayEventData *EventData);
+  /** Handle the end of a charge loop */
+  void HandleChargedAttackLoop();
 
-  /** Handle charged attack release event */
-  void HandleChargedAttackRelease(const FGameplayEventData *EventData);
+  /** Handle the release of the charge */
+  void HandleChargedAttackRelease();
 
   /** Called when montage ends */
   void OnMontageEnded(UAnimMontage *Montage, bool bInterrupted);
@@ -62,8 +64,9 @@ protected:
   UPROPERTY(EditDefaultsOnly, Category = "Charged Attack")
   FName ChargeAttackSection;
 
-  /** Montage ended delegate */
-  FOnMontageEnded MontageEndedDelegate;
+  /** Task playing the charged attack montage */
+  UPROPERTY()
+  TObjectPtr<UCombatAbilityTask_PlayMontageAndWaitForSection> MontageTask;
 
   /** Whether this ability is controlled by player or AI */
   bool bIsPlayerControlled;
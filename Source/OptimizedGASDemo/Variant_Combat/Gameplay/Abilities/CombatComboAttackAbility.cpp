@@ -10,6 +10,8 @@
 #include "Effects/CombatStaminaCostGameplayEffect.h"
 #include "Effects/CombatStaminaUsedGameplayEffect.h"
 #include "Effects/CombatStaminaUsedResetGameplayEffect.h"
+#include "Abilities/Tasks/CombatAbilityTask_PlayMontageAndWaitForSection.h"
+#include "Abilities/Tasks/CombatAbilityTask_WaitComboWindow.h"
 
 UCombatComboAttackAbility::UCombatComboAttackAbility() {
   InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
@@ -59,10 +61,7 @@ void UCombatComboAttackAbility::ActivateAbility(
   UAbilitySystemComponent *ASC = GetAbilitySystemComponent(ActorInfo);
   if (ASC->HasMatchingGameplayTag(
           FGameplayTag::RequestGameplayTag(FName("State.Stunned")))) {
-    // For enemies, notify StateTree that attack is completed even when stunned
-    if (ACombatEnemy *CombatEnemy = Cast<ACombatEnemy>(CombatBase)) {
-      CombatEnemy->OnAttackCompleted.ExecuteIfBound();
-    }
+    // enemies hear about the early end through their AI command
     EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
     return;
   }
@@ -136,10 +135,10 @@ void UCombatComboAttackAbility::ActivateAbility(
     }
   }
 
-  // Add camera shake for feedback (only for player)
+  // Add camera shake for feedback (only for the local player)
   if (ACombatCharacter *CombatChar = Cast<ACombatCharacter>(CombatBase)) {
     if (CombatChar->GetAttackCameraShake() &&
-        CombatBase->IsPlayerControlled()) {
+        CombatBase->IsLocallyControlled()) {
       if (APlayerController *PC =
               Cast<APlayerController>(CombatBase->GetController())) {
         if (PC->PlayerCameraManager) {
@@ -162,55 +161,30 @@ void UCombatComboAttackAbility::ActivateAbility(
 
   CurrentComboCount = 0;
 
-  // Play montage from first section
-  if (ComboAttackMontage && ComboSectionNames.Num() > 0) {
-    if (UAnimInstance *AnimInstance = ActorInfo->GetAnimInstance()) {
-      AnimInstance->Montage_Play(ComboAttackMontage, 1.0f);
-
-      // Jump to first section
-      AnimInstance->Montage_JumpToSection(ComboSectionNames[0],
-                                          ComboAttackMontage);
-
-      // Set end delegate
-      FOnMontageEnded MontageEndDelegate;
-      MontageEndDelegate.BindUObject(
-          this, &UCombatComboAttackAbility::OnMontageEnded);
-      AnimInstance->Montage_SetEndDelegate(MontageEndDelegate,
-                                           ComboAttackMontage);
-    }
-  } else {
-    // No montage or sections available
-  }
-
-  // Listen for combo next event
-  if (ASC) {
-    ASC->GenericGameplayEventCallbacks
-        .FindOrAdd(
-            FGameplayTag::RequestGameplayTag(FName("Event.Attack.Combo.Next")))
-        .AddUObject(this, &UCombatComboAttackAbility::HandleComboNext);
-
-    // Also listen for combo start event to cache input
-    ASC->GenericGameplayEventCallbacks
-        .FindOrAdd(
-            FGameplayTag::RequestGameplayTag(FName("Event.Attack.Combo.Start")))
-        .AddUObject(this, &UCombatComboAttackAbility::HandleComboStart);
-  }
+  // Listen for combo windows, buffering presses of the start input
+  static const FGameplayTag ComboStartTag =
+      FGameplayTag::RequestGameplayTag(FName("Event.Attack.Combo.Start"));
+  static const FGameplayTag ComboNextTag =
+      FGameplayTag::RequestGameplayTag(FName("Event.Attack.Combo.Next"));
+  UCombatAbilityTask_WaitComboWindow *WindowTask =
+      UCombatAbilityTask_WaitComboWindow::WaitComboWindow(
+          this, ComboStartTag, ComboNextTag, ComboInputCacheTimeTolerance);
+  WindowTask->OnWindowOpened.BindUObject(
+      this, &UCombatComboAttackAbility::HandleComboWindow);
+  WindowTask->ReadyForActivation();
+
+  // Play montage from first section, ending the ability if it can't play
+  MontageTask = UCombatAbilityTask_PlayMontageAndWaitForSection::
+      PlayMontageAndWaitForSection(
+          this, ComboAttackMontage,
+          ComboSectionNames.Num() > 0 ? ComboSectionNames[0] : NAME_None);
+  MontageTask->OnMontageEnded.BindUObject(
+      this, &UCombatComboAttackAbility::OnMontageEnded);
+  MontageTask->ReadyForActivation();
 }
 
 void UCombatComboAttackAbility::OnMontageEnded(UAnimMontage *Montage,
                                                bool bInterrupted) {
-  // Reset stamina used for next attack via GE
-  UAbilitySystemComponent *ASC =
-      GetAbilitySystemComponent(GetCurrentActorInfo());
-  if (ASC) {
-    FGameplayEffectSpecHandle ResetSpecHandle = ASC->MakeOutgoingSpec(
-        UCombatStaminaUsedResetGameplayEffect::StaticClass(), 1.0f,
-        ASC->MakeEffectContext());
-    if (ResetSpecHandle.IsValid()) {
-      ASC->ApplyGameplayEffectSpecToTarget(*ResetSpecHandle.Data.Get(), ASC);
-    }
-  }
-
   // Call the character's attack montage ended function
   if (AActor *Avatar = GetCurrentActorInfo()->AvatarActor.Get()) {
     if (ACombatBase *CombatBase = Cast<ACombatBase>(Avatar)) {
@@ -227,65 +201,39 @@ void UCombatComboAttackAbility::EndAbility(
     const FGameplayAbilityActorInfo *ActorInfo,
     const FGameplayAbilityActivationInfo ActivationInfo,
     bool bReplicateEndAbility, bool bWasCancelled) {
-  bComboStarted = false;
-
-  // Stop montage only if cancelled
+  // Stop montage only if cancelled, the tasks drop their listeners either way
   if (bWasCancelled && ComboAttackMontage) {
     if (UAnimInstance *AnimInstance = ActorInfo->GetAnimInstance()) {
       AnimInstance->Montage_Stop(0.0f, ComboAttackMontage);
     }
   }
 
-  // Remove montage end delegate only if cancelled
-  if (bWasCancelled && ComboAttackMontage) {
-    if (UAnimInstance *AnimInstance = ActorInfo->GetAnimInstance()) {
-      FOnMontageEnded EmptyDelegate;
-      AnimInstance->Montage_SetEndDelegate(EmptyDelegate, ComboAttackMontage);
+  // Reset stamina used for next attack via GE. The montage end no longer
+  // reaches an ability that ended early, so this runs on every end
+  if (UAbilitySystemComponent *ASC = GetAbilitySystemComponent(ActorInfo)) {
+    FGameplayEffectSpecHandle ResetSpecHandle = ASC->MakeOutgoingSpec(
+        UCombatStaminaUsedResetGameplayEffect::StaticClass(), 1.0f,
+        ASC->MakeEffectContext());
+    if (ResetSpecHandle.IsValid()) {
+      ASC->ApplyGameplayEffectSpecToTarget(*ResetSpecHandle.Data.Get(), ASC);
     }
   }
 
-  // Remove event listeners
-  if (UAbilitySystemComponent *ASC = GetAbilitySystemComponent(ActorInfo)) {
-    ASC->GenericGameplayEventCallbacks
-        .FindOrAdd(
-            FGameplayTag::RequestGameplayTag(FName("Event.Attack.Combo.Next")))
-        .RemoveAll(this);
-
-    ASC->GenericGameplayEventCallbacks
-        .FindOrAdd(
-            FGameplayTag::RequestGameplayTag(FName("Event.Attack.Combo.Start")))
-        .RemoveAll(this);
-  }
+  MontageTask = nullptr;
 
   Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility,
                     bWasCancelled);
 }
 
-void UCombatComboAttackAbility::HandleComboNext(
-    const FGameplayEventData *EventData) {
+void UCombatComboAttackAbility::HandleComboWindow(bool bInputBuffered) {
   ACombatBase *CombatBase = GetCombatBaseFromActorInfo();
   UAbilitySystemComponent *ASC =
       GetAbilitySystemComponent(GetCurrentActorInfo());
 
-  bool bShouldContinueCombo = true;
-
-  if (CombatBase) {
-    if (CombatBase->IsPlayerControlled()) {
-      // For player, check if input is not stale
-      float CurrentTime = GetWorld()->GetTimeSeconds();
-      if (CurrentTime - CachedComboInputTime > ComboInputCacheTimeTolerance) {
-        // Input is stale, end combo
-        bShouldContinueCombo = false;
-      } else {
-        // Consume the cached input
-        CachedComboInputTime = 0.0f;
-        bShouldContinueCombo = true;
-      }
-    } else {
-      // For AI, always continue until target combo count
-      bShouldContinueCombo = true;
-    }
-  }
+  // For player, continue on buffered input. For AI, always continue until
+  // target combo count
+  const bool bShouldContinueCombo =
+      !CombatBase || !CombatBase->IsPlayerControlled() || bInputBuffered;
 
   if (bShouldContinueCombo) {
     CurrentComboCount++;
@@ -321,11 +269,7 @@ void UCombatComboAttackAbility::HandleComboNext(
                 UStaminaAttributeSet::GetStaminaUsedAttribute(), StaminaCost);
 
             // Jump to next section
-            if (UAnimInstance *AnimInstance =
-                    GetCurrentActorInfo()->GetAnimInstance()) {
-              AnimInstance->Montage_JumpToSection(
-                  ComboSectionNames[CurrentComboCount], ComboAttackMontage);
-            }
+            MontageTask->JumpToSection(ComboSectionNames[CurrentComboCount]);
           } else {
             // Not enough stamina, for enemies set to 0 to refill, end combo
             if (!CombatBase->IsPlayerControlled()) {
@@ -339,11 +283,7 @@ void UCombatComboAttackAbility::HandleComboNext(
         }
       } else {
         // Jump to next section (no stamina cost)
-        if (UAnimInstance *AnimInstance =
-                GetCurrentActorInfo()->GetAnimInstance()) {
-          AnimInstance->Montage_JumpToSection(
-              ComboSectionNames[CurrentComboCount], ComboAttackMontage);
-        }
+        MontageTask->JumpToSection(ComboSectionNames[CurrentComboCount]);
       }
     } else {
       // No more combos, end ability
@@ -356,13 +296,3 @@ void UCombatComboAttackAbility::HandleComboNext(
                GetCurrentActivationInfo(), false, false);
   }
 }
-
-void UCombatComboAttackAbility::HandleComboStart(
-    const FGameplayEventData *EventData) {
-  if (!bComboStarted) {
-    bComboStarted = true;
-    return;
-  }
-  // Cache input time for combo continuation
-  CachedComboInputTime = GetWorld()->GetTimeSeconds();
-}
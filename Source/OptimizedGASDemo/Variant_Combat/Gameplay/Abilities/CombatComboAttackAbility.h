@@ -8,6 +8,7 @@
 #include "CombatComboAttackAbility.generated.h"
 
 class UAnimMontage;
+class UCombatAbilityTask_PlayMontageAndWaitForSection;
 
 /**
  * Ability for performing combo attacks using GAS
@@ -31,11 +32,8 @@ public:
                           bool bReplicateEndAbility,
                           bool bWasCancelled) override;
 
-  /** Handle combo next event */
-  void HandleComboNext(const FGameplayEventData *EventData);
-
-  /** Handle combo start event for input caching */
-  void HandleComboStart(const FGameplayEventData *EventData);
+  /** Continue or end the combo when a combo window opens */
+  void HandleComboWindow(bool bInputBuffered);
 
   /** Called when montage ends */
   void OnMontageEnded(UAnimMontage *Montage, bool bInterrupted);
@@ -69,12 +67,7 @@ protected:
   /** Combo section names */
   TArray<FName> ComboSectionNames;
 
-  /** Montage ended delegate */
-  FOnMontageEnded MontageEndedDelegate;
-
-  /** Cached combo input time */
-  float CachedComboInputTime = 0.0f;
-
-  /** Whether the combo has started */
-  bool bComboStarted = false;
+  /** Task playing the combo montage */
+  UPROPERTY()
+  TObjectPtr<UCombatAbilityTask_PlayMontageAndWaitForSection> MontageTask;
 };
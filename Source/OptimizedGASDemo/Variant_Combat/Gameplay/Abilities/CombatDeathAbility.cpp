@@ -6,7 +6,7 @@
 #include "GameFramework/Character.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
-#include "TimerManager.h"
+#include "CombatRagdollSubsystem.h"
 
 UCombatDeathAbility::UCombatDeathAbility() {
   InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
@@ -53,15 +53,20 @@ void UCombatDeathAbility::ActivateAbility(
       Character->GetCharacterMovement()->DisableMovement();
       Character->GetCapsuleComponent()->SetCollisionEnabled(
           ECollisionEnabled::NoCollision);
-      // enable full ragdoll physics
-      Character->GetMesh()->SetSimulatePhysics(true);
+      // enable full ragdoll physics, within the ragdoll budget
+      if (UCombatRagdollSubsystem *Ragdolls =
+              GetWorld()->GetSubsystem<UCombatRagdollSubsystem>()) {
+        Ragdolls->StartRagdoll(Character->GetMesh());
+      }
     }
   }
 
   // Start death timer
-  GetWorld()->GetTimerManager().SetTimer(
-      DeathTimer, this, &UCombatDeathAbility::OnDeathTimerExpired,
-      DeathDuration, false);
+  if (UCombatTimerSubsystem *Timers =
+          GetWorld()->GetSubsystem<UCombatTimerSubsystem>()) {
+    Timers->SetTimer(DeathTimer, this,
+                     &UCombatDeathAbility::OnDeathTimerExpired, DeathDuration);
+  }
 }
 
 void UCombatDeathAbility::OnDeathTimerExpired() {
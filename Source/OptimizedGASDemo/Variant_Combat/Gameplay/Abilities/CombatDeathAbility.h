@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "CombatGameplayAbility.h"
+#include "CombatTimerSubsystem.h"
 #include "CombatDeathAbility.generated.h"
 
 class ACombatCharacter;
@@ -35,7 +36,7 @@ protected:
   bool bShouldRespawn = true;
 
   /** Timer for death duration */
-  FTimerHandle DeathTimer;
+  FCombatTimerHandle DeathTimer;
 
   /** Called when death timer expires */
   void OnDeathTimerExpired();
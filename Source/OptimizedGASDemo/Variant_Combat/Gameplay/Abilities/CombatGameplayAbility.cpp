@@ -52,3 +52,12 @@ UAbilitySystemComponent *UCombatGameplayAbility::GetAbilitySystemComponent(
   return UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(
       ActorInfo->OwnerActor.Get());
 }
+
+const FCollisionQueryParams &
+UCombatGameplayAbility::GetAvatarQueryParams() const {
+  if (const ACombatBase *CombatBase = GetCombatBaseFromActorInfo()) {
+    return CombatBase->GetCombatQueryParams();
+  }
+
+  return FCollisionQueryParams::DefaultQueryParam;
+}
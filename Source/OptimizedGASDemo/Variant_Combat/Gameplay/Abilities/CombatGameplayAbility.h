@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Abilities/GameplayAbility.h"
+#include "CollisionQueryParams.h"
 #include "CombatGameplayAbility.generated.h"
 
 /**
@@ -35,6 +36,11 @@ public:
                           bool bWasCancelled) override;
   //~End of UGameplayAbility interface
 
+  /** Triggers that activate this ability, read when routing input */
+  const TArray<FAbilityTriggerData> &GetAbilityTriggers() const {
+    return AbilityTriggers;
+  }
+
 protected:
   /** Called when ability is activated */
   UFUNCTION(BlueprintImplementableEvent, Category = Ability)
@@ -54,4 +60,8 @@ protected:
    */
   UAbilitySystemComponent *
   GetAbilitySystemComponent(const FGameplayAbilityActorInfo *ActorInfo) const;
+
+  /** Query params ignoring the avatar, cached on the combat character.
+   * Other avatars get the default params */
+  const FCollisionQueryParams &GetAvatarQueryParams() const;
 };
@@ -11,6 +11,8 @@
 #include "DrawDebugHelpers.h"
 #include "Net/UnrealNetwork.h"
 #include "CombatEnemy.h"
+#include "CombatCosmetics.h"
+#include "CombatQueryScratch.h"
 
 UCombatLockToggleAbility::UCombatLockToggleAbility() {
   InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
@@ -106,7 +108,8 @@ void UCombatLockToggleAbility::Server_ToggleLockState(
     }
 
     // Use sphere trace to find potential targets within range
-    TArray<FHitResult> HitResults;
+    CombatQueryScratch::FScopedHitBuffer HitBuffer;
+    TArray<FHitResult> &HitResults = HitBuffer.Get();
     FVector StartLocation = Owner->GetActorLocation();
     FVector EndLocation = StartLocation + Owner->GetActorForwardVector() *
                                               LockSystem->GetMaxLockDistance();
@@ -114,14 +117,11 @@ void UCombatLockToggleAbility::Server_ToggleLockState(
     // Sphere trace parameters
     FCollisionShape SphereShape =
         FCollisionShape::MakeSphere(50.0f); // Small sphere for detection
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(Owner); // Ignore self
-    QueryParams.bTraceComplex = false;
 
-    // Perform sphere trace
-    bool bHit = World->SweepMultiByChannel(HitResults, StartLocation,
-                                           EndLocation, FQuat::Identity,
-                                           ECC_Pawn, SphereShape, QueryParams);
+    // Perform sphere trace, ignoring self
+    World->SweepMultiByChannel(HitResults, StartLocation, EndLocation,
+                               FQuat::Identity, ECC_Pawn, SphereShape,
+                               GetAvatarQueryParams());
 
     AActor *BestTarget = nullptr;
     float BestScore = 0.0f; // Lower score is better (distance-based)
@@ -176,13 +176,17 @@ void UCombatLockToggleAbility::Server_ToggleLockState(
     }
 
     // Debug drawing
-    DrawDebugTrace(StartLocation, EndLocation, SphereShape, HitResults,
-                   BestTarget, LockSystem);
+    if (CombatCosmetics::ShouldDrawDebug(GetWorld())) {
+      DrawDebugTrace(StartLocation, EndLocation, SphereShape, HitResults,
+                     BestTarget, LockSystem);
+    }
 
     LockSystem->SetLockedTarget(BestTarget);
 
-    // Spawn decal for visual feedback
-    if (LockSystem->GetLockedTarget() && LockSystem->GetLockDecalMaterial()) {
+    // Spawn decal for visual feedback (remote clients get theirs from
+    // OnRep_LockedTarget, so dedicated servers skip it)
+    if (LockSystem->GetLockedTarget() && LockSystem->GetLockDecalMaterial() &&
+        CombatCosmetics::ShouldRun(GetWorld())) {
       // Calculate decal size based on target's capsule component
       FVector DecalSize = FVector(100.0f, 100.0f, 100.0f);
       if (UCapsuleComponent *Capsule = Cast<UCapsuleComponent>(
@@ -251,6 +255,7 @@ void UCombatLockToggleAbility::DrawDebugTrace(
     const FVector &StartLocation, const FVector &EndLocation,
     const FCollisionShape &SphereShape, const TArray<FHitResult> &HitResults,
     AActor *BestTarget, UCombatLockSystemComponent *LockSystem) {
+#if ENABLE_DRAW_DEBUG
   UWorld *World = GetWorld();
   if (!World)
     return;
@@ -317,4 +322,5 @@ void UCombatLockToggleAbility::DrawDebugTrace(
                       HitActor->GetName(), nullptr, HitColor, 2.0f);
     }
   }
+#endif
 }
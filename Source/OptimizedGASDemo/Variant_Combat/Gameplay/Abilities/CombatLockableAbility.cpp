@@ -3,8 +3,27 @@
 #include "CombatLockableAbility.h"
 #include "AbilitySystemComponent.h"
 
+namespace {
+const FGameplayTag &GetLockableTag() {
+  static const FGameplayTag LockableTag =
+      FGameplayTag::RequestGameplayTag(FName("State.Lockable"));
+  return LockableTag;
+}
+
+/** The ASC of an authoritative avatar, the tag is only granted by the server */
+UAbilitySystemComponent *
+GetAuthorityASC(const FGameplayAbilityActorInfo *ActorInfo) {
+  if (!ActorInfo || !ActorInfo->AvatarActor.IsValid() ||
+      !ActorInfo->AvatarActor->HasAuthority()) {
+    return nullptr;
+  }
+  return ActorInfo->AbilitySystemComponent.Get();
+}
+} // namespace
+
 UCombatLockableAbility::UCombatLockableAbility() {
-  InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+  // never activated, grant and removal run on the CDO
+  InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerExecution;
   NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::ServerOnly;
 
   // Set up ability tags
@@ -13,8 +32,6 @@ UCombatLockableAbility::UCombatLockableAbility() {
       FGameplayTag::RequestGameplayTag(FName("Ability.Type.Passive.lockable")));
   AssetTags.AddTag(FGameplayTag::RequestGameplayTag(FName("State.Lockable")));
   SetAssetTags(AssetTags);
-  ActivationOwnedTags.AddTag(
-      FGameplayTag::RequestGameplayTag(FName("State.Lockable")));
 }
 
 void UCombatLockableAbility::OnGiveAbility(
@@ -22,11 +39,21 @@ void UCombatLockableAbility::OnGiveAbility(
     const FGameplayAbilitySpec &Spec) {
   Super::OnGiveAbility(ActorInfo, Spec);
 
-  // Try to activate the ability immediately upon granting (server-only for
-  // multiplayer safety)
-  if (ActorInfo && GetAbilitySystemComponent(ActorInfo) &&
-      ActorInfo->AvatarActor.Get() &&
-      ActorInfo->AvatarActor.Get()->HasAuthority()) {
-    GetAbilitySystemComponent(ActorInfo)->TryActivateAbility(Spec.Handle);
+  // the tag used to be owned by an always-active instance, a replicated loose
+  // tag gives clients the same view without one
+  if (UAbilitySystemComponent *ASC = GetAuthorityASC(ActorInfo)) {
+    ASC->AddLooseGameplayTag(GetLockableTag());
+    ASC->AddReplicatedLooseGameplayTag(GetLockableTag());
   }
 }
+
+void UCombatLockableAbility::OnRemoveAbility(
+    const FGameplayAbilityActorInfo *ActorInfo,
+    const FGameplayAbilitySpec &Spec) {
+  if (UAbilitySystemComponent *ASC = GetAuthorityASC(ActorInfo)) {
+    ASC->RemoveLooseGameplayTag(GetLockableTag());
+    ASC->RemoveReplicatedLooseGameplayTag(GetLockableTag());
+  }
+
+  Super::OnRemoveAbility(ActorInfo, Spec);
+}
@@ -7,7 +7,9 @@
 #include "CombatLockableAbility.generated.h"
 
 /**
- * Ability that grants the lockable tag to make the enemy lockable
+ * Ability that grants the lockable tag to make the enemy lockable. The tag
+ * is added when the ability is granted and removed with it, the ability is
+ * never activated, so no instance is created per enemy.
  */
 UCLASS()
 class OPTIMIZEDGASDEMO_API UCombatLockableAbility
@@ -19,4 +21,6 @@ public:
 
   virtual void OnGiveAbility(const FGameplayAbilityActorInfo *ActorInfo,
                              const FGameplayAbilitySpec &Spec) override;
+  virtual void OnRemoveAbility(const FGameplayAbilityActorInfo *ActorInfo,
+                               const FGameplayAbilitySpec &Spec) override;
 };
@@ -4,9 +4,23 @@
 #include "AbilitySystemComponent.h"
 #include "CombatCharacter.h"
 #include "GameplayTagsManager.h"
+#include "CombatQueryScratch.h"
+#include "CombatTeams.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Danger Notifications"),
+                           STAT_CombatDangerNotifications, STATGROUP_Combat);
+
+namespace {
+/** Only hostile combatants are warned of incoming attacks */
+FCollisionObjectQueryParams GetDangerObjectParams(const AActor *Attacker) {
+  return CombatTeams::GetHostileHitboxParams(
+      FGenericTeamId::GetTeamIdentifier(Attacker), false);
+}
+} // namespace
 
 UCombatNotifyEnemiesAbility::UCombatNotifyEnemiesAbility() {
-  InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+  InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerExecution;
   NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
 
   // Set ability tags
@@ -57,46 +71,82 @@ void UCombatNotifyEnemiesAbility::ActivateAbility(
     return;
   }
 
-  // Sweep for objects in front of the character to be hit by the attack
-  TArray<FHitResult> OutHits;
-
   // Start at the actor location, sweep forward
   const FVector TraceStart = AvatarActor->GetActorLocation();
   const FVector TraceEnd =
       TraceStart + (AvatarActor->GetActorForwardVector() * DangerTraceDistance);
 
-  // Check for pawn object types only
-  FCollisionObjectQueryParams ObjectParams;
-  ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
-
   // Use a sphere shape for the sweep
   FCollisionShape CollisionShape;
   CollisionShape.SetSphere(DangerTraceRadius);
 
-  // Ignore self
-  FCollisionQueryParams QueryParams;
-  QueryParams.AddIgnoredActor(AvatarActor);
-
-  if (GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd,
-                                         FQuat::Identity, ObjectParams,
-                                         CollisionShape, QueryParams)) {
-    // Iterate over each object hit
-    for (const FHitResult &CurrentHit : OutHits) {
-      // Check if we've hit a damageable actor
-      ICombatDamageable *Damageable =
-          Cast<ICombatDamageable>(CurrentHit.GetActor());
-
-      if (Damageable) {
-        // Notify the enemy
-        Damageable->NotifyDanger(TraceStart, AvatarActor);
-      }
+  if (CombatAsyncTraces::IsEnabled()) {
+    // the warning only feeds AI reactions, so it can arrive a frame late
+    INC_DWORD_STAT(STAT_CombatAsyncTraces);
+
+    // the instance is gone by the time the trace completes
+    FTraceDelegate OnTraceDone = FTraceDelegate::CreateStatic(
+        &UCombatNotifyEnemiesAbility::OnAsyncDangerTrace,
+        TWeakObjectPtr<AActor>(AvatarActor));
+    GetWorld()->AsyncSweepByObjectType(
+        EAsyncTraceType::Multi, TraceStart, TraceEnd, FQuat::Identity,
+        GetDangerObjectParams(AvatarActor), CollisionShape,
+        GetAvatarQueryParams(), &OnTraceDone);
+  } else {
+    // Sweep for objects in front of the character to be hit by the attack
+    CombatQueryScratch::FScopedHitBuffer HitBuffer;
+    TArray<FHitResult> &OutHits = HitBuffer.Get();
+    {
+      SCOPE_CYCLE_COUNTER(STAT_CombatDeferrableTraces);
+
+      // Check for hostile hitboxes only, ignoring self
+      GetWorld()->SweepMultiByObjectType(
+          OutHits, TraceStart, TraceEnd, FQuat::Identity,
+          GetDangerObjectParams(AvatarActor), CollisionShape,
+          GetAvatarQueryParams());
     }
+
+    NotifyHitActors(OutHits, TraceStart, AvatarActor);
   }
 
   // End ability immediately after performing trace
   EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
 }
 
+void UCombatNotifyEnemiesAbility::OnAsyncDangerTrace(
+    const FTraceHandle &Handle, FTraceDatum &Datum,
+    TWeakObjectPtr<AActor> Avatar) {
+  NotifyHitActors(Datum.OutHits, Datum.Start, Avatar.Get());
+}
+
+void UCombatNotifyEnemiesAbility::NotifyHitActors(
+    const TArray<FHitResult> &Hits, const FVector &DangerLocation,
+    AActor *AvatarActor) {
+  if (!AvatarActor) {
+    return;
+  }
+
+  // Each hitbox is a separate hit, so notify every actor only once
+  FMemMark Mark(FMemStack::Get());
+  CombatQueryScratch::FActorArray NotifiedActors;
+  NotifiedActors.Reserve(Hits.Num());
+  for (const FHitResult &CurrentHit : Hits) {
+    AActor *HitActor = CurrentHit.GetActor();
+    if (!HitActor || NotifiedActors.Contains(HitActor)) {
+      continue;
+    }
+    NotifiedActors.Add(HitActor);
+
+    // Check if we've hit a damageable actor
+    if (ICombatDamageable *Damageable = Cast<ICombatDamageable>(HitActor)) {
+      INC_DWORD_STAT(STAT_CombatDangerNotifications);
+
+      // Notify the enemy
+      Damageable->NotifyDanger(DangerLocation, AvatarActor);
+    }
+  }
+}
+
 ACombatCharacter *
 UCombatNotifyEnemiesAbility::GetCombatCharacterFromActorInfo() const {
   return Cast<ACombatCharacter>(GetAvatarActorFromActorInfo());
@@ -4,12 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "Abilities/CombatGameplayAbility.h"
+#include "WorldCollision.h"
 #include "CombatNotifyEnemiesAbility.generated.h"
 
 class ACombatCharacter;
 
 /**
- * Ability to notify enemies of incoming attack by performing a trace sweep
+ * Ability to notify enemies of incoming attack by performing a trace sweep.
+ * Instanced per execution, it ends in the activation that started it and
+ * its async trace result only needs the avatar.
  */
 UCLASS()
 class UCombatNotifyEnemiesAbility : public UCombatGameplayAbility {
@@ -26,4 +29,14 @@ public:
 
   /** Returns the CombatCharacter that owns this ability */
   class ACombatCharacter *GetCombatCharacterFromActorInfo() const;
+
+protected:
+  /** Warns the actors found by a danger trace that ran asynchronously */
+  static void OnAsyncDangerTrace(const FTraceHandle &Handle,
+                                 FTraceDatum &Datum,
+                                 TWeakObjectPtr<AActor> Avatar);
+
+  /** Warns every damageable actor in the hits of an incoming attack */
+  static void NotifyHitActors(const TArray<FHitResult> &Hits,
+                              const FVector &DangerLocation, AActor *Avatar);
 };
@@ -0,0 +1,96 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatRangedAttackAbility.h"
+#include "AbilitySystemComponent.h"
+#include "Attributes/DamageAttributeSet.h"
+#include "CombatBase.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+
+UCombatRangedAttackAbility::UCombatRangedAttackAbility() {
+  InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+  NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::ServerOnly;
+
+  // Set ability tags
+  FGameplayTagContainer AssetTags;
+  AssetTags.AddTag(
+      FGameplayTag::RequestGameplayTag(FName("Ability.Type.Attack.Ranged")));
+  SetAssetTags(AssetTags);
+
+  // Add state tag while active
+  ActivationOwnedTags.AddTag(
+      FGameplayTag::RequestGameplayTag(FName("State.Attacking")));
+
+  // Cancel this ability if death occurs
+  CancelAbilitiesWithTag.AddTag(
+      FGameplayTag::RequestGameplayTag(FName("Ability.Type.Death")));
+
+  // Add trigger to activate on ranged attack event
+  FAbilityTriggerData TriggerData;
+  TriggerData.TriggerTag =
+      FGameplayTag::RequestGameplayTag(FName("Event.Attack.Ranged"));
+  TriggerData.TriggerSource = EGameplayAbilityTriggerSource::GameplayEvent;
+  AbilityTriggers.Add(TriggerData);
+}
+
+void UCombatRangedAttackAbility::ActivateAbility(
+    const FGameplayAbilitySpecHandle Handle,
+    const FGameplayAbilityActorInfo *ActorInfo,
+    const FGameplayAbilityActivationInfo ActivationInfo,
+    const FGameplayEventData *TriggerEventData) {
+  Super::ActivateAbility(Handle, ActorInfo, ActivationInfo, TriggerEventData);
+
+  if (!CommitAbility(Handle, ActorInfo, ActivationInfo)) {
+    EndAbility(Handle, ActorInfo, ActivationInfo, true, false);
+    return;
+  }
+
+  FireProjectiles();
+
+  // the projectiles fly on their own, nothing to wait for
+  EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
+}
+
+void UCombatRangedAttackAbility::FireProjectiles() {
+  AActor *AvatarActor = GetAvatarActorFromActorInfo();
+  UCombatProjectileSubsystem *Projectiles =
+      GetWorld()->GetSubsystem<UCombatProjectileSubsystem>();
+  if (!AvatarActor || !Projectiles) {
+    return;
+  }
+
+  // Add the damage attribute on top of the projectile damage
+  FCombatProjectileParams Params = Projectile;
+  if (UAbilitySystemComponent *ASC =
+          GetAbilitySystemComponent(CurrentActorInfo)) {
+    Params.Damage +=
+        ASC->GetNumericAttribute(UDamageAttributeSet::GetDamageAttribute());
+  }
+
+  FVector Muzzle = AvatarActor->GetActorLocation();
+  if (const ACharacter *Character = Cast<ACharacter>(AvatarActor)) {
+    if (Character->GetMesh() &&
+        Character->GetMesh()->DoesSocketExist(MuzzleSocket)) {
+      Muzzle = Character->GetMesh()->GetSocketLocation(MuzzleSocket);
+    }
+  }
+
+  // spread the projectiles evenly across the fan
+  const FVector Forward = AvatarActor->GetActorForwardVector();
+  const float Step =
+      ProjectileCount > 1 ? SpreadAngle / (ProjectileCount - 1) : 0.0f;
+  const float FirstYaw = ProjectileCount > 1 ? -SpreadAngle * 0.5f : 0.0f;
+  TArray<FVector_NetQuantizeNormal> Directions;
+  Directions.Reserve(ProjectileCount);
+  for (int32 Index = 0; Index < ProjectileCount; ++Index) {
+    const FVector Direction =
+        Forward.RotateAngleAxis(FirstYaw + Step * Index, FVector::UpVector);
+    Projectiles->FireProjectile(Muzzle, Direction, Params, AvatarActor);
+    Directions.Add(Direction);
+  }
+
+  // hits are only simulated here, clients replay the launch to draw them
+  if (ACombatBase *CombatBase = Cast<ACombatBase>(AvatarActor)) {
+    CombatBase->MulticastFireProjectiles(Muzzle, Directions, Params);
+  }
+}
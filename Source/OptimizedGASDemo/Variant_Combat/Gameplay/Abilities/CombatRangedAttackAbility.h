@@ -0,0 +1,47 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatGameplayAbility.h"
+#include "CombatProjectileSubsystem.h"
+#include "CombatRangedAttackAbility.generated.h"
+
+/**
+ * GameplayAbility for ranged attacks. Projectiles are handed to the
+ * projectile subsystem instead of being spawned as actors
+ */
+UCLASS()
+class UCombatRangedAttackAbility : public UCombatGameplayAbility {
+  GENERATED_BODY()
+
+public:
+  UCombatRangedAttackAbility();
+
+  virtual void
+  ActivateAbility(const FGameplayAbilitySpecHandle Handle,
+                  const FGameplayAbilityActorInfo *ActorInfo,
+                  const FGameplayAbilityActivationInfo ActivationInfo,
+                  const FGameplayEventData *TriggerEventData) override;
+
+protected:
+  /** Launch parameters of each projectile */
+  UPROPERTY(EditDefaultsOnly, Category = "Projectile")
+  FCombatProjectileParams Projectile;
+
+  /** Number of projectiles fired per attack */
+  UPROPERTY(EditDefaultsOnly, Category = "Projectile", meta = (ClampMin = 1))
+  int32 ProjectileCount = 1;
+
+  /** Total yaw spread of the projectiles */
+  UPROPERTY(EditDefaultsOnly, Category = "Projectile",
+            meta = (ClampMin = 0, ClampMax = 360, Units = "deg"))
+  float SpreadAngle = 0.0f;
+
+  /** Socket the projectiles are fired from, the actor location if missing */
+  UPROPERTY(EditDefaultsOnly, Category = "Projectile")
+  FName MuzzleSocket = FName("hand_r");
+
+  /** Fire the projectiles in a fan around the avatar's forward vector */
+  void FireProjectiles();
+};
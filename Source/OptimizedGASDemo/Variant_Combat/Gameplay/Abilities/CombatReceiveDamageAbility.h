@@ -8,7 +8,9 @@
 #include "CombatReceiveDamageAbility.generated.h"
 
 /**
- * GameplayAbility for receiving damage
+ * GameplayAbility for damage camera shakes. Damage itself is applied by the
+ * health attribute set and the hit reaction is multicast by ACombatBase, this
+ * only runs locally where the reaction can be seen
  */
 UCLASS()
 class UCombatReceiveDamageAbility : public UCombatGameplayAbility {
@@ -24,10 +26,6 @@ public:
                   const FGameplayEventData *TriggerEventData) override;
 
 protected:
-  /** Damage gameplay effect to apply */
-  UPROPERTY(EditDefaultsOnly, Category = "Damage")
-  TSubclassOf<UGameplayEffect> DamageGameplayEffect;
-
   /** Camera shake for damage */
   UPROPERTY(EditDefaultsOnly, Category = "Damage")
   TSubclassOf<UCameraShakeBase> DamageCameraShake;
@@ -35,8 +33,4 @@ protected:
   /** Camera shake for death */
   UPROPERTY(EditDefaultsOnly, Category = "Damage")
   TSubclassOf<UCameraShakeBase> DeathCameraShake;
-
-  /** Apply damage effects */
-  void ApplyDamageEffects(float Damage, const FVector &ImpactPoint,
-                          const FVector &DamageDirection);
 };
@@ -89,8 +89,9 @@ void UCombatStaminaRegenerationAbility::EndAbility(
   }
 
   // Clear timers
-  if (RefillTimerHandle.IsValid()) {
-    GetWorld()->GetTimerManager().ClearTimer(RefillTimerHandle);
+  if (UCombatTimerSubsystem *Timers =
+          GetWorld()->GetSubsystem<UCombatTimerSubsystem>()) {
+    Timers->ClearTimer(RefillTimerHandle);
   }
 
   Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility,
@@ -111,10 +112,12 @@ void UCombatStaminaRegenerationAbility::OnDepleted() {
   }
 
   // Start refill timer for enemies
-  GetWorld()->GetTimerManager().SetTimer(
-      RefillTimerHandle, this,
-      &UCombatStaminaRegenerationAbility::RefillStamina, EnemyRefillDelay,
-      false);
+  if (UCombatTimerSubsystem *Timers =
+          GetWorld()->GetSubsystem<UCombatTimerSubsystem>()) {
+    Timers->SetTimer(RefillTimerHandle, this,
+                     &UCombatStaminaRegenerationAbility::RefillStamina,
+                     EnemyRefillDelay);
+  }
 }
 
 void UCombatStaminaRegenerationAbility::OnRestored() {
@@ -126,8 +129,9 @@ void UCombatStaminaRegenerationAbility::OnRestored() {
   }
 
   // Clear timer if stamina was restored before timer
-  if (RefillTimerHandle.IsValid()) {
-    GetWorld()->GetTimerManager().ClearTimer(RefillTimerHandle);
+  if (UCombatTimerSubsystem *Timers =
+          GetWorld()->GetSubsystem<UCombatTimerSubsystem>()) {
+    Timers->ClearTimer(RefillTimerHandle);
   }
 }
 
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Abilities/CombatGameplayAbility.h"
 #include "AbilitySystemComponent.h"
+#include "CombatTimerSubsystem.h"
 #include "CombatStaminaRegenerationAbility.generated.h"
 
 class UCombatStaminaRegenerationGameplayEffect;
@@ -76,7 +77,7 @@ protected:
   float EnemyRefillDelay = 10.0f;
 
   /** Timer handle for enemy refill */
-  FTimerHandle RefillTimerHandle;
+  FCombatTimerHandle RefillTimerHandle;
 
   /** Stun effect class */
   UPROPERTY(EditDefaultsOnly, Category = "Stamina Regeneration")
@@ -11,9 +11,39 @@
 #include "Attributes/DamageAttributeSet.h"
 #include "Gameplay/Attributes/StaminaAttributeSet.h"
 #include "Data/CombatAttackEventData.h"
+#include "CombatCosmetics.h"
+#include "CombatQueryScratch.h"
+#include "CombatTeams.h"
+#include "Hitbox/CombatHitboxComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Trace Hits"),
+                           STAT_CombatAttackTraceHits, STATGROUP_Combat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Hit Dispatches"),
+                           STAT_CombatAttackDispatches, STATGROUP_Combat);
+
+namespace {
+TAutoConsoleVariable<bool> CVarHitboxTraces(
+    TEXT("Combat.HitboxTraces"), true,
+    TEXT("Melee traces query only hostile and teamless hitboxes. When off, ")
+        TEXT("they query pawn capsules and every dynamic object"));
+
+/** Pre-hitbox query, kept for comparison */
+const FCollisionObjectQueryParams LegacyObjectParams(
+    ECC_TO_BITFIELD(ECC_Pawn) | ECC_TO_BITFIELD(ECC_WorldDynamic));
+
+/** Attacks hit the hitboxes of other teams and of props */
+FCollisionObjectQueryParams GetAttackObjectParams(const AActor *Attacker) {
+  return CVarHitboxTraces.GetValueOnGameThread()
+             ? CombatTeams::GetHostileHitboxParams(
+                   FGenericTeamId::GetTeamIdentifier(Attacker), true)
+             : LegacyObjectParams;
+}
+} // namespace
 
 UCombatTraceAttackAbility::UCombatTraceAttackAbility() {
-  InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerActor;
+  InstancingPolicy = EGameplayAbilityInstancingPolicy::InstancedPerExecution;
   NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalPredicted;
 
   // Set ability tags
@@ -36,6 +66,9 @@ UCombatTraceAttackAbility::UCombatTraceAttackAbility() {
       FGameplayTag::RequestGameplayTag(FName("Event.Trace.Attack"));
   TriggerData.TriggerSource = EGameplayAbilityTriggerSource::GameplayEvent;
   AbilityTriggers.Add(TriggerData);
+
+  // Set default damage gameplay effect
+  DamageGameplayEffect = UCombatDamageGameplayEffect::StaticClass();
 }
 
 void UCombatTraceAttackAbility::ActivateAbility(
@@ -50,17 +83,23 @@ void UCombatTraceAttackAbility::ActivateAbility(
     return;
   }
 
-  // Store trigger event data for use in PerformAttackTrace
-  CachedTriggerEventData = TriggerEventData;
+  // Get damage source bone from event data if available
+  FName DamageSourceBone = FName("hand_r"); // default
+  if (TriggerEventData && TriggerEventData->OptionalObject) {
+    if (const UCombatAttackEventData *AttackData =
+            Cast<UCombatAttackEventData>(TriggerEventData->OptionalObject)) {
+      DamageSourceBone = AttackData->DamageSourceBone;
+    }
+  }
 
   // Perform attack trace immediately
-  PerformAttackTrace();
+  PerformAttackTrace(DamageSourceBone);
 
   // End ability immediately after performing trace
   EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
 }
 
-void UCombatTraceAttackAbility::PerformAttackTrace() {
+void UCombatTraceAttackAbility::PerformAttackTrace(FName DamageSourceBone) {
   if (!CurrentActorInfo->AvatarActor.IsValid()) {
     return;
   }
@@ -89,22 +128,10 @@ void UCombatTraceAttackAbility::PerformAttackTrace() {
   float TraceDistanceValue = TraceDistance;
   float TraceRadiusValue = TraceRadius;
 
-  // Sweep for objects in front of the character to be hit by the attack
-  TArray<FHitResult> OutHits;
-
   // Start at the actor location, sweep forward (use socket location if
   // available)
   FVector TraceStart = AvatarActor->GetActorLocation();
 
-  // Get damage source bone from event data if available
-  FName DamageSourceBone = FName("hand_r"); // default
-  if (CachedTriggerEventData && CachedTriggerEventData->OptionalObject) {
-    if (const UCombatAttackEventData *AttackData = Cast<UCombatAttackEventData>(
-            CachedTriggerEventData->OptionalObject)) {
-      DamageSourceBone = AttackData->DamageSourceBone;
-    }
-  }
-
   // Get stamina used from GAS attribute for damage scaling
   float StaminaUsed = 0.0f;
   if (ASC) {
@@ -129,64 +156,164 @@ void UCombatTraceAttackAbility::PerformAttackTrace() {
   const FVector TraceEnd =
       TraceStart + (AvatarActor->GetActorForwardVector() * TraceDistanceValue);
 
-  // Check for pawn and world dynamic collision object types
-  FCollisionObjectQueryParams ObjectParams;
-  ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
-  ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
-
   // Use a sphere shape for the sweep
   FCollisionShape CollisionShape;
   CollisionShape.SetSphere(TraceRadiusValue);
 
-  // Ignore self
-  FCollisionQueryParams QueryParams;
-  QueryParams.AddIgnoredActor(AvatarActor);
+#if ENABLE_DRAW_DEBUG
+  // Draw debug trace visualization
+  if (CombatCosmetics::ShouldDrawDebug(GetWorld())) {
+    DrawDebugLine(GetWorld(), TraceStart, TraceEnd, FColor::Green, false, 2.0f,
+                  0, 2.0f);
+    DrawDebugSphere(GetWorld(), TraceStart, TraceRadiusValue, 12, FColor::Blue,
+                    false, 2.0f);
+    DrawDebugSphere(GetWorld(), TraceEnd, TraceRadiusValue, 12, FColor::Blue,
+                    false, 2.0f);
+  }
+#endif
+
+  FAttackHitContext Context;
+  Context.Avatar = AvatarActor;
+  Context.SourceASC = ASC;
+  Context.DamageEffect = DamageGameplayEffect;
+  Context.Damage = Damage;
+  Context.Knockback = KnockbackValue;
+  Context.Launch = LaunchValue;
+
+  // AI attacks can land a frame late, player attacks stay synchronous so
+  // prediction and hit feedback match the animation
+  const APawn *AvatarPawn = Cast<APawn>(AvatarActor);
+  if (CombatAsyncTraces::IsEnabled() && AvatarPawn &&
+      !AvatarPawn->IsPlayerControlled()) {
+    INC_DWORD_STAT(STAT_CombatAsyncTraces);
+
+    // the instance is gone by the time the trace completes
+    FTraceDelegate OnTraceDone = FTraceDelegate::CreateStatic(
+        &UCombatTraceAttackAbility::OnAsyncAttackTrace, Context);
+    GetWorld()->AsyncSweepByObjectType(
+        EAsyncTraceType::Multi, TraceStart, TraceEnd, FQuat::Identity,
+        GetAttackObjectParams(AvatarActor), CollisionShape,
+        GetAvatarQueryParams(), &OnTraceDone);
+    return;
+  }
+
+  // Sweep for objects in front of the character to be hit by the attack
+  CombatQueryScratch::FScopedHitBuffer HitBuffer;
+  TArray<FHitResult> &OutHits = HitBuffer.Get();
+  {
+    SCOPE_CYCLE_COUNTER(STAT_CombatDeferrableTraces);
+
+    // Check for hostile and prop hitboxes, ignoring self
+    GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd,
+                                       FQuat::Identity,
+                                       GetAttackObjectParams(AvatarActor),
+                                       CollisionShape, GetAvatarQueryParams());
+  }
 
-  bool bHit = GetWorld()->SweepMultiByObjectType(OutHits, TraceStart, TraceEnd,
-                                                 FQuat::Identity, ObjectParams,
-                                                 CollisionShape, QueryParams);
+  // Damage is only applied by the server, predicting clients just trace for
+  // danger notifications and hit effects
+  ProcessAttackHits(OutHits, Context, HasAuthority(&CurrentActivationInfo));
+}
 
-  // Draw debug trace visualization
-  DrawDebugLine(GetWorld(), TraceStart, TraceEnd, FColor::Green, false, 2.0f, 0,
-                2.0f);
-  DrawDebugSphere(GetWorld(), TraceStart, TraceRadiusValue, 12, FColor::Blue,
-                  false, 2.0f);
-  DrawDebugSphere(GetWorld(), TraceEnd, TraceRadiusValue, 12, FColor::Blue,
-                  false, 2.0f);
-
-  // Process all unique hit actors (each actor only once)
-  TSet<AActor *> ProcessedActors;
-  for (const FHitResult &HitResult : OutHits) {
+void UCombatTraceAttackAbility::OnAsyncAttackTrace(const FTraceHandle &Handle,
+                                                   FTraceDatum &Datum,
+                                                   FAttackHitContext Context) {
+  // AI avatars only run their abilities on the server
+  if (const AActor *AvatarActor = Context.Avatar.Get()) {
+    ProcessAttackHits(Datum.OutHits, Context, AvatarActor->HasAuthority());
+  }
+}
+
+void UCombatTraceAttackAbility::ProcessAttackHits(
+    const TArray<FHitResult> &Hits, const FAttackHitContext &Context,
+    bool bApplyDamage) {
+  AActor *AvatarActor = Context.Avatar.Get();
+  if (!AvatarActor) {
+    return;
+  }
+
+  UWorld *World = AvatarActor->GetWorld();
+  ACombatCharacter *CombatCharacter = Cast<ACombatCharacter>(AvatarActor);
+
+#if ENABLE_DRAW_DEBUG
+  const bool bDrawDebug = CombatCosmetics::ShouldDrawDebug(World);
+#endif
+
+  INC_DWORD_STAT_BY(STAT_CombatAttackTraceHits, Hits.Num());
+
+  // Process all unique hit actors (each actor only once). The list lives on
+  // the scratch stack and is sized up front, so it never grows mid-loop
+  FMemMark Mark(FMemStack::Get());
+  CombatQueryScratch::FActorArray ProcessedActors;
+  ProcessedActors.Reserve(Hits.Num());
+  for (const FHitResult &HitResult : Hits) {
     AActor *HitActor = HitResult.GetActor();
     if (HitActor && !ProcessedActors.Contains(HitActor)) {
       ProcessedActors.Add(HitActor);
 
+#if ENABLE_DRAW_DEBUG
       // Draw Debug Hit
-      DrawDebugSphere(GetWorld(), HitResult.ImpactPoint, 10.0f, 12, FColor::Red,
-                      false, 2.0f);
+      if (bDrawDebug) {
+        DrawDebugSphere(World, HitResult.ImpactPoint, 10.0f, 12,
+                        FColor::Red, false, 2.0f);
+      }
+#endif
 
       ICombatDamageable *Damageable = Cast<ICombatDamageable>(HitActor);
       if (Damageable) {
+        INC_DWORD_STAT(STAT_CombatAttackDispatches);
+
         // Notify danger to the hit actor
         Damageable->NotifyDanger(HitResult.ImpactPoint, AvatarActor);
 
-        // knock upwards and away from the impact normal
-        const FVector Impulse = (HitResult.ImpactNormal * -KnockbackValue) +
-                                (FVector::UpVector * LaunchValue);
-        Damageable->ApplyDamage(Damage, AvatarActor, HitResult.ImpactPoint,
-                                Impulse);
+        if (bApplyDamage) {
+          // hits are sorted along the sweep, so the first hitbox is the bone
+          // the attack reached first. Its multiplier scales the damage
+          float HitDamage = Context.Damage;
+          if (const UCombatHitboxComponent *Hitbox =
+                  HitActor->FindComponentByClass<UCombatHitboxComponent>()) {
+            HitDamage *= Hitbox->GetDamageMultiplier(HitResult.GetComponent());
+          }
+
+          ApplyDamageToTarget(Context, HitActor, Damageable, HitResult,
+                              HitDamage);
+        }
       }
 
       // Call DealtDamage for visual effects on attacker
-      ACombatCharacter *CombatCharacter = GetCombatCharacterFromActorInfo();
       if (CombatCharacter) {
-        CombatCharacter->DealtDamage(Damage, HitResult.ImpactPoint);
+        CombatCharacter->DealtDamage(Context.Damage, HitResult.ImpactPoint);
       }
     }
   }
 }
 
-ACombatCharacter *
-UCombatTraceAttackAbility::GetCombatCharacterFromActorInfo() const {
-  return Cast<ACombatCharacter>(GetAvatarActorFromActorInfo());
+void UCombatTraceAttackAbility::ApplyDamageToTarget(
+    const FAttackHitContext &Context, AActor *HitActor,
+    ICombatDamageable *Damageable, const FHitResult &HitResult, float Damage) {
+  AActor *AvatarActor = Context.Avatar.Get();
+  const float Knockback = Context.Knockback;
+  const float Launch = Context.Launch;
+
+  // Targets with an ability system receive the damage spec directly, their
+  // health set processes it without activating an ability
+  UAbilitySystemComponent *SourceASC = Context.SourceASC.Get();
+  UAbilitySystemComponent *TargetASC =
+      UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(HitActor);
+  if (SourceASC && TargetASC) {
+    FGameplayEffectSpecHandle SpecHandle =
+        UCombatDamageGameplayEffect::MakeDamageSpec(
+            SourceASC, Context.DamageEffect, Damage, HitResult, Knockback,
+            Launch, AvatarActor, AvatarActor);
+    if (SpecHandle.IsValid()) {
+      SourceASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(),
+                                                 TargetASC);
+    }
+    return;
+  }
+
+  // knock upwards and away from the impact normal
+  const FVector Impulse =
+      (HitResult.ImpactNormal * -Knockback) + (FVector::UpVector * Launch);
+  Damageable->ApplyDamage(Damage, AvatarActor, HitResult.ImpactPoint, Impulse);
 }
@@ -4,12 +4,18 @@
 
 #include "CoreMinimal.h"
 #include "CombatGameplayAbility.h"
+#include "WorldCollision.h"
 #include "CombatTraceAttackAbility.generated.h"
 
 class ACombatCharacter;
+class ICombatDamageable;
+class UGameplayEffect;
 
 /**
- * GameplayAbility for performing attack traces
+ * GameplayAbility for performing attack traces. Instanced per execution:
+ * the trace runs and the ability ends in the same activation, so enemies
+ * keep no idle instance of it, and hits are processed from a payload that
+ * outlives the instance.
  */
 UCLASS()
 class UCombatTraceAttackAbility : public UCombatGameplayAbility {
@@ -45,16 +51,40 @@ protected:
   UPROPERTY(EditDefaultsOnly, Category = "Attack", meta = (ClampMin = 0))
   float TraceRadius = 75.0f;
 
+  /** Damage gameplay effect applied to hit targets that have an ASC */
+  UPROPERTY(EditDefaultsOnly, Category = "Attack")
+  TSubclassOf<UGameplayEffect> DamageGameplayEffect;
+
   /** Multiplier for stamina used to damage scaling */
   UPROPERTY(EditDefaultsOnly, Category = "Attack", meta = (ClampMin = 0))
   float StaminaDamageMultiplier = 1.5f;
 
-  /** Cached trigger event data */
-  const FGameplayEventData *CachedTriggerEventData = nullptr;
+  /** What the hits of one attack need once the ability has ended */
+  struct FAttackHitContext {
+    TWeakObjectPtr<AActor> Avatar;
+    TWeakObjectPtr<UAbilitySystemComponent> SourceASC;
+    TSubclassOf<UGameplayEffect> DamageEffect;
+    float Damage = 0.0f;
+    float Knockback = 0.0f;
+    float Launch = 0.0f;
+  };
+
+  /** Perform the attack trace from the damage source bone */
+  void PerformAttackTrace(FName DamageSourceBone);
+
+  /** Processes the hits of an AI attack trace that ran asynchronously */
+  static void OnAsyncAttackTrace(const FTraceHandle &Handle,
+                                 FTraceDatum &Datum,
+                                 FAttackHitContext Context);
 
-  /** Perform the attack trace */
-  void PerformAttackTrace();
+  /** Notifies and damages each actor hit by an attack trace once */
+  static void ProcessAttackHits(const TArray<FHitResult> &Hits,
+                                const FAttackHitContext &Context,
+                                bool bApplyDamage);
 
-  /** Returns the CombatCharacter that owns this ability */
-  class ACombatCharacter *GetCombatCharacterFromActorInfo() const;
+  /** Apply damage and knockback to a single hit target (server only) */
+  static void ApplyDamageToTarget(const FAttackHitContext &Context,
+                                  AActor *HitActor,
+                                  ICombatDamageable *Damageable,
+                                  const FHitResult &HitResult, float Damage);
 };
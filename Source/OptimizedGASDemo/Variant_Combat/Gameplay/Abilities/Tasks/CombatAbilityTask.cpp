@@ -0,0 +1,29 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatAbilityTask.h"
+#include "AbilitySystemComponent.h"
+
+void UCombatAbilityTask::ListenForEvent(
+    const FGameplayTag &Tag,
+    FGameplayEventMulticastDelegate::FDelegate &&Listener) {
+  if (UAbilitySystemComponent *ASC = AbilitySystemComponent.Get()) {
+    EventListeners.Emplace(
+        Tag, ASC->GenericGameplayEventCallbacks.FindOrAdd(Tag).Add(
+                 MoveTemp(Listener)));
+  }
+}
+
+void UCombatAbilityTask::OnDestroy(bool bInOwnerFinished) {
+  if (UAbilitySystemComponent *ASC = AbilitySystemComponent.Get()) {
+    for (const TPair<FGameplayTag, FDelegateHandle> &Listener :
+         EventListeners) {
+      if (FGameplayEventMulticastDelegate *Callbacks =
+              ASC->GenericGameplayEventCallbacks.Find(Listener.Key)) {
+        Callbacks->Remove(Listener.Value);
+      }
+    }
+  }
+  EventListeners.Reset();
+
+  Super::OnDestroy(bInOwnerFinished);
+}
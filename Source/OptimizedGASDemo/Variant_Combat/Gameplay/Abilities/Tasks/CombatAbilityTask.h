@@ -0,0 +1,33 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/Tasks/AbilityTask.h"
+#include "Abilities/GameplayAbilityTypes.h"
+#include "CombatAbilityTask.generated.h"
+
+/**
+ * Base ability task for the combat abilities. Gameplay event listeners are
+ * registered on the ASC's callback map by handle and removed when the task
+ * ends, however the ability ends. Map entries stay in place, so later
+ * activations reuse them instead of adding and removing them again.
+ */
+UCLASS(Abstract)
+class UCombatAbilityTask : public UAbilityTask {
+  GENERATED_BODY()
+
+protected:
+  /** Call the listener whenever the ASC handles an event with the tag */
+  void ListenForEvent(const FGameplayTag &Tag,
+                      FGameplayEventMulticastDelegate::FDelegate &&Listener);
+
+  // ~begin UGameplayTask interface
+  virtual void OnDestroy(bool bInOwnerFinished) override;
+  // ~end UGameplayTask interface
+
+private:
+  /** Listeners registered by this task */
+  TArray<TPair<FGameplayTag, FDelegateHandle>, TInlineAllocator<2>>
+      EventListeners;
+};
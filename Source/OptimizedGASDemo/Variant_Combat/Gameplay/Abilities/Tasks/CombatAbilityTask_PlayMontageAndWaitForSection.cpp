@@ -0,0 +1,80 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatAbilityTask_PlayMontageAndWaitForSection.h"
+#include "Abilities/GameplayAbility.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+
+UCombatAbilityTask_PlayMontageAndWaitForSection *
+UCombatAbilityTask_PlayMontageAndWaitForSection::PlayMontageAndWaitForSection(
+    UGameplayAbility *OwningAbility, UAnimMontage *Montage, FName StartSection,
+    float Rate) {
+  UCombatAbilityTask_PlayMontageAndWaitForSection *Task =
+      NewAbilityTask<UCombatAbilityTask_PlayMontageAndWaitForSection>(
+          OwningAbility);
+  Task->Montage = Montage;
+  Task->StartSection = StartSection;
+  Task->Rate = Rate;
+  return Task;
+}
+
+void UCombatAbilityTask_PlayMontageAndWaitForSection::Activate() {
+  UAnimInstance *AnimInstance = GetAnimInstance();
+  if (Montage && AnimInstance &&
+      AnimInstance->Montage_Play(Montage, Rate) > 0.0f) {
+    if (StartSection != NAME_None) {
+      AnimInstance->Montage_JumpToSection(StartSection, Montage);
+    }
+
+    if (FAnimMontageInstance *Instance =
+            AnimInstance->GetActiveInstanceForMontage(Montage)) {
+      MontageInstanceID = Instance->GetInstanceID();
+      Instance->OnMontageEnded.BindUObject(
+          this,
+          &UCombatAbilityTask_PlayMontageAndWaitForSection::HandleMontageEnded);
+      return;
+    }
+  }
+
+  // nothing to wait for, let the ability end instead of hanging
+  if (ShouldBroadcastAbilityTaskDelegates()) {
+    OnMontageEnded.ExecuteIfBound(Montage, true);
+  }
+}
+
+void UCombatAbilityTask_PlayMontageAndWaitForSection::JumpToSection(
+    FName Section) {
+  if (UAnimInstance *AnimInstance = GetAnimInstance()) {
+    AnimInstance->Montage_JumpToSection(Section, Montage);
+  }
+}
+
+void UCombatAbilityTask_PlayMontageAndWaitForSection::OnDestroy(
+    bool bInOwnerFinished) {
+  // the montage may keep playing after the ability, stop it calling back
+  if (UAnimInstance *AnimInstance = GetAnimInstance()) {
+    FAnimMontageInstance *Instance =
+        AnimInstance->GetActiveInstanceForMontage(Montage);
+    if (Instance && Instance->GetInstanceID() == MontageInstanceID) {
+      Instance->OnMontageEnded.Unbind();
+    }
+  }
+
+  Super::OnDestroy(bInOwnerFinished);
+}
+
+void UCombatAbilityTask_PlayMontageAndWaitForSection::HandleMontageEnded(
+    UAnimMontage *EndedMontage, bool bInterrupted) {
+  MontageInstanceID = INDEX_NONE;
+
+  if (ShouldBroadcastAbilityTaskDelegates()) {
+    OnMontageEnded.ExecuteIfBound(EndedMontage, bInterrupted);
+  }
+}
+
+UAnimInstance *
+UCombatAbilityTask_PlayMontageAndWaitForSection::GetAnimInstance() const {
+  const FGameplayAbilityActorInfo *ActorInfo =
+      Ability ? Ability->GetCurrentActorInfo() : nullptr;
+  return ActorInfo ? ActorInfo->GetAnimInstance() : nullptr;
+}
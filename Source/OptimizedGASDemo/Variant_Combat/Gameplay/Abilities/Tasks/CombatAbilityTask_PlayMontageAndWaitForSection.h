@@ -0,0 +1,59 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatAbilityTask.h"
+#include "CombatAbilityTask_PlayMontageAndWaitForSection.generated.h"
+
+class UAnimInstance;
+class UAnimMontage;
+
+/** Montage ended, bInterrupted is true if it was stopped or failed to play */
+DECLARE_DELEGATE_TwoParams(FCombatMontageEndedDelegate, UAnimMontage *, bool);
+
+/**
+ * Plays a montage from a section, jumps between its sections on request and
+ * reports when it ends. The end delegate is removed when the task ends, so
+ * a montage outliving its ability never calls back into it.
+ */
+UCLASS()
+class UCombatAbilityTask_PlayMontageAndWaitForSection
+    : public UCombatAbilityTask {
+  GENERATED_BODY()
+
+public:
+  /** Play the montage on the avatar, starting at StartSection if set */
+  static UCombatAbilityTask_PlayMontageAndWaitForSection *
+  PlayMontageAndWaitForSection(UGameplayAbility *OwningAbility,
+                               UAnimMontage *Montage,
+                               FName StartSection = NAME_None,
+                               float Rate = 1.0f);
+
+  /** Jump to a section of the playing montage */
+  void JumpToSection(FName Section);
+
+  /** Called when the montage ends */
+  FCombatMontageEndedDelegate OnMontageEnded;
+
+  // ~begin UGameplayTask interface
+  virtual void Activate() override;
+  virtual void OnDestroy(bool bInOwnerFinished) override;
+  // ~end UGameplayTask interface
+
+protected:
+  /** Forward the end of the montage instance played by this task */
+  void HandleMontageEnded(UAnimMontage *EndedMontage, bool bInterrupted);
+
+  /** Anim instance of the avatar */
+  UAnimInstance *GetAnimInstance() const;
+
+  UPROPERTY()
+  TObjectPtr<UAnimMontage> Montage;
+
+  FName StartSection;
+  float Rate = 1.0f;
+
+  /** Montage instance played by this task */
+  int32 MontageInstanceID = INDEX_NONE;
+};
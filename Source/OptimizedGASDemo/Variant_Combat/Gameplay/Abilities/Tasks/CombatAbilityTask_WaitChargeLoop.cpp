@@ -0,0 +1,37 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatAbilityTask_WaitChargeLoop.h"
+
+UCombatAbilityTask_WaitChargeLoop *
+UCombatAbilityTask_WaitChargeLoop::WaitChargeLoop(
+    UGameplayAbility *OwningAbility, FGameplayTag LoopTag,
+    FGameplayTag ReleaseTag) {
+  UCombatAbilityTask_WaitChargeLoop *Task =
+      NewAbilityTask<UCombatAbilityTask_WaitChargeLoop>(OwningAbility);
+  Task->LoopTag = LoopTag;
+  Task->ReleaseTag = ReleaseTag;
+  return Task;
+}
+
+void UCombatAbilityTask_WaitChargeLoop::Activate() {
+  ListenForEvent(LoopTag,
+                 FGameplayEventMulticastDelegate::FDelegate::CreateUObject(
+                     this, &UCombatAbilityTask_WaitChargeLoop::HandleLoop));
+  ListenForEvent(ReleaseTag,
+                 FGameplayEventMulticastDelegate::FDelegate::CreateUObject(
+                     this, &UCombatAbilityTask_WaitChargeLoop::HandleRelease));
+}
+
+void UCombatAbilityTask_WaitChargeLoop::HandleLoop(
+    const FGameplayEventData *EventData) {
+  if (ShouldBroadcastAbilityTaskDelegates()) {
+    OnLoop.ExecuteIfBound();
+  }
+}
+
+void UCombatAbilityTask_WaitChargeLoop::HandleRelease(
+    const FGameplayEventData *EventData) {
+  if (ShouldBroadcastAbilityTaskDelegates()) {
+    OnRelease.ExecuteIfBound();
+  }
+}
@@ -0,0 +1,42 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatAbilityTask.h"
+#include "CombatAbilityTask_WaitChargeLoop.generated.h"
+
+/** Charge loop or release event */
+DECLARE_DELEGATE(FCombatChargeLoopDelegate);
+
+/**
+ * Reports each loop of a charge montage and the release of the charge until
+ * the ability ends.
+ */
+UCLASS()
+class UCombatAbilityTask_WaitChargeLoop : public UCombatAbilityTask {
+  GENERATED_BODY()
+
+public:
+  /** Wait for LoopTag and ReleaseTag events */
+  static UCombatAbilityTask_WaitChargeLoop *
+  WaitChargeLoop(UGameplayAbility *OwningAbility, FGameplayTag LoopTag,
+                 FGameplayTag ReleaseTag);
+
+  /** Called each time the charge loop section ends */
+  FCombatChargeLoopDelegate OnLoop;
+
+  /** Called when the charge is released */
+  FCombatChargeLoopDelegate OnRelease;
+
+  // ~begin UGameplayTask interface
+  virtual void Activate() override;
+  // ~end UGameplayTask interface
+
+protected:
+  void HandleLoop(const FGameplayEventData *EventData);
+  void HandleRelease(const FGameplayEventData *EventData);
+
+  FGameplayTag LoopTag;
+  FGameplayTag ReleaseTag;
+};
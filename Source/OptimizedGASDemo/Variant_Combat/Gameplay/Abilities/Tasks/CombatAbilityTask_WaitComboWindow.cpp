@@ -0,0 +1,50 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatAbilityTask_WaitComboWindow.h"
+#include "Engine/World.h"
+
+UCombatAbilityTask_WaitComboWindow *
+UCombatAbilityTask_WaitComboWindow::WaitComboWindow(
+    UGameplayAbility *OwningAbility, FGameplayTag InputTag,
+    FGameplayTag WindowTag, float InputTolerance) {
+  UCombatAbilityTask_WaitComboWindow *Task =
+      NewAbilityTask<UCombatAbilityTask_WaitComboWindow>(OwningAbility);
+  Task->InputTag = InputTag;
+  Task->WindowTag = WindowTag;
+  Task->InputTolerance = InputTolerance;
+  return Task;
+}
+
+void UCombatAbilityTask_WaitComboWindow::Activate() {
+  ActivationFrame = GFrameCounter;
+  LastInputTime = -1.0;
+
+  ListenForEvent(InputTag,
+                 FGameplayEventMulticastDelegate::FDelegate::CreateUObject(
+                     this, &UCombatAbilityTask_WaitComboWindow::HandleInput));
+  ListenForEvent(WindowTag,
+                 FGameplayEventMulticastDelegate::FDelegate::CreateUObject(
+                     this, &UCombatAbilityTask_WaitComboWindow::HandleWindow));
+}
+
+void UCombatAbilityTask_WaitComboWindow::HandleInput(
+    const FGameplayEventData *EventData) {
+  // the event that started the ability reaches listeners after activation
+  if (GFrameCounter == ActivationFrame) {
+    return;
+  }
+
+  LastInputTime = GetWorld()->GetTimeSeconds();
+}
+
+void UCombatAbilityTask_WaitComboWindow::HandleWindow(
+    const FGameplayEventData *EventData) {
+  const bool bInputBuffered =
+      LastInputTime >= 0.0 &&
+      GetWorld()->GetTimeSeconds() - LastInputTime <= InputTolerance;
+  LastInputTime = -1.0;
+
+  if (ShouldBroadcastAbilityTaskDelegates()) {
+    OnWindowOpened.ExecuteIfBound(bInputBuffered);
+  }
+}
@@ -0,0 +1,51 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatAbilityTask.h"
+#include "CombatAbilityTask_WaitComboWindow.generated.h"
+
+/** Combo window opened, bInputBuffered is true if the input arrived in time */
+DECLARE_DELEGATE_OneParam(FCombatComboWindowDelegate, bool);
+
+/**
+ * Buffers combo input and reports each combo window the montage opens.
+ * Input events sent in the frame the task started are the ones that
+ * activated the ability and are ignored.
+ */
+UCLASS()
+class UCombatAbilityTask_WaitComboWindow : public UCombatAbilityTask {
+  GENERATED_BODY()
+
+public:
+  /** Wait for InputTag presses and WindowTag windows. Input older than
+   * InputTolerance seconds when a window opens doesn't count */
+  static UCombatAbilityTask_WaitComboWindow *
+  WaitComboWindow(UGameplayAbility *OwningAbility, FGameplayTag InputTag,
+                  FGameplayTag WindowTag, float InputTolerance);
+
+  /** Called each time a combo window opens */
+  FCombatComboWindowDelegate OnWindowOpened;
+
+  // ~begin UGameplayTask interface
+  virtual void Activate() override;
+  // ~end UGameplayTask interface
+
+protected:
+  /** Buffer a combo input */
+  void HandleInput(const FGameplayEventData *EventData);
+
+  /** Report the window and consume the buffered input */
+  void HandleWindow(const FGameplayEventData *EventData);
+
+  FGameplayTag InputTag;
+  FGameplayTag WindowTag;
+  float InputTolerance = 1.0f;
+
+  /** Frame the task started in */
+  uint64 ActivationFrame = 0;
+
+  /** Time of the buffered input, negative when there is none */
+  double LastInputTime = -1.0;
+};
@@ -22,6 +22,39 @@ ACombatActivationVolume::ACombatActivationVolume()
 
 	// bind the begin overlap 
 	Box->OnComponentBeginOverlap.AddDynamic(this, &ACombatActivationVolume::OnOverlap);
+
+	// create the preload box around the volume
+	PreloadBox = CreateDefaultSubobject<UBoxComponent>(TEXT("Preload Box"));
+	PreloadBox->SetupAttachment(RootComponent);
+	PreloadBox->SetBoxExtent(Box->GetUnscaledBoxExtent() + FVector(PreloadDistance));
+	PreloadBox->SetCollisionProfileName(FName("OverlapAllDynamic"));
+	PreloadBox->OnComponentBeginOverlap.AddDynamic(this, &ACombatActivationVolume::OnPreloadOverlap);
+}
+
+void ACombatActivationVolume::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	// keep the preload box in sync with the volume size
+	PreloadBox->SetBoxExtent(Box->GetUnscaledBoxExtent() + FVector(PreloadDistance));
+}
+
+void ACombatActivationVolume::OnPreloadOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	// is a player controlled Character approaching the volume?
+	ACharacter* PlayerCharacter = Cast<ACharacter>(OtherActor);
+
+	if (PlayerCharacter && PlayerCharacter->IsPlayerControlled())
+	{
+		// let the actors start loading what they need on activation
+		for (AActor* CurrentActor : ActorsToActivate)
+		{
+			if (ICombatActivatable* Activatable = Cast<ICombatActivatable>(CurrentActor))
+			{
+				Activatable->PreloadInteraction(PlayerCharacter);
+			}
+		}
+	}
 }
 
 void ACombatActivationVolume::OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
@@ -10,6 +10,7 @@ class UBoxComponent;
 
 /**
  *  A simple volume that activates a list of actors when the player pawn enters.
+ *  A larger preload box around it lets the actors start loading their assets before activation.
  */
 UCLASS()
 class ACombatActivationVolume : public AActor
@@ -19,6 +20,10 @@ class ACombatActivationVolume : public AActor
 	/** Collision box volume */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
 	UBoxComponent* Box;
+
+	/** Collision box that triggers asset preloading ahead of activation */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category ="Components", meta = (AllowPrivateAccess = "true"))
+	UBoxComponent* PreloadBox;
 	
 protected:
 
@@ -26,6 +31,10 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Activation Volume")
 	TArray<AActor*> ActorsToActivate;
 
+	/** Distance outside the volume at which the actors to activate start preloading */
+	UPROPERTY(EditAnywhere, Category="Activation Volume", meta = (ClampMin = 0, Units = "cm"))
+	float PreloadDistance = 1500.0f;
+
 public:	
 	
 	/** Constructor */
@@ -33,6 +42,13 @@ public:
 
 protected:
 
+	/** Sizes the preload box around the activation box */
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+	/** Handles overlaps with the preload box */
+	UFUNCTION()
+	void OnPreloadOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
 	/** Handles overlaps with the box volume */
 	UFUNCTION()
 	void OnOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -3,7 +3,6 @@
 
 #include "CombatDamageableBox.h"
 #include "Components/StaticMeshComponent.h"
-#include "TimerManager.h"
 #include "Engine/World.h"
 
 ACombatDamageableBox::ACombatDamageableBox()
@@ -21,6 +20,9 @@ ACombatDamageableBox::ACombatDamageableBox()
 
 	// disable navigation relevance so boxes don't affect NavMesh generation
 	Mesh->bNavigationRelevant = false;
+
+	// create the melee hitbox
+	HitboxComponent = CreateDefaultSubobject<UCombatHitboxComponent>(TEXT("Hitbox"));
 }
 
 void ACombatDamageableBox::RemoveFromLevel()
@@ -29,27 +31,57 @@ void ACombatDamageableBox::RemoveFromLevel()
 	Destroy();
 }
 
+void ACombatDamageableBox::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// melee traces hit a box over the mesh, on our team's channel
+	HitboxComponent->BuildHitboxes(Mesh, Team);
+
+	// register our HP with the prop subsystem
+	if (UCombatDamageablePropSubsystem* PropSubsystem = GetWorld()->GetSubsystem<UCombatDamageablePropSubsystem>())
+	{
+		PropHandle = PropSubsystem->RegisterProp(this, MaxHP, DamageResistance, Team);
+	}
+
+	// let area attacks find the box
+	if (UCombatSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>())
+	{
+		SpatialHandle = SpatialIndex->RegisterTarget(this, Team);
+	}
+}
+
 void ACombatDamageableBox::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
 	// clear the death timer
-	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+	if (UCombatTimerSubsystem* Timers = GetWorld()->GetSubsystem<UCombatTimerSubsystem>())
+	{
+		Timers->ClearTimer(DeathTimer);
+	}
+
+	// release our prop slot
+	if (UCombatDamageablePropSubsystem* PropSubsystem = GetWorld()->GetSubsystem<UCombatDamageablePropSubsystem>())
+	{
+		PropSubsystem->UnregisterProp(PropHandle);
+	}
+
+	if (UCombatSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>())
+	{
+		SpatialIndex->UnregisterTarget(SpatialHandle);
+	}
 }
 
 void ACombatDamageableBox::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
 {
+	UCombatDamageablePropSubsystem* PropSubsystem = GetWorld()->GetSubsystem<UCombatDamageablePropSubsystem>();
+
 	// only process damage if we still have HP
-	if (CurrentHP > 0.0f)
+	if (PropSubsystem && PropSubsystem->IsAlive(PropHandle))
 	{
-		// apply the damage
-		CurrentHP -= Damage;
-
-		// are we dead?
-		if (CurrentHP <= 0.0f)
-		{
-			HandleDeath();
-		}
+		// queue the damage. The subsystem applies it with the other props' hits and calls HandleDeath if we run out of HP
+		PropSubsystem->QueueDamage(PropHandle, Damage, DamageCauser);
 
 		// apply a physics impulse to the box, ignoring its mass
 		Mesh->AddImpulseAtLocation(DamageImpulse * Mesh->GetMass(), DamageLocation);
@@ -64,11 +96,23 @@ void ACombatDamageableBox::HandleDeath()
 	// change the collision object type to Visibility so we ignore most interactions but still retain physics collisions
 	Mesh->SetCollisionObjectType(ECC_Visibility);
 
+	// melee attacks pass through the destroyed box
+	HitboxComponent->SetHitboxesEnabled(false);
+
+	// destroyed boxes are no longer area attack targets
+	if (UCombatSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>())
+	{
+		SpatialIndex->UnregisterTarget(SpatialHandle);
+	}
+
 	// call the BP handler to play effects, etc.
 	OnBoxDestroyed();
 
 	// set up the death cleanup timer
-	GetWorld()->GetTimerManager().SetTimer(DeathTimer, this, &ACombatDamageableBox::RemoveFromLevel, DeathDelayTime);
+	if (UCombatTimerSubsystem* Timers = GetWorld()->GetSubsystem<UCombatTimerSubsystem>())
+	{
+		Timers->SetTimer(DeathTimer, this, &ACombatDamageableBox::RemoveFromLevel, DeathDelayTime);
+	}
 }
 
 void ACombatDamageableBox::ApplyHealing(float Healing, AActor* Healer)
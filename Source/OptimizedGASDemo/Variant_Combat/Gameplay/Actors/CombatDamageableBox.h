@@ -5,10 +5,15 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatDamageable.h"
+#include "CombatDamageablePropSubsystem.h"
+#include "CombatSpatialIndexSubsystem.h"
+#include "CombatTimerSubsystem.h"
+#include "Hitbox/CombatHitboxComponent.h"
 #include "CombatDamageableBox.generated.h"
 
 /**
- *  A simple physics box that reacts to damage through the ICombatDamageable interface
+ *  A simple physics box that reacts to damage through the ICombatDamageable interface.
+ *  Its HP are kept by the damageable prop subsystem.
  */
 UCLASS(abstract)
 class ACombatDamageableBox : public AActor, public ICombatDamageable
@@ -19,6 +24,10 @@ class ACombatDamageableBox : public AActor, public ICombatDamageable
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* Mesh;
 
+	/** Melee hitbox covering the mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	UCombatHitboxComponent* HitboxComponent;
+
 public:	
 
 	/** Constructor */
@@ -26,16 +35,30 @@ public:
 
 protected:
 
-	/** Amount of HP this box starts with. */
+	/** Amount of HP this box starts with. The prop subsystem tracks the HP left once the box is registered */
+	UPROPERTY(EditAnywhere, Category="Damage")
+	float MaxHP = 3.0f;
+
+	/** Fraction of incoming damage ignored by this box */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0, ClampMax = 1))
+	float DamageResistance = 0.0f;
+
+	/** Team this box belongs to. Hits from the same team are ignored */
 	UPROPERTY(EditAnywhere, Category="Damage")
-	float CurrentHP = 3.0f;
+	FGenericTeamId Team = FGenericTeamId::NoTeam;
+
+	/** Handle to this box in the damageable prop subsystem */
+	FCombatPropHandle PropHandle;
+
+	/** Handle to this box in the spatial index queried by area attacks */
+	FCombatSpatialHandle SpatialHandle;
 
 	/** Time to wait before we remove this box from the level. */
 	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
 	float DeathDelayTime = 6.0f;
 
 	/** Timer to defer destruction of this box after its HP are depleted */
-	FTimerHandle DeathTimer;
+	FCombatTimerHandle DeathTimer;
 
 	/** Blueprint damage handler for effect playback */
 	UFUNCTION(BlueprintImplementableEvent, Category="Damage")
@@ -50,6 +73,9 @@ protected:
 
 public:
 
+	/** Registers the box with the damageable prop subsystem */
+	virtual void BeginPlay() override;
+
 	/** EndPlay cleanup */
 	void EndPlay(EEndPlayReason::Type EndPlayReason) override;
 
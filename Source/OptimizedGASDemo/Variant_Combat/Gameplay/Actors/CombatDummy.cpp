@@ -2,13 +2,14 @@
 
 
 #include "CombatDummy.h"
+#include "Engine/World.h"
 #include "Components/SceneComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "PhysicsEngine/PhysicsConstraintComponent.h"
 
 ACombatDummy::ACombatDummy()
 {
- 	PrimaryActorTick.bCanEverTick = true;
+ 	PrimaryActorTick.bCanEverTick = false;
 
 	// create the root
 	Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
@@ -29,10 +30,60 @@ ACombatDummy::ACombatDummy()
 	PhysicsConstraint->SetupAttachment(RootComponent);
 
 	PhysicsConstraint->SetConstrainedComponents(BasePlate, NAME_None, Dummy, NAME_None);
+
+	// create the melee hitbox
+	HitboxComponent = CreateDefaultSubobject<UCombatHitboxComponent>(TEXT("Hitbox"));
+}
+
+void ACombatDummy::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// melee traces hit a box over the dummy mesh
+	HitboxComponent->BuildHitboxes(Dummy);
+
+	// only track HP if the dummy can be defeated
+	if (MaxHP > 0.0f)
+	{
+		if (UCombatDamageablePropSubsystem* PropSubsystem = GetWorld()->GetSubsystem<UCombatDamageablePropSubsystem>())
+		{
+			PropHandle = PropSubsystem->RegisterProp(this, MaxHP);
+		}
+	}
+
+	// let area attacks find the dummy
+	if (UCombatSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>())
+	{
+		SpatialHandle = SpatialIndex->RegisterTarget(this);
+	}
+}
+
+void ACombatDummy::EndPlay(EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	if (UCombatDamageablePropSubsystem* PropSubsystem = GetWorld()->GetSubsystem<UCombatDamageablePropSubsystem>())
+	{
+		PropSubsystem->UnregisterProp(PropHandle);
+	}
+
+	if (UCombatSpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UCombatSpatialIndexSubsystem>())
+	{
+		SpatialIndex->UnregisterTarget(SpatialHandle);
+	}
 }
 
 void ACombatDummy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector& DamageLocation, const FVector& DamageImpulse)
 {
+	// queue the damage if we track HP
+	if (PropHandle.IsValid())
+	{
+		if (UCombatDamageablePropSubsystem* PropSubsystem = GetWorld()->GetSubsystem<UCombatDamageablePropSubsystem>())
+		{
+			PropSubsystem->QueueDamage(PropHandle, Damage, DamageCauser);
+		}
+	}
+
 	// apply impulse to the dummy
 	Dummy->AddImpulseAtLocation(DamageImpulse, DamageLocation);
 
@@ -42,7 +93,14 @@ void ACombatDummy::ApplyDamage(float Damage, AActor* DamageCauser, const FVector
 
 void ACombatDummy::HandleDeath()
 {
-	// unused
+	// call the BP handler
+	BP_OnDummyDefeated();
+
+	// training dummies recover right away
+	if (UCombatDamageablePropSubsystem* PropSubsystem = GetWorld()->GetSubsystem<UCombatDamageablePropSubsystem>())
+	{
+		PropSubsystem->ResetHealth(PropHandle);
+	}
 }
 
 void ACombatDummy::ApplyHealing(float Healing, AActor* Healer)
@@ -5,13 +5,17 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CombatDamageable.h"
+#include "CombatDamageablePropSubsystem.h"
+#include "CombatSpatialIndexSubsystem.h"
+#include "Hitbox/CombatHitboxComponent.h"
 #include "CombatDummy.generated.h"
 
 class UStaticMeshComponent;
 class UPhysicsConstraintComponent;
 
 /**
- *  A simple invincible combat training dummy
+ *  A simple combat training dummy.
+ *  Invincible by default, or tracks HP through the damageable prop subsystem and recovers when they run out.
  */
 UCLASS(abstract)
 class ACombatDummy : public AActor, public ICombatDamageable
@@ -30,6 +34,10 @@ class ACombatDummy : public AActor, public ICombatDamageable
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* Dummy;
 
+	/** Melee hitbox covering the dummy mesh */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
+	UCombatHitboxComponent* HitboxComponent;
+
 	/** Physics constraint holding the dummy and base plate together */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components", meta = (AllowPrivateAccess = "true"))
 	UPhysicsConstraintComponent* PhysicsConstraint;
@@ -39,6 +47,12 @@ public:
 	/** Constructor */
 	ACombatDummy();
 
+	/** Registers the dummy with the damageable prop subsystem */
+	virtual void BeginPlay() override;
+
+	/** Releases the prop slot */
+	virtual void EndPlay(EEndPlayReason::Type EndPlayReason) override;
+
 	// ~Begin CombatDamageable interface
 
 		/** Handles damage and knockback events */
@@ -57,7 +71,21 @@ public:
 
 protected:
 
+	/** HP the dummy starts with. Zero keeps the dummy invincible */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 0))
+	float MaxHP = 0.0f;
+
+	/** Handle to this dummy in the damageable prop subsystem */
+	FCombatPropHandle PropHandle;
+
+	/** Handle to this dummy in the spatial index queried by area attacks */
+	FCombatSpatialHandle SpatialHandle;
+
 	/** Blueprint handle to apply damage effects */
 	UFUNCTION(BlueprintImplementableEvent, Category="Combat", meta = (DisplayName = "On Dummy Damaged"))
 	void BP_OnDummyDamaged(const FVector& Location, const FVector& Direction);
+
+	/** Blueprint handle to play effects when the dummy's HP run out, right before they are restored */
+	UFUNCTION(BlueprintImplementableEvent, Category="Combat", meta = (DisplayName = "On Dummy Defeated"))
+	void BP_OnDummyDefeated();
 };
@@ -2,8 +2,10 @@
 
 
 #include "CombatLavaFloor.h"
-#include "CombatDamageable.h"
+#include "CombatDamageZoneSubsystem.h"
+#include "Components/BoxComponent.h"
 #include "Components/StaticMeshComponent.h"
+#include "Effects/CombatDamageOverTimeGameplayEffect.h"
 
 ACombatLavaFloor::ACombatLavaFloor()
 {
@@ -12,16 +14,58 @@ ACombatLavaFloor::ACombatLavaFloor()
 	// create the mesh
 	RootComponent = Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 
-	// bind the hit handler
-	Mesh->OnComponentHit.AddDynamic(this, &ACombatLavaFloor::OnFloorHit);
+	// create the damage volume on top of the mesh
+	DamageVolume = CreateDefaultSubobject<UBoxComponent>(TEXT("Damage Volume"));
+	DamageVolume->SetupAttachment(Mesh);
+	DamageVolume->SetCollisionProfileName(FName("Trigger"));
+
+	// bind the overlap handlers
+	DamageVolume->OnComponentBeginOverlap.AddDynamic(this, &ACombatLavaFloor::OnDamageVolumeBeginOverlap);
+	DamageVolume->OnComponentEndOverlap.AddDynamic(this, &ACombatLavaFloor::OnDamageVolumeEndOverlap);
+
+	DamageEffectClass = UCombatDamageOverTimeGameplayEffect::StaticClass();
 }
 
-void ACombatLavaFloor::OnFloorHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+void ACombatLavaFloor::OnConstruction(const FTransform& Transform)
 {
-	// check if the hit actor is damageable by casting to the interface
-	if (ICombatDamageable* Damageable = Cast<ICombatDamageable>(OtherActor))
+	Super::OnConstruction(Transform);
+
+	// blocking hits fire every frame, so occupants are tracked with a volume straddling the top surface instead
+	const FBoxSphereBounds LocalBounds = Mesh->CalcBounds(FTransform::Identity);
+	const float HalfHeight = DamageVolumeHeight / FMath::Max(FMath::Abs(Mesh->GetComponentScale().Z), UE_KINDA_SMALL_NUMBER);
+
+	DamageVolume->SetRelativeLocation(LocalBounds.Origin + FVector(0.0f, 0.0f, LocalBounds.BoxExtent.Z));
+	DamageVolume->SetBoxExtent(FVector(LocalBounds.BoxExtent.X, LocalBounds.BoxExtent.Y, HalfHeight));
+}
+
+void ACombatLavaFloor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UCombatDamageZoneSubsystem* DamageZones = GetWorld()->GetSubsystem<UCombatDamageZoneSubsystem>())
+	{
+		DamageZones->RemoveZone(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ACombatLavaFloor::OnDamageVolumeBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (UCombatDamageZoneSubsystem* DamageZones = GetWorld()->GetSubsystem<UCombatDamageZoneSubsystem>())
+	{
+		DamageZones->EnterZone(this, OtherActor, DamageEffectClass, Damage);
+	}
+}
+
+void ACombatLavaFloor::OnDamageVolumeEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	// the actor may still overlap with another of its components
+	if (DamageVolume->IsOverlappingActor(OtherActor))
+	{
+		return;
+	}
+
+	if (UCombatDamageZoneSubsystem* DamageZones = GetWorld()->GetSubsystem<UCombatDamageZoneSubsystem>())
 	{
-		// damage the actor
-		Damageable->ApplyDamage(Damage, this, Hit.ImpactPoint, FVector::ZeroVector);
+		DamageZones->LeaveZone(this, OtherActor);
 	}
 }
@@ -7,10 +7,13 @@
 #include "CombatLavaFloor.generated.h"
 
 class UStaticMeshComponent;
+class UBoxComponent;
 class UPrimitiveComponent;
+class UGameplayEffect;
 
 /**
- *  A basic actor that applies damage on contact through the ICombatDamageable interface. 
+ *  A basic actor that damages anything standing on it over time.
+ *  Occupants are tracked through overlaps and damaged by the damage zone subsystem at a fixed rate.
  */
 UCLASS(abstract)
 class ACombatLavaFloor : public AActor
@@ -21,20 +24,42 @@ class ACombatLavaFloor : public AActor
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* Mesh;
 
+	/** Overlap volume covering the top of the floor, sized to the mesh on construction */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UBoxComponent* DamageVolume;
+
 protected:
 
-	/** Amount of damage to deal on contact */
+	/** Amount of damage to deal per period of the damage effect */
 	UPROPERTY(EditAnywhere, Category="Damage")
 	float Damage = 10000.0f;
 
+	/** Periodic effect applied to each occupant while it stands on the floor */
+	UPROPERTY(EditAnywhere, Category="Damage")
+	TSubclassOf<UGameplayEffect> DamageEffectClass;
+
+	/** Height of the damage volume above the floor surface */
+	UPROPERTY(EditAnywhere, Category="Damage", meta = (ClampMin = 1, Units = "cm"))
+	float DamageVolumeHeight = 20.0f;
+
 public:	
 
 	/** Constructor */
 	ACombatLavaFloor();
 
+	/** Fit the damage volume to the mesh */
+	virtual void OnConstruction(const FTransform& Transform) override;
+
 protected:
 
-	/** Blocking hit handler */
+	/** Releases the occupants */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Starts damaging actors entering the volume */
+	UFUNCTION()
+	void OnDamageVolumeBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/** Stops damaging actors leaving the volume */
 	UFUNCTION()
-	void OnFloorHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+	void OnDamageVolumeEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 };
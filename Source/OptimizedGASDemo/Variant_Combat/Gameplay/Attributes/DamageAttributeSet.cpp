@@ -8,6 +8,7 @@ UDamageAttributeSet::UDamageAttributeSet() {
   InitDamage(10.0f);
   InitKnockbackImpulse(250.0f);
   InitLaunchImpulse(300.0f);
+  InitDamageMultiplier(1.0f);
 }
 
 void UDamageAttributeSet::GetLifetimeReplicatedProps(
@@ -20,6 +21,8 @@ void UDamageAttributeSet::GetLifetimeReplicatedProps(
                                  COND_None, REPNOTIFY_Always);
   DOREPLIFETIME_CONDITION_NOTIFY(UDamageAttributeSet, LaunchImpulse, COND_None,
                                  REPNOTIFY_Always);
+  DOREPLIFETIME_CONDITION_NOTIFY(UDamageAttributeSet, DamageMultiplier,
+                                 COND_None, REPNOTIFY_Always);
 }
 
 void UDamageAttributeSet::OnRep_Damage(
@@ -38,3 +41,9 @@ void UDamageAttributeSet::OnRep_LaunchImpulse(
   GAMEPLAYATTRIBUTE_REPNOTIFY(UDamageAttributeSet, LaunchImpulse,
                               OldLaunchImpulse);
 }
+
+void UDamageAttributeSet::OnRep_DamageMultiplier(
+    const FGameplayAttributeData &OldDamageMultiplier) {
+  GAMEPLAYATTRIBUTE_REPNOTIFY(UDamageAttributeSet, DamageMultiplier,
+                              OldDamageMultiplier);
+}
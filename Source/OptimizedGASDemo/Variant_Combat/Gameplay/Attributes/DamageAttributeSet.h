@@ -44,6 +44,12 @@ public:
   FGameplayAttributeData LaunchImpulse;
   ATTRIBUTE_ACCESSORS(UDamageAttributeSet, LaunchImpulse)
 
+  // Damage multiplier, captured from the source by the damage execution
+  UPROPERTY(BlueprintReadOnly, Category = "Damage",
+            ReplicatedUsing = OnRep_DamageMultiplier)
+  FGameplayAttributeData DamageMultiplier;
+  ATTRIBUTE_ACCESSORS(UDamageAttributeSet, DamageMultiplier)
+
 protected:
   UFUNCTION()
   virtual void OnRep_Damage(const FGameplayAttributeData &OldDamage);
@@ -55,4 +61,8 @@ protected:
   UFUNCTION()
   virtual void
   OnRep_LaunchImpulse(const FGameplayAttributeData &OldLaunchImpulse);
+
+  UFUNCTION()
+  virtual void
+  OnRep_DamageMultiplier(const FGameplayAttributeData &OldDamageMultiplier);
 };
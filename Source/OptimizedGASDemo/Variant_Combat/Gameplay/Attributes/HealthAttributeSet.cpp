@@ -2,11 +2,14 @@
 
 #include "HealthAttributeSet.h"
 #include "Net/UnrealNetwork.h"
+#include "GameplayEffect.h"
+#include "GameplayEffectExtension.h"
 
 UHealthAttributeSet::UHealthAttributeSet() {
   // Default values
   InitHealth(1000.0f);
   InitMaxHealth(1000.0f);
+  InitIncomingDamage(0.0f);
 }
 
 void UHealthAttributeSet::GetLifetimeReplicatedProps(
@@ -43,3 +46,35 @@ void UHealthAttributeSet::PostAttributeChange(
     const FGameplayAttribute &Attribute, float OldValue, float NewValue) {
   Super::PostAttributeChange(Attribute, OldValue, NewValue);
 }
+
+void UHealthAttributeSet::PostGameplayEffectExecute(
+    const FGameplayEffectModCallbackData &Data) {
+  Super::PostGameplayEffectExecute(Data);
+
+  if (Data.EvaluatedData.Attribute != GetIncomingDamageAttribute()) {
+    return;
+  }
+
+  // Consume the meta attribute
+  const float Damage = GetIncomingDamage();
+  SetIncomingDamage(0.0f);
+
+  const float OldHealth = GetHealth();
+  if (Damage <= 0.0f || OldHealth <= 0.0f) {
+    return;
+  }
+
+  SetHealth(FMath::Clamp(OldHealth - Damage, 0.0f, GetMaxHealth()));
+
+  const FGameplayEffectContextHandle &Context =
+      Data.EffectSpec.GetEffectContext();
+  AActor *Instigator = Context.GetOriginalInstigator();
+  AActor *Causer = Context.GetEffectCauser();
+
+  OnDamageTaken.Broadcast(Instigator, Causer, Data.EffectSpec, Damage);
+
+  // Raise death once, on the hit that takes health to zero
+  if (GetHealth() <= 0.0f) {
+    OnOutOfHealth.Broadcast(Instigator, Causer, Data.EffectSpec, Damage);
+  }
+}
@@ -13,6 +13,16 @@
   GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName)                                 \
   GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
 
+struct FGameplayEffectSpec;
+
+/** Raised from the health set with the instigator, causer, spec and
+ * magnitude of the effect */
+DECLARE_MULTICAST_DELEGATE_FourParams(FCombatAttributeEvent,
+                                      AActor * /*EffectInstigator*/,
+                                      AActor * /*EffectCauser*/,
+                                      const FGameplayEffectSpec & /*Spec*/,
+                                      float /*Magnitude*/);
+
 /**
  * AttributeSet for Health
  */
@@ -32,6 +42,9 @@ public:
   virtual void PostAttributeChange(const FGameplayAttribute &Attribute,
                                    float OldValue, float NewValue) override;
 
+  virtual void PostGameplayEffectExecute(
+      const FGameplayEffectModCallbackData &Data) override;
+
   // Health
   UPROPERTY(BlueprintReadOnly, Category = "Health",
             ReplicatedUsing = OnRep_Health)
@@ -43,6 +56,18 @@ public:
   FGameplayAttributeData MaxHealth;
   ATTRIBUTE_ACCESSORS(UHealthAttributeSet, MaxHealth)
 
+  // Incoming damage. Meta attribute (server only, not replicated) that is
+  // consumed in PostGameplayEffectExecute and subtracted from Health
+  UPROPERTY(BlueprintReadOnly, Category = "Health")
+  FGameplayAttributeData IncomingDamage;
+  ATTRIBUTE_ACCESSORS(UHealthAttributeSet, IncomingDamage)
+
+  /** Broadcast on the server when incoming damage is applied to health */
+  mutable FCombatAttributeEvent OnDamageTaken;
+
+  /** Broadcast on the server when health reaches zero */
+  mutable FCombatAttributeEvent OnOutOfHealth;
+
 protected:
   UFUNCTION()
   virtual void OnRep_Health(const FGameplayAttributeData &OldHealth);
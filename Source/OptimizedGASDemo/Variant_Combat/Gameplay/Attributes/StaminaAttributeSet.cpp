@@ -9,6 +9,7 @@ UStaminaAttributeSet::UStaminaAttributeSet() {
   InitStamina(100.0f);
   InitMaxStamina(100.0f);
   InitStaminaUsed(0.0f);
+  InitStaminaMultiplier(1.0f);
 }
 
 void UStaminaAttributeSet::GetLifetimeReplicatedProps(
@@ -21,6 +22,8 @@ void UStaminaAttributeSet::GetLifetimeReplicatedProps(
                                  COND_OwnerOnly, REPNOTIFY_Always);
   DOREPLIFETIME_CONDITION_NOTIFY(UStaminaAttributeSet, StaminaUsed,
                                  COND_OwnerOnly, REPNOTIFY_Always);
+  DOREPLIFETIME_CONDITION_NOTIFY(UStaminaAttributeSet, StaminaMultiplier,
+                                 COND_OwnerOnly, REPNOTIFY_Always);
 }
 
 void UStaminaAttributeSet::OnRep_Stamina(
@@ -39,6 +42,12 @@ void UStaminaAttributeSet::OnRep_StaminaUsed(
                               OldStaminaUsed);
 }
 
+void UStaminaAttributeSet::OnRep_StaminaMultiplier(
+    const FGameplayAttributeData &OldStaminaMultiplier) {
+  GAMEPLAYATTRIBUTE_REPNOTIFY(UStaminaAttributeSet, StaminaMultiplier,
+                              OldStaminaMultiplier);
+}
+
 void UStaminaAttributeSet::PreAttributeChange(
     const FGameplayAttribute &Attribute, float &NewValue) {
   if (Attribute == GetStaminaAttribute()) {
@@ -49,6 +49,12 @@ public:
   FGameplayAttributeData StaminaUsed;
   ATTRIBUTE_ACCESSORS_STAMINA(UStaminaAttributeSet, StaminaUsed)
 
+  // Stamina cost multiplier, captured from the source by the stamina execution
+  UPROPERTY(BlueprintReadOnly, Category = "Stamina",
+            ReplicatedUsing = OnRep_StaminaMultiplier)
+  FGameplayAttributeData StaminaMultiplier;
+  ATTRIBUTE_ACCESSORS_STAMINA(UStaminaAttributeSet, StaminaMultiplier)
+
 protected:
   UFUNCTION()
   virtual void OnRep_Stamina(const FGameplayAttributeData &OldStamina);
@@ -58,4 +64,8 @@ protected:
 
   UFUNCTION()
   virtual void OnRep_StaminaUsed(const FGameplayAttributeData &OldStaminaUsed);
+
+  UFUNCTION()
+  virtual void
+  OnRep_StaminaMultiplier(const FGameplayAttributeData &OldStaminaMultiplier);
 };
@@ -2,26 +2,106 @@
 
 #include "CombatPawnData.h"
 #include "Abilities/GameplayAbility.h"
+#include "AbilitySystemComponent.h"
+#include "Attributes/HealthAttributeSet.h"
+#include "Attributes/DamageAttributeSet.h"
+#include "Attributes/StaminaAttributeSet.h"
+#include "Attributes/MovementAttributeSet.h"
 #include "CombatAttributeTableRow.h"
 
+const FPrimaryAssetType UCombatPawnData::PrimaryAssetType =
+    TEXT("CombatPawnData");
+const FName UCombatPawnData::GameplayBundle = TEXT("Gameplay");
+
 UCombatPawnData::UCombatPawnData() {}
 
-void UCombatPawnData::LoadFromDataTable() {
+FPrimaryAssetId UCombatPawnData::GetPrimaryAssetId() const {
+  // share one type across subclasses so the asset manager scans them together
+  return FPrimaryAssetId(PrimaryAssetType, GetFName());
+}
+
+FCombatPawnAttributeDefaults UCombatPawnData::GetAttributeDefaults(
+    const FCombatPawnDataOverrides &Overrides) const {
+  FCombatPawnAttributeDefaults Defaults;
+  Defaults.Health = DefaultHealth;
+  Defaults.MaxHealth = DefaultMaxHealth;
+  Defaults.Damage = DefaultDamage;
+  Defaults.KnockbackImpulse = DefaultKnockbackImpulse;
+  Defaults.LaunchImpulse = DefaultLaunchImpulse;
+  Defaults.Stamina = DefaultStamina;
+  Defaults.MaxStamina = DefaultMaxStamina;
+  Defaults.DamageMultiplier = DamageMultiplier;
+  Defaults.StaminaMultiplier = StaminaMultiplier;
+
+  // Data table row replaces the asset values, without writing them back
   if (AttributeDataTable && !AttributeTableRowName.IsNone()) {
-    FCombatAttributeTableRow *Row =
+    const FCombatAttributeTableRow *Row =
         AttributeDataTable->FindRow<FCombatAttributeTableRow>(
             AttributeTableRowName, TEXT("CombatPawnData"));
     if (Row) {
-      DefaultHealth = Row->DefaultHealth;
-      DefaultMaxHealth = Row->DefaultMaxHealth;
-      DefaultDamage = Row->DefaultDamage;
-      DefaultKnockbackImpulse = Row->DefaultKnockbackImpulse;
-      DefaultLaunchImpulse = Row->DefaultLaunchImpulse;
+      Defaults.Health = Row->DefaultHealth;
+      Defaults.MaxHealth = Row->DefaultMaxHealth;
+      Defaults.Damage = Row->DefaultDamage;
+      Defaults.KnockbackImpulse = Row->DefaultKnockbackImpulse;
+      Defaults.LaunchImpulse = Row->DefaultLaunchImpulse;
     } else {
       UE_LOG(LogTemp, Error, TEXT("Failed to load attribute data for row: %s"),
              *AttributeTableRowName.ToString());
     }
   }
+
+  // Per-instance overrides
+  if (Overrides.bOverrideMaxHealth) {
+    Defaults.Health = Overrides.MaxHealth;
+    Defaults.MaxHealth = Overrides.MaxHealth;
+  }
+  if (Overrides.bOverrideMaxStamina) {
+    Defaults.Stamina = Overrides.MaxStamina;
+    Defaults.MaxStamina = Overrides.MaxStamina;
+  }
+  if (Overrides.bOverrideDamage) {
+    Defaults.Damage = Overrides.Damage;
+  }
+  if (Overrides.bOverrideDamageMultiplier) {
+    Defaults.DamageMultiplier = Overrides.DamageMultiplier;
+  }
+
+  return Defaults;
+}
+
+void UCombatPawnData::InitializeAttributes(
+    UAbilitySystemComponent *ASC,
+    const FCombatPawnDataOverrides &Overrides) const {
+  if (!ASC) {
+    return;
+  }
+
+  const FCombatPawnAttributeDefaults Defaults = GetAttributeDefaults(Overrides);
+
+  ASC->SetNumericAttributeBase(UHealthAttributeSet::GetHealthAttribute(),
+                               Defaults.Health);
+  ASC->SetNumericAttributeBase(UHealthAttributeSet::GetMaxHealthAttribute(),
+                               Defaults.MaxHealth);
+  ASC->SetNumericAttributeBase(UStaminaAttributeSet::GetStaminaAttribute(),
+                               Defaults.Stamina);
+  ASC->SetNumericAttributeBase(UStaminaAttributeSet::GetMaxStaminaAttribute(),
+                               Defaults.MaxStamina);
+  ASC->SetNumericAttributeBase(UDamageAttributeSet::GetDamageAttribute(),
+                               Defaults.Damage);
+  ASC->SetNumericAttributeBase(
+      UDamageAttributeSet::GetKnockbackImpulseAttribute(),
+      Defaults.KnockbackImpulse);
+  ASC->SetNumericAttributeBase(UDamageAttributeSet::GetLaunchImpulseAttribute(),
+                               Defaults.LaunchImpulse);
+
+  // Multipliers are captured from the source when specs are created, so
+  // executions never need to look up the pawn data
+  ASC->SetNumericAttributeBase(
+      UDamageAttributeSet::GetDamageMultiplierAttribute(),
+      Defaults.DamageMultiplier);
+  ASC->SetNumericAttributeBase(
+      UStaminaAttributeSet::GetStaminaMultiplierAttribute(),
+      Defaults.StaminaMultiplier);
 }
 
 TArray<TSubclassOf<UGameplayAbility>>
@@ -30,7 +110,8 @@ UCombatPawnData::GetAllGrantedAbilities() const {
 
   // Add abilities from AbilitySets
   for (const FCombatAbilitySetWithInput &AbilitySetWithInput : AbilitySets) {
-    if (UCombatAbilitySet *AbilitySet = AbilitySetWithInput.AbilitySet.Get()) {
+    if (const UCombatAbilitySet *AbilitySet =
+            AbilitySetWithInput.AbilitySet.LoadSynchronous()) {
       for (const FGameplayAbilityBindInfo &BindInfo : AbilitySet->Abilities) {
         if (BindInfo.GameplayAbilityClass) {
           AllAbilities.AddUnique(BindInfo.GameplayAbilityClass);
@@ -48,7 +129,8 @@ UCombatPawnData::GetAllGrantedEffects() const {
 
   // Add effects from AbilitySets
   for (const FCombatAbilitySetWithInput &AbilitySetWithInput : AbilitySets) {
-    if (UCombatAbilitySet *AbilitySet = AbilitySetWithInput.AbilitySet.Get()) {
+    if (const UCombatAbilitySet *AbilitySet =
+            AbilitySetWithInput.AbilitySet.LoadSynchronous()) {
       for (const FGameplayEffectApplicationInfo &EffectInfo :
            AbilitySet->GrantedGameplayEffects) {
         if (EffectInfo.GameplayEffect) {
@@ -60,3 +142,18 @@ UCombatPawnData::GetAllGrantedEffects() const {
 
   return AllEffects;
 }
+
+UCombatDefaultPawnData::UCombatDefaultPawnData() {
+  AttributeSets.Add(UHealthAttributeSet::StaticClass());
+  AttributeSets.Add(UDamageAttributeSet::StaticClass());
+  AttributeSets.Add(UStaminaAttributeSet::StaticClass());
+  AttributeSets.Add(UMovementAttributeSet::StaticClass());
+
+  DefaultHealth = 1000.0f;
+  DefaultMaxHealth = 1000.0f;
+  DefaultStamina = 100.0f;
+  DefaultMaxStamina = 100.0f;
+  DefaultDamage = 5.0f;
+  DefaultKnockbackImpulse = 500.0f;
+  DefaultLaunchImpulse = 300.0f;
+}
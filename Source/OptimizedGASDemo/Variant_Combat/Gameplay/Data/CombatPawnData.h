@@ -11,6 +11,7 @@
 #include "CombatInputConfig.h"
 #include "CombatPawnData.generated.h"
 
+class UAbilitySystemComponent;
 class UAttributeSet;
 class UGameplayAbility;
 class UGameplayEffect;
@@ -20,21 +21,86 @@ USTRUCT(BlueprintType)
 struct FCombatAbilitySetWithInput {
   GENERATED_BODY()
 
-  /** Ability set to grant */
-  UPROPERTY(EditDefaultsOnly, Category = AbilitySet)
-  TObjectPtr<UCombatAbilitySet> AbilitySet;
+  /** Ability set to grant, loaded with the Gameplay bundle */
+  UPROPERTY(EditDefaultsOnly, Category = AbilitySet,
+            meta = (AssetBundles = "Gameplay"))
+  TSoftObjectPtr<UCombatAbilitySet> AbilitySet;
+};
+
+/** Per-instance overrides applied on top of shared pawn data. Only values
+ * with their toggle set replace the pawn data value */
+USTRUCT(BlueprintType)
+struct FCombatPawnDataOverrides {
+  GENERATED_BODY()
+
+  UPROPERTY(EditAnywhere, Category = "Attributes",
+            meta = (InlineEditConditionToggle))
+  bool bOverrideMaxHealth = false;
+
+  UPROPERTY(EditAnywhere, Category = "Attributes",
+            meta = (ClampMin = 0, EditCondition = "bOverrideMaxHealth"))
+  float MaxHealth = 1000.0f;
+
+  UPROPERTY(EditAnywhere, Category = "Attributes",
+            meta = (InlineEditConditionToggle))
+  bool bOverrideMaxStamina = false;
+
+  UPROPERTY(EditAnywhere, Category = "Attributes",
+            meta = (ClampMin = 0, EditCondition = "bOverrideMaxStamina"))
+  float MaxStamina = 100.0f;
+
+  UPROPERTY(EditAnywhere, Category = "Attributes",
+            meta = (InlineEditConditionToggle))
+  bool bOverrideDamage = false;
+
+  UPROPERTY(EditAnywhere, Category = "Attributes",
+            meta = (ClampMin = 0, EditCondition = "bOverrideDamage"))
+  float Damage = 10.0f;
+
+  UPROPERTY(EditAnywhere, Category = "Attributes",
+            meta = (InlineEditConditionToggle))
+  bool bOverrideDamageMultiplier = false;
+
+  UPROPERTY(EditAnywhere, Category = "Attributes",
+            meta = (ClampMin = 0, EditCondition = "bOverrideDamageMultiplier"))
+  float DamageMultiplier = 1.0f;
+};
+
+/** Attribute base values resolved from pawn data and overrides */
+struct FCombatPawnAttributeDefaults {
+  float Health = 0.0f;
+  float MaxHealth = 0.0f;
+  float Damage = 0.0f;
+  float KnockbackImpulse = 0.0f;
+  float LaunchImpulse = 0.0f;
+  float Stamina = 0.0f;
+  float MaxStamina = 0.0f;
+  float DamageMultiplier = 1.0f;
+  float StaminaMultiplier = 1.0f;
 };
 
 /**
- * Data asset for combat pawn attributes and abilities
+ * Data asset for combat pawn attributes and abilities. Shared by every pawn
+ * of an archetype and never modified at runtime, per-instance differences go
+ * in FCombatPawnDataOverrides
  */
-UCLASS()
+UCLASS(BlueprintType)
 class UCombatPawnData : public UPrimaryDataAsset {
   GENERATED_BODY()
 
 public:
   UCombatPawnData();
 
+  /** Primary asset type registered with the asset manager */
+  static const FPrimaryAssetType PrimaryAssetType;
+
+  /** Bundle for assets needed to simulate the pawn (abilities, montages) */
+  static const FName GameplayBundle;
+
+  // ~begin UPrimaryDataAsset interface
+  virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+  // ~end UPrimaryDataAsset interface
+
   /** Data table row name to load attributes from */
   UPROPERTY(EditDefaultsOnly, Category = "Attributes")
   FName AttributeTableRowName;
@@ -91,8 +157,14 @@ public:
   UPROPERTY(EditDefaultsOnly, Category = "Execution", meta = (ClampMin = 0))
   float StaminaMultiplier = 1.0f;
 
-  /** Load attributes from data table */
-  void LoadFromDataTable();
+  /** Resolve attribute base values from this asset, its data table row and
+   * the given overrides */
+  FCombatPawnAttributeDefaults
+  GetAttributeDefaults(const FCombatPawnDataOverrides &Overrides) const;
+
+  /** Set attribute base values on the ability system (authority only) */
+  void InitializeAttributes(UAbilitySystemComponent *ASC,
+                            const FCombatPawnDataOverrides &Overrides) const;
 
   /** Get all granted abilities from AbilitySets*/
   TArray<TSubclassOf<UGameplayAbility>> GetAllGrantedAbilities() const;
@@ -100,3 +172,15 @@ public:
   /** Get all granted effects from AbilitySets*/
   TArray<TSubclassOf<UGameplayEffect>> GetAllGrantedEffects() const;
 };
+
+/**
+ * Pawn data used by pawns with no asset assigned. Matches the defaults the
+ * combat characters were created with
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class UCombatDefaultPawnData : public UCombatPawnData {
+  GENERATED_BODY()
+
+public:
+  UCombatDefaultPawnData();
+};
@@ -1,6 +1,7 @@
 // Copyright Nguyen Minh Tam. All Rights Reserved.
 
 #include "CombatDamageGameplayEffect.h"
+#include "AbilitySystemComponent.h"
 #include "Attributes/HealthAttributeSet.h"
 #include "GameplayTagsManager.h"
 #include "GameplayEffect.h"
@@ -16,3 +17,114 @@ UCombatDamageGameplayEffect::UCombatDamageGameplayEffect() {
       UCombatDamageExecutionCalculation::StaticClass();
   Executions.Add(ExecutionDef);
 }
+
+FGameplayEffectSpecHandle UCombatDamageGameplayEffect::MakeDamageSpec(
+    UAbilitySystemComponent *SourceASC,
+    TSubclassOf<UGameplayEffect> EffectClass, float Damage,
+    const FHitResult &HitResult, float Knockback, float Launch,
+    AActor *Instigator, AActor *EffectCauser) {
+  if (!SourceASC || !EffectClass) {
+    return FGameplayEffectSpecHandle();
+  }
+
+  FGameplayEffectContextHandle Context = SourceASC->MakeEffectContext();
+  Context.AddInstigator(Instigator, EffectCauser);
+  Context.AddHitResult(HitResult, true);
+
+  FGameplayEffectSpecHandle SpecHandle =
+      SourceASC->MakeOutgoingSpec(EffectClass, 1.0f, Context);
+  if (FGameplayEffectSpec *Spec = SpecHandle.Data.Get()) {
+    Spec->SetSetByCallerMagnitude(
+        FGameplayTag::RequestGameplayTag(FName("Data.Damage")), Damage);
+    Spec->SetSetByCallerMagnitude(
+        FGameplayTag::RequestGameplayTag(FName("Data.Knockback")), Knockback);
+    Spec->SetSetByCallerMagnitude(
+        FGameplayTag::RequestGameplayTag(FName("Data.Launch")), Launch);
+  }
+
+  return SpecHandle;
+}
+
+FGameplayEffectSpecHandle UCombatDamageGameplayEffect::MakeAreaDamageSpec(
+    UAbilitySystemComponent *SourceASC,
+    TSubclassOf<UGameplayEffect> EffectClass, float Damage,
+    const FVector &Origin, float Radius, float EdgeMultiplier, float Knockback,
+    float Launch, AActor *Instigator, AActor *EffectCauser) {
+  if (!SourceASC || !EffectClass) {
+    return FGameplayEffectSpecHandle();
+  }
+
+  // no hit result, every target measures its falloff from the origin
+  FGameplayEffectContextHandle Context = SourceASC->MakeEffectContext();
+  Context.AddInstigator(Instigator, EffectCauser);
+  Context.AddOrigin(Origin);
+
+  FGameplayEffectSpecHandle SpecHandle =
+      SourceASC->MakeOutgoingSpec(EffectClass, 1.0f, Context);
+  if (FGameplayEffectSpec *Spec = SpecHandle.Data.Get()) {
+    Spec->SetSetByCallerMagnitude(
+        FGameplayTag::RequestGameplayTag(FName("Data.Damage")), Damage);
+    Spec->SetSetByCallerMagnitude(
+        FGameplayTag::RequestGameplayTag(FName("Data.Knockback")), Knockback);
+    Spec->SetSetByCallerMagnitude(
+        FGameplayTag::RequestGameplayTag(FName("Data.Launch")), Launch);
+    Spec->SetSetByCallerMagnitude(
+        FGameplayTag::RequestGameplayTag(FName("Data.Falloff.Radius")),
+        Radius);
+    Spec->SetSetByCallerMagnitude(
+        FGameplayTag::RequestGameplayTag(FName("Data.Falloff.Edge")),
+        EdgeMultiplier);
+  }
+
+  return SpecHandle;
+}
+
+float UCombatDamageGameplayEffect::GetFalloffMultiplier(
+    const FGameplayEffectSpec &Spec, const FVector &TargetLocation) {
+  static const FGameplayTag RadiusTag =
+      FGameplayTag::RequestGameplayTag(FName("Data.Falloff.Radius"));
+  static const FGameplayTag EdgeTag =
+      FGameplayTag::RequestGameplayTag(FName("Data.Falloff.Edge"));
+
+  const FGameplayEffectContextHandle &Context = Spec.GetContext();
+  const float Radius = Spec.GetSetByCallerMagnitude(RadiusTag, false);
+  if (Radius <= 0.0f || !Context.HasOrigin()) {
+    return 1.0f;
+  }
+
+  const float Edge = Spec.GetSetByCallerMagnitude(EdgeTag, false, 1.0f);
+  const float Alpha = FMath::Clamp(
+      FVector::Dist(Context.GetOrigin(), TargetLocation) / Radius, 0.0f, 1.0f);
+  return FMath::Lerp(1.0f, Edge, Alpha);
+}
+
+FVector UCombatDamageGameplayEffect::GetDamageImpulse(
+    const FGameplayEffectSpec &Spec, const FVector &TargetLocation) {
+  const float Knockback = Spec.GetSetByCallerMagnitude(
+      FGameplayTag::RequestGameplayTag(FName("Data.Knockback")), false);
+  const float Launch = Spec.GetSetByCallerMagnitude(
+      FGameplayTag::RequestGameplayTag(FName("Data.Launch")), false);
+
+  // knock upwards and away from the impact normal
+  if (const FHitResult *HitResult = Spec.GetContext().GetHitResult()) {
+    return (FVector(HitResult->ImpactNormal) * -Knockback) +
+           (FVector::UpVector * Launch);
+  }
+
+  // area damage knocks away from the origin, weaker towards the edge
+  const FGameplayEffectContextHandle &Context = Spec.GetContext();
+  if (Context.HasOrigin()) {
+    const FVector Away =
+        (TargetLocation - Context.GetOrigin()).GetSafeNormal2D();
+    return ((Away * Knockback) + (FVector::UpVector * Launch)) *
+           GetFalloffMultiplier(Spec, TargetLocation);
+  }
+
+  return FVector::ZeroVector;
+}
+
+FVector UCombatDamageGameplayEffect::GetDamageLocation(
+    const FGameplayEffectSpec &Spec, const FVector &TargetLocation) {
+  const FHitResult *HitResult = Spec.GetContext().GetHitResult();
+  return HitResult ? FVector(HitResult->ImpactPoint) : TargetLocation;
+}
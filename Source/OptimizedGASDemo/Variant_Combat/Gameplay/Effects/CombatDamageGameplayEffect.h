@@ -6,6 +6,8 @@
 #include "CombatGameplayEffect.h"
 #include "CombatDamageGameplayEffect.generated.h"
 
+class UAbilitySystemComponent;
+
 /**
  * GameplayEffect for applying damage to health attribute
  */
@@ -15,4 +17,38 @@ class UCombatDamageGameplayEffect : public UCombatGameplayEffect {
 
 public:
   UCombatDamageGameplayEffect();
+
+  /** Build an outgoing damage spec from the attacker's ASC. Damage, knockback
+   * and launch are passed as SetByCaller magnitudes and the hit result is
+   * stored on the context for the target's reaction */
+  static FGameplayEffectSpecHandle
+  MakeDamageSpec(UAbilitySystemComponent *SourceASC,
+                 TSubclassOf<UGameplayEffect> EffectClass, float Damage,
+                 const FHitResult &HitResult, float Knockback, float Launch,
+                 AActor *Instigator, AActor *EffectCauser);
+
+  /** Build one damage spec for every target of an area attack. The origin
+   * is stored on the context and each target's damage and knockback are
+   * scaled by its distance from it, from full damage at the origin down to
+   * EdgeMultiplier at Radius */
+  static FGameplayEffectSpecHandle
+  MakeAreaDamageSpec(UAbilitySystemComponent *SourceASC,
+                     TSubclassOf<UGameplayEffect> EffectClass, float Damage,
+                     const FVector &Origin, float Radius, float EdgeMultiplier,
+                     float Knockback, float Launch, AActor *Instigator,
+                     AActor *EffectCauser);
+
+  /** Distance falloff of an area damage spec at the target, 1 for specs
+   * without falloff */
+  static float GetFalloffMultiplier(const FGameplayEffectSpec &Spec,
+                                    const FVector &TargetLocation);
+
+  /** Knockback impulse carried by a damage spec */
+  static FVector GetDamageImpulse(const FGameplayEffectSpec &Spec,
+                                  const FVector &TargetLocation);
+
+  /** Impact location carried by a damage spec, the target location for
+   * area damage */
+  static FVector GetDamageLocation(const FGameplayEffectSpec &Spec,
+                                   const FVector &TargetLocation);
 };
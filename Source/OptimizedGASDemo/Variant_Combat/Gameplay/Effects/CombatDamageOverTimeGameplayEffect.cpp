@@ -0,0 +1,13 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatDamageOverTimeGameplayEffect.h"
+
+UCombatDamageOverTimeGameplayEffect::UCombatDamageOverTimeGameplayEffect() {
+  // Stay active until the zone removes it
+  DurationPolicy = EGameplayEffectDurationType::Infinite;
+
+  // Deal damage on entry, then every 0.5 seconds through the inherited
+  // damage execution
+  Period = 0.5f;
+  bExecutePeriodicEffectOnApplication = true;
+}
@@ -0,0 +1,20 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatDamageGameplayEffect.h"
+#include "CombatDamageOverTimeGameplayEffect.generated.h"
+
+/**
+ * Infinite periodic damage, applied once per damage zone occupant and removed
+ * when it leaves. Each period runs the damage execution with the Data.Damage
+ * SetByCaller magnitude
+ */
+UCLASS()
+class UCombatDamageOverTimeGameplayEffect : public UCombatDamageGameplayEffect {
+  GENERATED_BODY()
+
+public:
+  UCombatDamageOverTimeGameplayEffect();
+};
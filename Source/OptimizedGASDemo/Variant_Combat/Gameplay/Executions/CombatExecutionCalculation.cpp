@@ -5,85 +5,204 @@
 #include "Attributes/StaminaAttributeSet.h"
 #include "Attributes/HealthAttributeSet.h"
 #include "AbilitySystemComponent.h"
-#include "CombatCharacter.h"
-#include "CombatPlayerState.h"
-#include "Gameplay/Data/CombatPawnData.h"
+#include "AbilitySystemGlobals.h"
+#include "Effects/CombatDamageGameplayEffect.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Execution"), STAT_CombatDamageExecution,
+                   STATGROUP_Combat);
+DECLARE_CYCLE_STAT(TEXT("Stamina Execution"), STAT_CombatStaminaExecution,
+                   STATGROUP_Combat);
+
+namespace {
+/** Capture definitions shared by every damage execution */
+struct FCombatDamageStatics {
+  FGameplayEffectAttributeCaptureDefinition DamageDef;
+  FGameplayEffectAttributeCaptureDefinition DamageMultiplierDef;
+
+  FCombatDamageStatics()
+      : DamageDef(UDamageAttributeSet::GetDamageAttribute(),
+                  EGameplayEffectAttributeCaptureSource::Source, true),
+        DamageMultiplierDef(UDamageAttributeSet::GetDamageMultiplierAttribute(),
+                            EGameplayEffectAttributeCaptureSource::Source,
+                            true) {}
+};
+
+const FCombatDamageStatics &DamageStatics() {
+  static FCombatDamageStatics Statics;
+  return Statics;
+}
+
+/** Capture definitions shared by every stamina execution */
+struct FCombatStaminaStatics {
+  FGameplayEffectAttributeCaptureDefinition StaminaUsedDef;
+  FGameplayEffectAttributeCaptureDefinition StaminaMultiplierDef;
+
+  FCombatStaminaStatics()
+      : StaminaUsedDef(UStaminaAttributeSet::GetStaminaUsedAttribute(),
+                       EGameplayEffectAttributeCaptureSource::Source, true),
+        StaminaMultiplierDef(
+            UStaminaAttributeSet::GetStaminaMultiplierAttribute(),
+            EGameplayEffectAttributeCaptureSource::Source, true) {}
+};
+
+const FCombatStaminaStatics &StaminaStatics() {
+  static FCombatStaminaStatics Statics;
+  return Statics;
+}
+
+/** Apply zero damage specs from one pawn to another pawn with a health set
+ * and log how many damage executions run per second, including spec
+ * application. Source and target differ so the multiplier capture runs */
+void BenchmarkDamageExecutions(const TArray<FString> &Args, UWorld *World) {
+  if (!World || World->GetNetMode() == NM_Client) {
+    return;
+  }
+
+  const int32 Count = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1)
+                                     : 10000;
+
+  UAbilitySystemComponent *SourceASC = nullptr;
+  UAbilitySystemComponent *TargetASC = nullptr;
+  for (TActorIterator<APawn> It(World); It && !TargetASC; ++It) {
+    UAbilitySystemComponent *PawnASC =
+        UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(*It);
+    if (!PawnASC || !PawnASC->HasAttributeSetForAttribute(
+                        UHealthAttributeSet::GetIncomingDamageAttribute())) {
+      continue;
+    }
+
+    if (!SourceASC) {
+      SourceASC = PawnASC;
+    } else if (PawnASC != SourceASC) {
+      TargetASC = PawnASC;
+    }
+  }
+
+  if (!TargetASC) {
+    UE_LOG(LogOptimizedGASDemo, Warning,
+           TEXT("Combat.BenchExecutions: needs two pawns with a health set"));
+    return;
+  }
+
+  // zero damage still runs the full execution but leaves health untouched
+  FGameplayEffectSpecHandle SpecHandle = SourceASC->MakeOutgoingSpec(
+      UCombatDamageGameplayEffect::StaticClass(), 1.0f,
+      SourceASC->MakeEffectContext());
+  SpecHandle.Data->SetSetByCallerMagnitude(
+      FGameplayTag::RequestGameplayTag(FName("Data.Damage")), 0.0f);
+
+  const double StartTime = FPlatformTime::Seconds();
+  for (int32 Index = 0; Index < Count; ++Index) {
+    SourceASC->ApplyGameplayEffectSpecToTarget(*SpecHandle.Data.Get(),
+                                               TargetASC);
+  }
+  const double Elapsed =
+      FMath::Max(FPlatformTime::Seconds() - StartTime, UE_SMALL_NUMBER);
+
+  UE_LOG(LogOptimizedGASDemo, Log,
+         TEXT("Combat.BenchExecutions: %d damage executions from %s to %s in "
+              "%.2fms, %.0f executions/s (%.2fus each)"),
+         Count, *GetNameSafe(SourceASC->GetAvatarActor()),
+         *GetNameSafe(TargetASC->GetAvatarActor()), Elapsed * 1000.0,
+         Count / Elapsed, Elapsed * 1.0e6 / Count);
+}
+
+FAutoConsoleCommandWithWorldAndArgs BenchExecutionsCommand(
+    TEXT("Combat.BenchExecutions"),
+    TEXT("Applies N zero damage specs from one pawn to another and logs "
+         "damage executions per second"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+        &BenchmarkDamageExecutions));
+} // namespace
 
 UCombatDamageExecutionCalculation::UCombatDamageExecutionCalculation() {
-  // Capture Damage attribute from source
-  RelevantAttributesToCapture.Add(FGameplayEffectAttributeCaptureDefinition(
-      UDamageAttributeSet::GetDamageAttribute(),
-      EGameplayEffectAttributeCaptureSource::Source, true));
+  // Capture damage and the pawn data multiplier from the source when the
+  // spec is created
+  RelevantAttributesToCapture.Add(DamageStatics().DamageDef);
+  RelevantAttributesToCapture.Add(DamageStatics().DamageMultiplierDef);
 }
 
 void UCombatDamageExecutionCalculation::Execute_Implementation(
     const FGameplayEffectCustomExecutionParameters &ExecutionParams,
     FGameplayEffectCustomExecutionOutput &OutExecutionOutput) const {
+  SCOPE_CYCLE_COUNTER(STAT_CombatDamageExecution);
+
+  // tags are resolved on first use, after the tag tables have loaded
+  static const FGameplayTag DamageTag =
+      FGameplayTag::RequestGameplayTag(FName("Data.Damage"));
+
   const FGameplayEffectSpec &Spec = ExecutionParams.GetOwningSpec();
+  const FAggregatorEvaluateParameters EvaluateParameters;
 
-  // Get damage value from source
-  float Damage = 0.0f;
-  ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(
-      FGameplayEffectAttributeCaptureDefinition(
-          UDamageAttributeSet::GetDamageAttribute(),
-          EGameplayEffectAttributeCaptureSource::Source, true),
-      FAggregatorEvaluateParameters(), Damage);
-
-  // Get multiplier from PawnData
-  float Multiplier = DamageMultiplier;
-  if (ACombatCharacter *CombatChar =
-          Cast<ACombatCharacter>(Spec.GetContext().GetInstigator())) {
-    if (ACombatPlayerState *PlayerState =
-            Cast<ACombatPlayerState>(CombatChar->GetPlayerState())) {
-      if (const UCombatPawnData *PawnData = PlayerState->GetPawnData()) {
-        Multiplier = PawnData->DamageMultiplier;
-      }
-    }
+  // Get damage value set by the attacker, falling back to the source's
+  // captured damage attribute
+  float Damage = Spec.GetSetByCallerMagnitude(DamageTag, false, -1.0f);
+  if (Damage < 0.0f) {
+    Damage = 0.0f;
+    ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(
+        DamageStatics().DamageDef, EvaluateParameters, Damage);
+  }
+
+  // Get multiplier captured from the source pawn data. Environmental damage
+  // is self-sourced and must not be scaled by the victim's own multiplier
+  const UAbilitySystemComponent *TargetASC =
+      ExecutionParams.GetTargetAbilitySystemComponent();
+  float Multiplier = 1.0f;
+  if (ExecutionParams.GetSourceAbilitySystemComponent() != TargetASC) {
+    ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(
+        DamageStatics().DamageMultiplierDef, EvaluateParameters, Multiplier);
   }
 
   // Apply multiplier
-  Damage *= Multiplier;
+  Damage *= Multiplier * DamageMultiplier;
+
+  // area damage is shared by every target, each scales it by its distance
+  // from the origin
+  const AActor *Target = TargetASC ? TargetASC->GetAvatarActor() : nullptr;
+  if (Target) {
+    Damage *= UCombatDamageGameplayEffect::GetFalloffMultiplier(
+        Spec, Target->GetActorLocation());
+  }
 
-  // Output health reduction (damage is negative for health)
-  OutExecutionOutput.AddOutputModifier(
-      FGameplayModifierEvaluatedData(UHealthAttributeSet::GetHealthAttribute(),
-                                     EGameplayModOp::Additive, -Damage));
+  // Output to the incoming damage meta attribute, the health set subtracts
+  // it from health and raises damage and death events
+  if (Damage > 0.0f) {
+    OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(
+        UHealthAttributeSet::GetIncomingDamageAttribute(),
+        EGameplayModOp::Additive, Damage));
+  }
 }
 
 UCombatStaminaExecutionCalculation::UCombatStaminaExecutionCalculation() {
-  // Capture StaminaUsed attribute from source
-  RelevantAttributesToCapture.Add(FGameplayEffectAttributeCaptureDefinition(
-      UStaminaAttributeSet::GetStaminaUsedAttribute(),
-      EGameplayEffectAttributeCaptureSource::Source, true));
+  // Capture stamina used and the pawn data multiplier from the source
+  RelevantAttributesToCapture.Add(StaminaStatics().StaminaUsedDef);
+  RelevantAttributesToCapture.Add(StaminaStatics().StaminaMultiplierDef);
 }
 
 void UCombatStaminaExecutionCalculation::Execute_Implementation(
     const FGameplayEffectCustomExecutionParameters &ExecutionParams,
     FGameplayEffectCustomExecutionOutput &OutExecutionOutput) const {
-  const FGameplayEffectSpec &Spec = ExecutionParams.GetOwningSpec();
+  SCOPE_CYCLE_COUNTER(STAT_CombatStaminaExecution);
+
+  const FAggregatorEvaluateParameters EvaluateParameters;
 
   // Get stamina used value from source
   float StaminaUsed = 0.0f;
   ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(
-      FGameplayEffectAttributeCaptureDefinition(
-          UStaminaAttributeSet::GetStaminaUsedAttribute(),
-          EGameplayEffectAttributeCaptureSource::Source, true),
-      FAggregatorEvaluateParameters(), StaminaUsed);
-
-  // Get multiplier from PawnData
-  float Multiplier = StaminaMultiplier;
-  if (ACombatCharacter *CombatChar =
-          Cast<ACombatCharacter>(Spec.GetContext().GetInstigator())) {
-    if (ACombatPlayerState *PlayerState =
-            Cast<ACombatPlayerState>(CombatChar->GetPlayerState())) {
-      if (const UCombatPawnData *PawnData = PlayerState->GetPawnData()) {
-        Multiplier = PawnData->StaminaMultiplier;
-      }
-    }
-  }
+      StaminaStatics().StaminaUsedDef, EvaluateParameters, StaminaUsed);
+
+  // Get multiplier captured from the source pawn data
+  float Multiplier = 1.0f;
+  ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(
+      StaminaStatics().StaminaMultiplierDef, EvaluateParameters, Multiplier);
 
   // Apply multiplier
-  StaminaUsed *= Multiplier;
+  StaminaUsed *= Multiplier * StaminaMultiplier;
 
   // Output stamina reduction
   OutExecutionOutput.AddOutputModifier(FGameplayModifierEvaluatedData(
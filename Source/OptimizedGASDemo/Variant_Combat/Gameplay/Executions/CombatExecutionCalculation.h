@@ -21,7 +21,7 @@ public:
       const FGameplayEffectCustomExecutionParameters &ExecutionParams,
       FGameplayEffectCustomExecutionOutput &OutExecutionOutput) const override;
 
-  /** Damage multiplier */
+  /** Damage multiplier, applied on top of the source's DamageMultiplier */
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage")
   float DamageMultiplier = 1.0f;
 };
@@ -41,7 +41,8 @@ public:
       const FGameplayEffectCustomExecutionParameters &ExecutionParams,
       FGameplayEffectCustomExecutionOutput &OutExecutionOutput) const override;
 
-  /** Stamina cost multiplier */
+  /** Stamina cost multiplier, applied on top of the source's
+   * StaminaMultiplier */
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stamina")
   float StaminaMultiplier = 1.0f;
 };
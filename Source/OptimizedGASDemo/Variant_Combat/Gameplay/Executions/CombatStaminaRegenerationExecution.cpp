@@ -2,61 +2,78 @@
 
 #include "CombatStaminaRegenerationExecution.h"
 #include "Attributes/StaminaAttributeSet.h"
-#include "AbilitySystemComponent.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Stamina Regeneration Execution"),
+                   STAT_CombatStaminaRegenerationExecution, STATGROUP_Combat);
+
+namespace {
+/** Capture definitions shared by every regeneration execution */
+struct FCombatStaminaRegenerationStatics {
+  FGameplayEffectAttributeCaptureDefinition StaminaDef;
+  FGameplayEffectAttributeCaptureDefinition MaxStaminaDef;
+
+  FCombatStaminaRegenerationStatics()
+      : StaminaDef(UStaminaAttributeSet::GetStaminaAttribute(),
+                   EGameplayEffectAttributeCaptureSource::Target, false),
+        MaxStaminaDef(UStaminaAttributeSet::GetMaxStaminaAttribute(),
+                      EGameplayEffectAttributeCaptureSource::Target, false) {}
+};
+
+const FCombatStaminaRegenerationStatics &RegenerationStatics() {
+  static FCombatStaminaRegenerationStatics Statics;
+  return Statics;
+}
+} // namespace
 
 UCombatStaminaRegenerationExecution::UCombatStaminaRegenerationExecution() {
   // Capture stamina and max stamina attributes
-  FGameplayEffectAttributeCaptureDefinition StaminaCapture(
-      UStaminaAttributeSet::GetStaminaAttribute(),
-      EGameplayEffectAttributeCaptureSource::Target, false);
-  RelevantAttributesToCapture.Add(StaminaCapture);
-
-  FGameplayEffectAttributeCaptureDefinition MaxStaminaCapture(
-      UStaminaAttributeSet::GetMaxStaminaAttribute(),
-      EGameplayEffectAttributeCaptureSource::Target, false);
-  RelevantAttributesToCapture.Add(MaxStaminaCapture);
+  RelevantAttributesToCapture.Add(RegenerationStatics().StaminaDef);
+  RelevantAttributesToCapture.Add(RegenerationStatics().MaxStaminaDef);
 }
 
 void UCombatStaminaRegenerationExecution::Execute_Implementation(
     const FGameplayEffectCustomExecutionParameters &ExecutionParams,
     FGameplayEffectCustomExecutionOutput &OutExecutionOutput) const {
+  SCOPE_CYCLE_COUNTER(STAT_CombatStaminaRegenerationExecution);
+
+  // tags are resolved on first use, after the tag tables have loaded
+  static const FGameplayTag AttackingTag =
+      FGameplayTag::RequestGameplayTag(FName("State.Attacking"));
+  static const FGameplayTag RegenRateTag =
+      FGameplayTag::RequestGameplayTag(FName("Data.StaminaRegenRate"));
 
   const FGameplayEffectSpec &Spec = ExecutionParams.GetOwningSpec();
+  const FCombatStaminaRegenerationStatics &Statics = RegenerationStatics();
 
-  // Get the ability system component
-  UAbilitySystemComponent *ASC =
-      ExecutionParams.GetTargetAbilitySystemComponent();
+  // Don't regenerate if attacking. Target tags are recaptured before each
+  // periodic execution
+  const FGameplayTagContainer *TargetTags =
+      Spec.CapturedTargetTags.GetAggregatedTags();
+  if (TargetTags && TargetTags->HasTag(AttackingTag)) {
+    return;
+  }
+
+  FAggregatorEvaluateParameters EvaluateParameters;
+  EvaluateParameters.TargetTags = TargetTags;
 
   // Get current stamina and max stamina
   float CurrentStamina = 0.0f;
-  FGameplayEffectAttributeCaptureDefinition StaminaCapture(
-      UStaminaAttributeSet::GetStaminaAttribute(),
-      EGameplayEffectAttributeCaptureSource::Target, false);
   ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(
-      StaminaCapture, FAggregatorEvaluateParameters(), CurrentStamina);
+      Statics.StaminaDef, EvaluateParameters, CurrentStamina);
 
   float MaxStamina = 0.0f;
-  FGameplayEffectAttributeCaptureDefinition MaxStaminaCapture(
-      UStaminaAttributeSet::GetMaxStaminaAttribute(),
-      EGameplayEffectAttributeCaptureSource::Target, false);
   ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(
-      MaxStaminaCapture, FAggregatorEvaluateParameters(), MaxStamina);
+      Statics.MaxStaminaDef, EvaluateParameters, MaxStamina);
 
   // Don't regenerate if already at max
   if (CurrentStamina >= MaxStamina) {
     return;
   }
 
-  // Don't regenerate if attacking
-  if (ASC->HasMatchingGameplayTag(
-          FGameplayTag::RequestGameplayTag(FName("State.Attacking")))) {
-    return;
-  }
-
   // Get the regeneration amount from SetByCaller
-  float RegenAmount = Spec.GetSetByCallerMagnitude(
-      FGameplayTag::RequestGameplayTag(FName("Data.StaminaRegenRate")), true,
-      0.0f);
+  float RegenAmount =
+      Spec.GetSetByCallerMagnitude(RegenRateTag, true, 0.0f);
 
   // Calculate new stamina, but don't exceed max
   float NewStamina = FMath::Min(CurrentStamina + RegenAmount, MaxStamina);
@@ -33,4 +33,7 @@ public:
 	/** Deactivates the Interactable Actor */
 	UFUNCTION(BlueprintCallable, Category="Activatable")
 	virtual void DeactivateInteraction(AActor* ActivationInstigator) = 0;
+
+	/** Called ahead of activation so the Interactable Actor can start loading the assets it will need */
+	virtual void PreloadInteraction(AActor* ActivationInstigator) {}
 };
@@ -0,0 +1,218 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatDamageZoneSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "CombatDamageable.h"
+#include "Effects/CombatDamageGameplayEffect.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Zone Fallback"), STAT_CombatDamageZoneFallback,
+                   STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Damage Zone Occupants"),
+                               STAT_CombatDamageZoneOccupants,
+                               STATGROUP_Combat);
+
+namespace {
+TAutoConsoleVariable<float> CVarDamageZoneFallbackInterval(
+    TEXT("Combat.DamageZone.FallbackInterval"), 0.5f,
+    TEXT("Seconds between damage zone hits on actors without an ability "
+         "system"));
+} // namespace
+
+bool UCombatDamageZoneSubsystem::DoesSupportWorldType(
+    const EWorldType::Type WorldType) const {
+  return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatDamageZoneSubsystem::Deinitialize() {
+  Occupants.Reset();
+  Super::Deinitialize();
+}
+
+void UCombatDamageZoneSubsystem::EnterZone(
+    AActor *Zone, AActor *Occupant, TSubclassOf<UGameplayEffect> EffectClass,
+    float Damage) {
+  // damage is server authoritative, clients only see the replicated health
+  if (!Zone || !Occupant || !Zone->HasAuthority() ||
+      !Occupant->Implements<UCombatDamageable>()) {
+    return;
+  }
+
+  FOccupant *Entry = FindOccupant(Occupant);
+  if (!Entry) {
+    Entry = &Occupants.AddDefaulted_GetRef();
+    Entry->Actor = Occupant;
+    Entry->ASC =
+        UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Occupant);
+  }
+
+  // an actor overlapping with several components enters once
+  if (Entry->Contacts.ContainsByPredicate(
+          [Zone](const FZoneContact &Contact) {
+            return Contact.Zone == Zone;
+          })) {
+    return;
+  }
+
+  FZoneContact &Contact = Entry->Contacts.AddDefaulted_GetRef();
+  Contact.Zone = Zone;
+  Contact.EffectClass = EffectClass;
+  Contact.Damage = Damage;
+
+  RefreshEffect(*Entry);
+  Compact();
+}
+
+void UCombatDamageZoneSubsystem::LeaveZone(AActor *Zone, AActor *Occupant) {
+  FOccupant *Entry = FindOccupant(Occupant);
+  if (!Entry) {
+    return;
+  }
+
+  Entry->Contacts.RemoveAllSwap(
+      [Zone](const FZoneContact &Contact) { return Contact.Zone == Zone; });
+
+  RefreshEffect(*Entry);
+  Compact();
+}
+
+void UCombatDamageZoneSubsystem::RemoveZone(AActor *Zone) {
+  for (FOccupant &Entry : Occupants) {
+    const int32 NumRemoved = Entry.Contacts.RemoveAllSwap(
+        [Zone](const FZoneContact &Contact) { return Contact.Zone == Zone; });
+    if (NumRemoved > 0) {
+      RefreshEffect(Entry);
+    }
+  }
+
+  Compact();
+}
+
+UCombatDamageZoneSubsystem::FOccupant *
+UCombatDamageZoneSubsystem::FindOccupant(const AActor *Actor) {
+  return Occupants.FindByPredicate(
+      [Actor](const FOccupant &Entry) { return Entry.Actor == Actor; });
+}
+
+const UCombatDamageZoneSubsystem::FZoneContact *
+UCombatDamageZoneSubsystem::GetStrongestContact(const FOccupant &Occupant) {
+  const FZoneContact *Strongest = nullptr;
+  for (const FZoneContact &Contact : Occupant.Contacts) {
+    if (Contact.Zone.IsValid() &&
+        (!Strongest || Contact.Damage > Strongest->Damage)) {
+      Strongest = &Contact;
+    }
+  }
+
+  return Strongest;
+}
+
+void UCombatDamageZoneSubsystem::RefreshEffect(FOccupant &Occupant) {
+  UAbilitySystemComponent *ASC = Occupant.ASC.Get();
+  if (!ASC) {
+    return;
+  }
+
+  const FZoneContact *Strongest = GetStrongestContact(Occupant);
+  if (Strongest && Strongest->Zone == Occupant.EffectZone &&
+      Occupant.EffectHandle.IsValid()) {
+    // already taking damage from this zone
+    return;
+  }
+
+  RemoveEffect(Occupant);
+  if (!Strongest || !Strongest->EffectClass) {
+    return;
+  }
+
+  // the occupant is its own source, as for any other non-GAS damage, and
+  // the zone is recorded as the causer
+  AActor *Zone = Strongest->Zone.Get();
+  FHitResult HitResult;
+  HitResult.ImpactPoint = Occupant.Actor.IsValid()
+                              ? Occupant.Actor->GetActorLocation()
+                              : Zone->GetActorLocation();
+
+  FGameplayEffectSpecHandle SpecHandle =
+      UCombatDamageGameplayEffect::MakeDamageSpec(
+          ASC, Strongest->EffectClass, Strongest->Damage, HitResult, 0.0f,
+          0.0f, Zone, Zone);
+  if (SpecHandle.IsValid()) {
+    Occupant.EffectHandle =
+        ASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
+    Occupant.EffectZone = Zone;
+  }
+}
+
+void UCombatDamageZoneSubsystem::RemoveEffect(FOccupant &Occupant) {
+  if (Occupant.EffectHandle.IsValid()) {
+    if (UAbilitySystemComponent *ASC = Occupant.ASC.Get()) {
+      ASC->RemoveActiveGameplayEffect(Occupant.EffectHandle);
+    }
+  }
+
+  Occupant.EffectHandle.Invalidate();
+  Occupant.EffectZone.Reset();
+}
+
+void UCombatDamageZoneSubsystem::Compact() {
+  Occupants.RemoveAllSwap([](FOccupant &Entry) {
+    if (Entry.Actor.IsValid() && GetStrongestContact(Entry)) {
+      return false;
+    }
+
+    RemoveEffect(Entry);
+    return true;
+  });
+
+  SET_DWORD_STAT(STAT_CombatDamageZoneOccupants, Occupants.Num());
+
+  // the shared timer only runs while a non-GAS damageable is in a zone
+  const bool bNeedsFallback = Occupants.ContainsByPredicate(
+      [](const FOccupant &Entry) { return !Entry.ASC.IsValid(); });
+
+  UCombatTimerSubsystem *Timers =
+      GetWorld()->GetSubsystem<UCombatTimerSubsystem>();
+  if (!Timers) {
+    return;
+  }
+
+  if (bNeedsFallback && !Timers->IsTimerActive(FallbackTimer)) {
+    Timers->SetTimer(FallbackTimer, this,
+                     &UCombatDamageZoneSubsystem::ApplyFallbackDamage,
+                     CVarDamageZoneFallbackInterval.GetValueOnGameThread(),
+                     true);
+  } else if (!bNeedsFallback) {
+    Timers->ClearTimer(FallbackTimer);
+  }
+}
+
+void UCombatDamageZoneSubsystem::ApplyFallbackDamage() {
+  SCOPE_CYCLE_COUNTER(STAT_CombatDamageZoneFallback);
+
+  // damage can destroy the occupant, so gather the hits first
+  TArray<TPair<TWeakObjectPtr<AActor>, FZoneContact>> Hits;
+  for (const FOccupant &Entry : Occupants) {
+    if (Entry.ASC.IsValid()) {
+      continue;
+    }
+
+    if (const FZoneContact *Strongest = GetStrongestContact(Entry)) {
+      Hits.Emplace(Entry.Actor, *Strongest);
+    }
+  }
+
+  for (const TPair<TWeakObjectPtr<AActor>, FZoneContact> &Hit : Hits) {
+    AActor *Actor = Hit.Key.Get();
+    ICombatDamageable *Damageable = Cast<ICombatDamageable>(Actor);
+    if (Damageable && Hit.Value.Zone.IsValid()) {
+      Damageable->ApplyDamage(Hit.Value.Damage, Hit.Value.Zone.Get(),
+                              Actor->GetActorLocation(), FVector::ZeroVector);
+    }
+  }
+
+  Compact();
+}
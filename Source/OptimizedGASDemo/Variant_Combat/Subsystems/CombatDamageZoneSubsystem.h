@@ -0,0 +1,93 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActiveGameplayEffectHandle.h"
+#include "CombatTimerSubsystem.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatDamageZoneSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayEffect;
+
+/**
+ * Server-side damage-over-time for zones such as lava. Zones report occupants
+ * on begin and end overlap. Each occupant with an ability system gets one
+ * periodic damage effect from the strongest zone it stands in, so the damage
+ * rate is set by the effect period instead of by contact events. Damageables
+ * without an ability system are damaged from one shared timer.
+ */
+UCLASS()
+class UCombatDamageZoneSubsystem : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /** Start damaging an actor that entered a zone. Damage is dealt per period
+   * of the effect class */
+  void EnterZone(AActor *Zone, AActor *Occupant,
+                 TSubclassOf<UGameplayEffect> EffectClass, float Damage);
+
+  /** Stop damaging an actor that left a zone */
+  void LeaveZone(AActor *Zone, AActor *Occupant);
+
+  /** Release every occupant of a zone that is being removed */
+  void RemoveZone(AActor *Zone);
+
+protected:
+  // ~begin USubsystem interface
+  virtual void Deinitialize() override;
+  // ~end USubsystem interface
+
+  // ~begin UWorldSubsystem interface
+  virtual bool DoesSupportWorldType(
+      const EWorldType::Type WorldType) const override;
+  // ~end UWorldSubsystem interface
+
+  /** Damage occupants without an ability system */
+  void ApplyFallbackDamage();
+
+private:
+  /** A zone an occupant is standing in */
+  struct FZoneContact {
+    TWeakObjectPtr<AActor> Zone;
+    TSubclassOf<UGameplayEffect> EffectClass;
+    float Damage = 0.0f;
+  };
+
+  /** An actor standing in one or more zones */
+  struct FOccupant {
+    TWeakObjectPtr<AActor> Actor;
+
+    /** Ability system the damage effect is applied to, if any. Kept so the
+     * effect can be removed after the avatar is gone */
+    TWeakObjectPtr<UAbilitySystemComponent> ASC;
+
+    TArray<FZoneContact> Contacts;
+
+    /** Periodic damage effect and the zone it was applied for */
+    FActiveGameplayEffectHandle EffectHandle;
+    TWeakObjectPtr<AActor> EffectZone;
+  };
+
+  /** Find the entry for an actor */
+  FOccupant *FindOccupant(const AActor *Actor);
+
+  /** Strongest zone the occupant stands in, or null */
+  static const FZoneContact *GetStrongestContact(const FOccupant &Occupant);
+
+  /** Apply or swap the periodic effect to match the strongest zone */
+  static void RefreshEffect(FOccupant &Occupant);
+
+  /** Remove the periodic effect */
+  static void RemoveEffect(FOccupant &Occupant);
+
+  /** Drop occupants that left every zone and update the fallback timer */
+  void Compact();
+
+  /** Current occupants */
+  TArray<FOccupant> Occupants;
+
+  /** Timer driving ApplyFallbackDamage */
+  FCombatTimerHandle FallbackTimer;
+};
@@ -0,0 +1,169 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatDamageablePropSubsystem.h"
+#include "CombatDamageable.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Prop Damage"), STAT_CombatPropDamage,
+                   STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Props"),
+                               STAT_CombatRegisteredProps, STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Prop Hits Applied"),
+                               STAT_CombatPropHits, STATGROUP_Combat);
+
+bool UCombatDamageablePropSubsystem::DoesSupportWorldType(
+    const EWorldType::Type WorldType) const {
+  return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UCombatDamageablePropSubsystem::IsTickable() const {
+  return PendingSlots.Num() > 0 && Super::IsTickable();
+}
+
+TStatId UCombatDamageablePropSubsystem::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatDamageablePropSubsystem,
+                                  STATGROUP_Tickables);
+}
+
+void UCombatDamageablePropSubsystem::Tick(float DeltaTime) {
+  Super::Tick(DeltaTime);
+  FlushDamage();
+}
+
+FCombatPropHandle UCombatDamageablePropSubsystem::RegisterProp(
+    AActor *Prop, float InMaxHealth, float InResistance, FGenericTeamId Team) {
+  FCombatPropHandle Handle;
+  if (!Prop) {
+    return Handle;
+  }
+
+  if (FreeSlots.Num() > 0) {
+    Handle.Index = FreeSlots.Pop(EAllowShrinking::No);
+  } else {
+    Handle.Index = Props.AddDefaulted();
+    Health.AddDefaulted();
+    MaxHealth.AddDefaulted();
+    Resistance.AddDefaulted();
+    Teams.AddDefaulted();
+    Serials.AddDefaulted();
+  }
+
+  Handle.Serial = NextSerial++;
+
+  const int32 Slot = Handle.Index;
+  Props[Slot] = Prop;
+  Health[Slot] = InMaxHealth;
+  MaxHealth[Slot] = InMaxHealth;
+  Resistance[Slot] = FMath::Clamp(InResistance, 0.0f, 1.0f);
+  Teams[Slot] = Team;
+  Serials[Slot] = Handle.Serial;
+
+  SET_DWORD_STAT(STAT_CombatRegisteredProps, Props.Num() - FreeSlots.Num());
+  return Handle;
+}
+
+void UCombatDamageablePropSubsystem::UnregisterProp(
+    FCombatPropHandle &Handle) {
+  if (IsRegistered(Handle)) {
+    const int32 Slot = Handle.Index;
+    Props[Slot].Reset();
+    Health[Slot] = 0.0f;
+    Serials[Slot] = 0;
+    FreeSlots.Add(Slot);
+
+    SET_DWORD_STAT(STAT_CombatRegisteredProps, Props.Num() - FreeSlots.Num());
+  }
+
+  Handle = FCombatPropHandle();
+}
+
+bool UCombatDamageablePropSubsystem::IsRegistered(
+    const FCombatPropHandle &Handle) const {
+  return Serials.IsValidIndex(Handle.Index) &&
+         Serials[Handle.Index] == Handle.Serial;
+}
+
+void UCombatDamageablePropSubsystem::QueueDamage(
+    const FCombatPropHandle &Handle, float Damage, AActor *DamageCauser) {
+  if (Damage <= 0.0f || !IsAlive(Handle)) {
+    return;
+  }
+
+  // props ignore hits from their own team
+  const FGenericTeamId Team = Teams[Handle.Index];
+  if (Team != FGenericTeamId::NoTeam &&
+      Team == FGenericTeamId::GetTeamIdentifier(DamageCauser)) {
+    return;
+  }
+
+  PendingSlots.Add(Handle.Index);
+  PendingSerials.Add(Handle.Serial);
+  PendingDamage.Add(Damage);
+  PendingCausers.Add(DamageCauser);
+}
+
+void UCombatDamageablePropSubsystem::ResetHealth(
+    const FCombatPropHandle &Handle) {
+  if (IsRegistered(Handle)) {
+    Health[Handle.Index] = MaxHealth[Handle.Index];
+  }
+}
+
+float UCombatDamageablePropSubsystem::GetHealth(
+    const FCombatPropHandle &Handle) const {
+  return IsRegistered(Handle) ? Health[Handle.Index] : 0.0f;
+}
+
+bool UCombatDamageablePropSubsystem::IsAlive(
+    const FCombatPropHandle &Handle) const {
+  return GetHealth(Handle) > 0.0f;
+}
+
+void UCombatDamageablePropSubsystem::FlushDamage() {
+  SCOPE_CYCLE_COUNTER(STAT_CombatPropDamage);
+
+  const int32 NumHits = PendingSlots.Num();
+  SET_DWORD_STAT(STAT_CombatPropHits, NumHits);
+
+  // apply every hit in one pass over the flat arrays, collecting the hits
+  // that took a prop to zero
+  TArray<int32, TInlineAllocator<16>> KillingHits;
+  for (int32 Hit = 0; Hit < NumHits; ++Hit) {
+    const int32 Slot = PendingSlots[Hit];
+    if (Serials[Slot] != PendingSerials[Hit] || Health[Slot] <= 0.0f) {
+      continue;
+    }
+
+    Health[Slot] -= PendingDamage[Hit] * (1.0f - Resistance[Slot]);
+    if (Health[Slot] <= 0.0f) {
+      Health[Slot] = 0.0f;
+      KillingHits.Add(Hit);
+    }
+  }
+
+  // death handlers may destroy or register props, so copy what they need
+  TArray<TPair<TWeakObjectPtr<AActor>, TWeakObjectPtr<AActor>>,
+         TInlineAllocator<16>>
+      Deaths;
+  for (const int32 Hit : KillingHits) {
+    Deaths.Emplace(Props[PendingSlots[Hit]], PendingCausers[Hit]);
+  }
+
+  PendingSlots.Reset();
+  PendingSerials.Reset();
+  PendingDamage.Reset();
+  PendingCausers.Reset();
+
+  for (const TPair<TWeakObjectPtr<AActor>, TWeakObjectPtr<AActor>> &Death :
+       Deaths) {
+    AActor *Prop = Death.Key.Get();
+    if (!Prop) {
+      continue;
+    }
+
+    OnPropDied.Broadcast(Prop, Death.Value.Get());
+    if (ICombatDamageable *Damageable = Cast<ICombatDamageable>(Prop)) {
+      Damageable->HandleDeath();
+    }
+  }
+}
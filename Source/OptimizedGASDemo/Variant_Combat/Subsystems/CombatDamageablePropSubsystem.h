@@ -0,0 +1,97 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericTeamAgentInterface.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatDamageablePropSubsystem.generated.h"
+
+/** Handle to a prop registered with UCombatDamageablePropSubsystem */
+struct FCombatPropHandle {
+  int32 Index = INDEX_NONE;
+  uint32 Serial = 0;
+
+  bool IsValid() const { return Index != INDEX_NONE; }
+};
+
+/** Raised when a prop runs out of health, with the prop and damage causer */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FCombatPropDied, AActor *, AActor *);
+
+/**
+ * Health for damageable props without an ability system. Health, resistance
+ * and team are kept in flat arrays indexed by handle. Props queue hits from
+ * ICombatDamageable::ApplyDamage and the queue is applied in one pass at the
+ * next tick, calling HandleDeath on props that ran out of health.
+ */
+UCLASS()
+class UCombatDamageablePropSubsystem : public UTickableWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  // ~begin FTickableGameObject interface
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+  virtual bool IsTickable() const override;
+  // ~end FTickableGameObject interface
+
+  /** Add a prop at full health. Resistance is the fraction of damage ignored,
+   * hits from its own team are ignored */
+  FCombatPropHandle RegisterProp(AActor *Prop, float MaxHealth,
+                                 float Resistance = 0.0f,
+                                 FGenericTeamId Team = FGenericTeamId::NoTeam);
+
+  /** Remove a prop and reset its handle */
+  void UnregisterProp(FCombatPropHandle &Handle);
+
+  /** Queue a hit, applied at the next tick */
+  void QueueDamage(const FCombatPropHandle &Handle, float Damage,
+                   AActor *DamageCauser);
+
+  /** Restore a prop to full health */
+  void ResetHealth(const FCombatPropHandle &Handle);
+
+  /** Current health, or zero for invalid handles */
+  float GetHealth(const FCombatPropHandle &Handle) const;
+
+  /** Whether the handle is registered and has health left */
+  bool IsAlive(const FCombatPropHandle &Handle) const;
+
+  /** Raised for every prop that runs out of health */
+  FCombatPropDied OnPropDied;
+
+protected:
+  // ~begin UWorldSubsystem interface
+  virtual bool DoesSupportWorldType(
+      const EWorldType::Type WorldType) const override;
+  // ~end UWorldSubsystem interface
+
+  /** Apply all queued hits and raise deaths */
+  void FlushDamage();
+
+  /** Whether the handle refers to a live slot */
+  bool IsRegistered(const FCombatPropHandle &Handle) const;
+
+private:
+  // registered props, one entry per slot
+  TArray<TWeakObjectPtr<AActor>> Props;
+  TArray<float> Health;
+  TArray<float> MaxHealth;
+  TArray<float> Resistance;
+  TArray<FGenericTeamId> Teams;
+
+  /** Bumped when a slot is reused so stale handles are rejected */
+  TArray<uint32> Serials;
+
+  /** Slots free for reuse */
+  TArray<int32> FreeSlots;
+
+  // queued hits
+  TArray<int32> PendingSlots;
+  TArray<uint32> PendingSerials;
+  TArray<float> PendingDamage;
+  TArray<TWeakObjectPtr<AActor>> PendingCausers;
+
+  /** Serial handed to the next registered prop */
+  uint32 NextSerial = 1;
+};
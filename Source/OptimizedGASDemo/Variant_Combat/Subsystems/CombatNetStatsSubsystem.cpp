@@ -0,0 +1,281 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatNetStatsSubsystem.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemInterface.h"
+#include "CombatBase.h"
+#include "AI/CombatEnemy.h"
+#include "CoreGlobals.h"
+#include "Abilities/GameplayAbility.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "OptimizedGASDemo.h"
+#include "Serialization/ArchiveCountMem.h"
+
+namespace {
+/** Running totals for one kind of combatant */
+struct FCombatFootprint {
+  int32 Count = 0;
+  int64 ActorBytes = 0;
+  int64 ComponentBytes = 0;
+  int64 AbilitySystemBytes = 0;
+  int32 TickFunctions = 0;
+};
+
+/** Memory used by the object itself, as reported by obj list */
+int64 GetObjectBytes(UObject *Object) {
+  if (!Object) {
+    return 0;
+  }
+
+  FArchiveCountMem Count(Object);
+  return Count.GetMax();
+}
+
+/** Add the actor, its components and its ability system to the footprint */
+void AccumulateFootprint(ACombatBase *Combatant, FCombatFootprint &Footprint) {
+  ++Footprint.Count;
+  Footprint.ActorBytes += GetObjectBytes(Combatant);
+  if (Combatant->PrimaryActorTick.IsTickFunctionEnabled()) {
+    ++Footprint.TickFunctions;
+  }
+
+  for (UActorComponent *Component : Combatant->GetComponents()) {
+    Footprint.ComponentBytes += GetObjectBytes(Component);
+    if (Component && Component->IsRegistered() &&
+        Component->PrimaryComponentTick.IsTickFunctionEnabled()) {
+      ++Footprint.TickFunctions;
+    }
+  }
+
+  // players keep their ASC on the player state, so count it separately
+  UAbilitySystemComponent *ASC = Combatant->GetAbilitySystemComponent();
+  if (!ASC) {
+    return;
+  }
+
+  if (ASC->GetOwner() != Combatant) {
+    Footprint.AbilitySystemBytes += GetObjectBytes(ASC);
+  }
+
+  for (UAttributeSet *AttributeSet : ASC->GetSpawnedAttributes()) {
+    Footprint.AbilitySystemBytes += GetObjectBytes(AttributeSet);
+  }
+
+  for (const FGameplayAbilitySpec &Spec : ASC->GetActivatableAbilities()) {
+    for (UGameplayAbility *Instance : Spec.GetAbilityInstances()) {
+      Footprint.AbilitySystemBytes += GetObjectBytes(Instance);
+    }
+  }
+}
+
+/** Log one footprint line */
+void LogFootprint(const TCHAR *Label, const FCombatFootprint &Footprint) {
+  if (Footprint.Count == 0) {
+    return;
+  }
+
+  const double Count = Footprint.Count;
+  UE_LOG(LogOptimizedGASDemo, Log,
+         TEXT("CombatFootprint: %d %s, per combatant %.1f KB (actor %.1f, "
+              "components %.1f, GAS %.1f), %.1f tick functions"),
+         Footprint.Count, Label,
+         (Footprint.ActorBytes + Footprint.ComponentBytes +
+          Footprint.AbilitySystemBytes) /
+             Count / 1024.0,
+         Footprint.ActorBytes / Count / 1024.0,
+         Footprint.ComponentBytes / Count / 1024.0,
+         Footprint.AbilitySystemBytes / Count / 1024.0,
+         Footprint.TickFunctions / Count);
+}
+
+FAutoConsoleCommandWithWorld CombatFootprintCommand(
+    TEXT("Combat.Footprint"),
+    TEXT("Logs average memory and tick function count per combatant"),
+    FConsoleCommandWithWorldDelegate::CreateStatic(
+        &UCombatNetStatsSubsystem::ReportCombatantFootprint));
+} // namespace
+
+bool UCombatNetStatsSubsystem::ShouldCreateSubsystem(UObject *Outer) const {
+  if (!Super::ShouldCreateSubsystem(Outer)) {
+    return false;
+  }
+
+  return FParse::Param(FCommandLine::Get(), TEXT("CombatNetStats"));
+}
+
+void UCombatNetStatsSubsystem::OnWorldBeginPlay(UWorld &InWorld) {
+  Super::OnWorldBeginPlay(InWorld);
+
+  // only servers own the connections we want to report on
+  const ENetMode NetMode = InWorld.GetNetMode();
+  bEnabled = InWorld.IsGameWorld() &&
+             (NetMode == NM_DedicatedServer || NetMode == NM_ListenServer);
+
+  FParse::Value(FCommandLine::Get(), TEXT("CombatNetStatsInterval="),
+                ReportInterval);
+  ReportInterval = FMath::Max(ReportInterval, 1.0f);
+
+  if (bEnabled) {
+    UE_LOG(LogOptimizedGASDemo, Log,
+           TEXT("CombatNetStats: reporting every %.1fs (%s)"), ReportInterval,
+           NetMode == NM_DedicatedServer ? TEXT("dedicated") : TEXT("listen"));
+  }
+}
+
+void UCombatNetStatsSubsystem::Deinitialize() {
+  for (const TPair<TWeakObjectPtr<UAbilitySystemComponent>, FDelegateHandle>
+           &Pair : BoundAbilitySystems) {
+    if (UAbilitySystemComponent *ASC = Pair.Key.Get()) {
+      ASC->AbilityActivatedCallbacks.Remove(Pair.Value);
+    }
+  }
+  BoundAbilitySystems.Empty();
+
+  Super::Deinitialize();
+}
+
+bool UCombatNetStatsSubsystem::IsTickable() const {
+  return bEnabled && Super::IsTickable();
+}
+
+TStatId UCombatNetStatsSubsystem::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatNetStatsSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatNetStatsSubsystem::Tick(float DeltaTime) {
+  Super::Tick(DeltaTime);
+
+  // GGameThreadTime covers the previous frame's game thread work, which is
+  // the server tick cost independent of the fixed server tick rate
+  const double GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+
+  WindowTime += DeltaTime;
+  ++WindowFrames;
+  WindowGameThreadMs += GameThreadMs;
+  WindowMaxGameThreadMs = FMath::Max(WindowMaxGameThreadMs, GameThreadMs);
+
+  // pick up players that joined since the last frame
+  BindPlayerAbilitySystems();
+
+  if (WindowTime >= ReportInterval) {
+    Report();
+  }
+}
+
+void UCombatNetStatsSubsystem::BindPlayerAbilitySystems() {
+  AGameStateBase *GameState = GetWorld()->GetGameState();
+  if (!GameState ||
+      GameState->PlayerArray.Num() == BoundAbilitySystems.Num()) {
+    return;
+  }
+
+  for (APlayerState *PS : GameState->PlayerArray) {
+    IAbilitySystemInterface *ASI = Cast<IAbilitySystemInterface>(PS);
+    UAbilitySystemComponent *ASC =
+        ASI ? ASI->GetAbilitySystemComponent() : nullptr;
+    if (!ASC || BoundAbilitySystems.Contains(ASC)) {
+      continue;
+    }
+
+    BoundAbilitySystems.Add(
+        ASC, ASC->AbilityActivatedCallbacks.AddUObject(
+                 this, &UCombatNetStatsSubsystem::HandleAbilityActivated));
+  }
+}
+
+void UCombatNetStatsSubsystem::HandleAbilityActivated(
+    UGameplayAbility *Ability) {
+  // attribute the activation to the connection that owns the ASC
+  const FGameplayAbilityActorInfo *ActorInfo =
+      Ability ? Ability->GetCurrentActorInfo() : nullptr;
+  APlayerController *PC =
+      ActorInfo ? ActorInfo->PlayerController.Get() : nullptr;
+  if (UNetConnection *Connection = PC ? PC->GetNetConnection() : nullptr) {
+    ++ActivationsPerConnection.FindOrAdd(Connection);
+  }
+}
+
+void UCombatNetStatsSubsystem::Report() {
+  UNetDriver *NetDriver = GetWorld()->GetNetDriver();
+  const int32 NumConnections =
+      NetDriver ? NetDriver->ClientConnections.Num() : 0;
+
+  UE_LOG(LogOptimizedGASDemo, Log,
+         TEXT("CombatNetStats: %d connections, %.1f Hz, game thread avg "
+              "%.2fms max %.2fms"),
+         NumConnections, WindowFrames / WindowTime,
+         WindowGameThreadMs / FMath::Max(WindowFrames, 1),
+         WindowMaxGameThreadMs);
+
+  if (NetDriver) {
+    for (UNetConnection *Connection : NetDriver->ClientConnections) {
+      if (!Connection) {
+        continue;
+      }
+
+      // activations from remote clients arrive as ServerTryActivateAbility
+      // RPCs, so this tracks the GAS RPC rate for each connection
+      const int32 *Activations = ActivationsPerConnection.Find(Connection);
+
+      UE_LOG(LogOptimizedGASDemo, Log,
+             TEXT("CombatNetStats:   %s in %d B/s (%d pkt/s) out %d B/s "
+                  "(%d pkt/s) ability RPCs %.1f/s ping %.0fms"),
+             *Connection->LowLevelGetRemoteAddress(true),
+             Connection->InBytesPerSecond, Connection->InPacketsPerSecond,
+             Connection->OutBytesPerSecond, Connection->OutPacketsPerSecond,
+             (Activations ? *Activations : 0) / WindowTime,
+             Connection->AvgLag * 1000.0f);
+    }
+  }
+
+  ReportCombatantFootprint(GetWorld());
+
+  WindowTime = 0.0f;
+  WindowFrames = 0;
+  WindowGameThreadMs = 0.0;
+  WindowMaxGameThreadMs = 0.0;
+  ActivationsPerConnection.Reset();
+}
+
+void UCombatNetStatsSubsystem::ReportCombatantFootprint(UWorld *World) {
+  if (!World) {
+    return;
+  }
+
+  FCombatFootprint Players;
+  FCombatFootprint Enemies;
+  TSet<const UCombatPawnData *> SharedPawnData;
+  for (TActorIterator<ACombatBase> It(World); It; ++It) {
+    AccumulateFootprint(*It, It->IsA<ACombatEnemy>() ? Enemies : Players);
+    SharedPawnData.Add(It->GetPawnData());
+  }
+
+  LogFootprint(TEXT("players"), Players);
+  LogFootprint(TEXT("enemies"), Enemies);
+
+  // pawn data is shared per archetype, compare against one copy per actor
+  int64 PawnDataBytes = 0;
+  for (const UCombatPawnData *Data : SharedPawnData) {
+    PawnDataBytes += GetObjectBytes(const_cast<UCombatPawnData *>(Data));
+  }
+
+  const int32 NumCombatants = Players.Count + Enemies.Count;
+  if (SharedPawnData.Num() > 0) {
+    const double AverageBytes =
+        static_cast<double>(PawnDataBytes) / SharedPawnData.Num();
+    UE_LOG(LogOptimizedGASDemo, Log,
+           TEXT("CombatFootprint: %d shared pawn data assets use %.1f KB, "
+                "per-actor copies would use %.1f KB for %d combatants"),
+           SharedPawnData.Num(), PawnDataBytes / 1024.0,
+           AverageBytes * NumCombatants / 1024.0, NumCombatants);
+  }
+}
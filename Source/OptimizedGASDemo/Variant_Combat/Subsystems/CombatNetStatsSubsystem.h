@@ -0,0 +1,77 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatNetStatsSubsystem.generated.h"
+
+class UAbilitySystemComponent;
+class UGameplayAbility;
+class UNetConnection;
+
+/**
+ * Server-side load test reporter. Enabled with -CombatNetStats on a dedicated
+ * or listen server and periodically logs game thread tick time, per-connection
+ * bandwidth, client-driven ability activation rates and per-combatant memory.
+ */
+UCLASS()
+class UCombatNetStatsSubsystem : public UTickableWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  // ~begin USubsystem interface
+  virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+  virtual void Deinitialize() override;
+  // ~end USubsystem interface
+
+  // ~begin FTickableGameObject interface
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+  virtual bool IsTickable() const override;
+  // ~end FTickableGameObject interface
+
+  /** Log average memory and tick function count per combatant, split by
+   * players and enemies. Also available as the Combat.Footprint command */
+  static void ReportCombatantFootprint(UWorld *World);
+
+protected:
+  // ~begin UWorldSubsystem interface
+  virtual void OnWorldBeginPlay(UWorld &InWorld) override;
+  // ~end UWorldSubsystem interface
+
+  /** Bind to any player ASC we are not yet listening to */
+  void BindPlayerAbilitySystems();
+
+  /** Count an ability activation against its owning connection */
+  void HandleAbilityActivated(UGameplayAbility *Ability);
+
+  /** Log the accumulated stats and reset the window */
+  void Report();
+
+private:
+  /** Whether this world is a server we should report on */
+  bool bEnabled = false;
+
+  /** Seconds between reports, overridable with -CombatNetStatsInterval= */
+  float ReportInterval = 5.0f;
+
+  /** Time accumulated in the current window */
+  float WindowTime = 0.0f;
+
+  /** Frames ticked in the current window */
+  int32 WindowFrames = 0;
+
+  /** Game thread time accumulated in the current window */
+  double WindowGameThreadMs = 0.0;
+
+  /** Worst game thread time in the current window */
+  double WindowMaxGameThreadMs = 0.0;
+
+  /** Ability systems we are already bound to */
+  TMap<TWeakObjectPtr<UAbilitySystemComponent>, FDelegateHandle>
+      BoundAbilitySystems;
+
+  /** Ability activations per connection in the current window */
+  TMap<TWeakObjectPtr<UNetConnection>, int32> ActivationsPerConnection;
+};
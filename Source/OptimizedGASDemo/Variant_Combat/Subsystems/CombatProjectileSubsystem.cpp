@@ -0,0 +1,412 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatProjectileSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "CombatCosmetics.h"
+#include "CombatDamageable.h"
+#include "CombatTeams.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Hitbox/CombatHitboxComponent.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Tick"), STAT_CombatProjectileTick,
+                   STATGROUP_Combat);
+DECLARE_CYCLE_STAT(TEXT("Projectile Move"), STAT_CombatProjectileMove,
+                   STATGROUP_Combat);
+DECLARE_CYCLE_STAT(TEXT("Projectile Sweeps"), STAT_CombatProjectileSweeps,
+                   STATGROUP_Combat);
+DECLARE_CYCLE_STAT(TEXT("Projectile Visuals"), STAT_CombatProjectileVisuals,
+                   STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Live Projectiles"),
+                               STAT_CombatLiveProjectiles, STATGROUP_Combat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectile Hits"), STAT_CombatProjectileHits,
+                           STATGROUP_Combat);
+
+namespace {
+TAutoConsoleVariable<bool> CVarProjectileAsyncSweeps(
+    TEXT("Combat.ProjectileAsyncSweeps"), true,
+    TEXT("Sweep projectiles with async queries read the next tick. When ")
+        TEXT("off, every projectile sweeps on the game thread"));
+
+/** Projectiles moved per parallel task */
+constexpr int32 MoveBatchSize = 256;
+
+void BenchmarkProjectiles(const TArray<FString> &Args, UWorld *World) {
+  UCombatProjectileSubsystem *Projectiles =
+      World ? World->GetSubsystem<UCombatProjectileSubsystem>() : nullptr;
+  if (!Projectiles) {
+    return;
+  }
+
+  const int32 Count =
+      Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 5000;
+  const float Duration =
+      Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 1.0f) : 10.0f;
+  Projectiles->StartBenchmark(Count, Duration);
+}
+
+FAutoConsoleCommandWithWorldAndArgs BenchProjectilesCommand(
+    TEXT("Combat.BenchProjectiles"),
+    TEXT("Keeps N projectiles alive around the player (default 5000) for S "
+         "seconds (default 10) and logs the average projectile tick"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(
+        &BenchmarkProjectiles));
+} // namespace
+
+bool UCombatProjectileSubsystem::DoesSupportWorldType(
+    const EWorldType::Type WorldType) const {
+  return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatProjectileSubsystem::Deinitialize() {
+  // the visuals actor goes away with the world
+  VisualMeshes.Reset();
+  VisualComponents.Reset();
+  VisualTransforms.Reset();
+  VisualsActor = nullptr;
+
+  Super::Deinitialize();
+}
+
+bool UCombatProjectileSubsystem::IsTickable() const {
+  return (Positions.Num() > 0 || BenchmarkCount > 0) && Super::IsTickable();
+}
+
+TStatId UCombatProjectileSubsystem::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatProjectileSubsystem,
+                                  STATGROUP_Tickables);
+}
+
+void UCombatProjectileSubsystem::FireProjectile(
+    const FVector &Location, const FVector &Direction,
+    const FCombatProjectileParams &Params, AActor *Instigator) {
+  Positions.Add(Location);
+  PreviousPositions.Add(Location);
+  Velocities.Add(Direction.GetSafeNormal() * Params.Speed);
+  Lifetimes.Add(Params.Lifetime);
+  Radii.Add(Params.Radius);
+  Damages.Add(Params.Damage);
+  Knockbacks.Add(Params.Knockback);
+  GravityScales.Add(Params.GravityScale);
+  MeshScales.Add(Params.MeshScale);
+  Teams.Add(FGenericTeamId::GetTeamIdentifier(Instigator));
+  Instigators.Add(Instigator);
+  VisualGroups.Add(FindOrAddVisualGroup(Params.Mesh));
+  TraceHandles.AddDefaulted();
+}
+
+void UCombatProjectileSubsystem::Tick(float DeltaTime) {
+  Super::Tick(DeltaTime);
+
+  UpdateBenchmark(DeltaTime);
+
+  SCOPE_CYCLE_COUNTER(STAT_CombatProjectileTick);
+  const double StartTime = FPlatformTime::Seconds();
+
+  // last tick's sweeps cover the segment flown last tick. Apply them, then
+  // cull what they spent and what expired after its final segment was swept
+  ResolveHits();
+  RemoveDeadProjectiles();
+  MoveProjectiles(DeltaTime);
+
+  if (CVarProjectileAsyncSweeps.GetValueOnGameThread()) {
+    IssueSweeps();
+  } else {
+    // sweep this tick's segments right away, hits are culled next tick
+    SCOPE_CYCLE_COUNTER(STAT_CombatDeferrableTraces);
+    UWorld *World = GetWorld();
+    FHitResult Hit;
+    for (int32 Index = 0; Index < Positions.Num(); ++Index) {
+      TraceHandles[Index] = FTraceHandle();
+
+      FVector Start, End;
+      FCollisionShape Shape;
+      FCollisionObjectQueryParams ObjectParams;
+      FCollisionQueryParams Params;
+      GetSweep(Index, Start, End, Shape, ObjectParams, Params);
+      if (World->SweepSingleByObjectType(Hit, Start, End, FQuat::Identity,
+                                         ObjectParams, Shape, Params)) {
+        ApplyHit(Index, Hit);
+      }
+    }
+  }
+
+  UpdateVisuals();
+
+  SET_DWORD_STAT(STAT_CombatLiveProjectiles, Positions.Num());
+
+  if (BenchmarkCount > 0) {
+    ++BenchmarkFrames;
+    BenchmarkSeconds += FPlatformTime::Seconds() - StartTime;
+    BenchmarkProjectileFrames += Positions.Num();
+  }
+}
+
+void UCombatProjectileSubsystem::MoveProjectiles(float DeltaTime) {
+  SCOPE_CYCLE_COUNTER(STAT_CombatProjectileMove);
+
+  const FVector Gravity(0.0f, 0.0f, GetWorld()->GetGravityZ());
+  const int32 Num = Positions.Num();
+  const int32 NumBatches = FMath::DivideAndRoundUp(Num, MoveBatchSize);
+
+  // every projectile only touches its own entries, so batches run in
+  // parallel without locks
+  ParallelFor(NumBatches, [&](int32 Batch) {
+    const int32 First = Batch * MoveBatchSize;
+    const int32 Last = FMath::Min(First + MoveBatchSize, Num);
+    for (int32 Index = First; Index < Last; ++Index) {
+      PreviousPositions[Index] = Positions[Index];
+      Velocities[Index] += Gravity * (GravityScales[Index] * DeltaTime);
+      Positions[Index] += Velocities[Index] * DeltaTime;
+      Lifetimes[Index] -= DeltaTime;
+    }
+  });
+}
+
+void UCombatProjectileSubsystem::ResolveHits() {
+  UWorld *World = GetWorld();
+  FTraceDatum Datum;
+  for (int32 Index = 0; Index < Positions.Num(); ++Index) {
+    if (TraceHandles[Index].IsValid() &&
+        World->QueryTraceData(TraceHandles[Index], Datum) &&
+        Datum.OutHits.Num() > 0) {
+      ApplyHit(Index, Datum.OutHits[0]);
+    }
+    TraceHandles[Index] = FTraceHandle();
+  }
+}
+
+void UCombatProjectileSubsystem::ApplyHit(int32 Index, const FHitResult &Hit) {
+  INC_DWORD_STAT(STAT_CombatProjectileHits);
+
+  // spent, removed with the expired ones
+  Lifetimes[Index] = 0.0f;
+
+  // clients replay the server's launches for show, the server owns the hits
+  if (GetWorld()->GetNetMode() == NM_Client) {
+    return;
+  }
+
+  AActor *HitActor = Hit.GetActor();
+  ICombatDamageable *Damageable = Cast<ICombatDamageable>(HitActor);
+  if (!Damageable) {
+    return;
+  }
+
+  float Damage = Damages[Index];
+  if (const UCombatHitboxComponent *Hitbox =
+          HitActor->FindComponentByClass<UCombatHitboxComponent>()) {
+    Damage *= Hitbox->GetDamageMultiplier(Hit.GetComponent());
+  }
+
+  const FVector Impulse =
+      Velocities[Index].GetSafeNormal() * Knockbacks[Index];
+  Damageable->ApplyDamage(Damage, Instigators[Index].Get(), Hit.ImpactPoint,
+                          Impulse);
+}
+
+void UCombatProjectileSubsystem::RemoveDeadProjectiles() {
+  // walk backwards so the entry swapped in has already been checked
+  for (int32 Index = Positions.Num() - 1; Index >= 0; --Index) {
+    if (Lifetimes[Index] > 0.0f) {
+      continue;
+    }
+
+    Positions.RemoveAtSwap(Index, EAllowShrinking::No);
+    PreviousPositions.RemoveAtSwap(Index, EAllowShrinking::No);
+    Velocities.RemoveAtSwap(Index, EAllowShrinking::No);
+    Lifetimes.RemoveAtSwap(Index, EAllowShrinking::No);
+    Radii.RemoveAtSwap(Index, EAllowShrinking::No);
+    Damages.RemoveAtSwap(Index, EAllowShrinking::No);
+    Knockbacks.RemoveAtSwap(Index, EAllowShrinking::No);
+    GravityScales.RemoveAtSwap(Index, EAllowShrinking::No);
+    MeshScales.RemoveAtSwap(Index, EAllowShrinking::No);
+    Teams.RemoveAtSwap(Index, EAllowShrinking::No);
+    Instigators.RemoveAtSwap(Index, EAllowShrinking::No);
+    VisualGroups.RemoveAtSwap(Index, EAllowShrinking::No);
+    TraceHandles.RemoveAtSwap(Index, EAllowShrinking::No);
+  }
+}
+
+void UCombatProjectileSubsystem::GetSweep(
+    int32 Index, FVector &OutStart, FVector &OutEnd, FCollisionShape &OutShape,
+    FCollisionObjectQueryParams &OutObjectParams,
+    FCollisionQueryParams &OutParams) const {
+  OutStart = PreviousPositions[Index];
+  OutEnd = Positions[Index];
+  OutShape.SetSphere(Radii[Index]);
+
+  // hostile and teamless hitboxes, stopped by level geometry
+  OutObjectParams = CombatTeams::GetHostileHitboxParams(Teams[Index], true);
+  OutObjectParams.AddObjectTypesToQuery(ECC_WorldStatic);
+
+  OutParams = FCollisionQueryParams(SCENE_QUERY_STAT(CombatProjectile), false,
+                                    Instigators[Index].Get());
+}
+
+void UCombatProjectileSubsystem::IssueSweeps() {
+  SCOPE_CYCLE_COUNTER(STAT_CombatProjectileSweeps);
+
+  UWorld *World = GetWorld();
+  for (int32 Index = 0; Index < Positions.Num(); ++Index) {
+    FVector Start, End;
+    FCollisionShape Shape;
+    FCollisionObjectQueryParams ObjectParams;
+    FCollisionQueryParams Params;
+    GetSweep(Index, Start, End, Shape, ObjectParams, Params);
+    TraceHandles[Index] = World->AsyncSweepByObjectType(
+        EAsyncTraceType::Single, Start, End, FQuat::Identity, ObjectParams,
+        Shape, Params);
+  }
+
+  INC_DWORD_STAT_BY(STAT_CombatAsyncTraces, Positions.Num());
+}
+
+int32 UCombatProjectileSubsystem::FindOrAddVisualGroup(UStaticMesh *Mesh) {
+  UWorld *World = GetWorld();
+  if (!Mesh || !CombatCosmetics::ShouldRun(World)) {
+    return INDEX_NONE;
+  }
+
+  const int32 Existing = VisualMeshes.Find(Mesh);
+  if (Existing != INDEX_NONE) {
+    return Existing;
+  }
+
+  if (!VisualsActor) {
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+    VisualsActor = World->SpawnActor<AActor>(SpawnParams);
+    if (!VisualsActor) {
+      return INDEX_NONE;
+    }
+
+    USceneComponent *Root = NewObject<USceneComponent>(VisualsActor);
+    VisualsActor->SetRootComponent(Root);
+    Root->RegisterComponent();
+  }
+
+  // one draw call per mesh, instances are placed in world space
+  UInstancedStaticMeshComponent *Component =
+      NewObject<UInstancedStaticMeshComponent>(VisualsActor);
+  Component->SetMobility(EComponentMobility::Movable);
+  Component->SetStaticMesh(Mesh);
+  Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+  Component->SetCastShadow(false);
+  Component->SetupAttachment(VisualsActor->GetRootComponent());
+  Component->RegisterComponent();
+  VisualsActor->AddInstanceComponent(Component);
+
+  VisualMeshes.Add(Mesh);
+  VisualComponents.Add(Component);
+  VisualTransforms.AddDefaulted();
+  return VisualMeshes.Num() - 1;
+}
+
+void UCombatProjectileSubsystem::UpdateVisuals() {
+  if (VisualComponents.Num() == 0) {
+    return;
+  }
+
+  SCOPE_CYCLE_COUNTER(STAT_CombatProjectileVisuals);
+
+  for (TArray<FTransform> &Transforms : VisualTransforms) {
+    Transforms.Reset();
+  }
+
+  for (int32 Index = 0; Index < Positions.Num(); ++Index) {
+    const int32 Group = VisualGroups[Index];
+    if (Group != INDEX_NONE) {
+      VisualTransforms[Group].Emplace(Velocities[Index].ToOrientationQuat(),
+                                      Positions[Index],
+                                      FVector(MeshScales[Index]));
+    }
+  }
+
+  for (int32 Group = 0; Group < VisualComponents.Num(); ++Group) {
+    UInstancedStaticMeshComponent *Component = VisualComponents[Group];
+    TArray<FTransform> &Transforms = VisualTransforms[Group];
+    const int32 NumLive = Transforms.Num();
+    const int32 NumInstances = Component->GetInstanceCount();
+
+    if (NumLive > NumInstances) {
+      // grow to the new peak, the batch update below places the new ones
+      TArray<FTransform> Added;
+      Added.Init(FTransform::Identity, NumLive - NumInstances);
+      Component->AddInstances(Added, false, true, false);
+    } else if (NumLive < NumInstances) {
+      // instances are never removed, unused ones are collapsed to zero
+      // scale so the peak count is only allocated once
+      Transforms.SetNum(NumInstances, EAllowShrinking::No);
+      for (int32 Index = NumLive; Index < NumInstances; ++Index) {
+        Transforms[Index].SetScale3D(FVector::ZeroVector);
+      }
+    }
+
+    Component->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+  }
+}
+
+void UCombatProjectileSubsystem::StartBenchmark(int32 Count, float Duration) {
+  BenchmarkCount = Count;
+  BenchmarkTimeLeft = Duration;
+  BenchmarkFrames = 0;
+  BenchmarkSeconds = 0.0;
+  BenchmarkProjectileFrames = 0;
+
+  UE_LOG(LogOptimizedGASDemo, Log,
+         TEXT("Combat.BenchProjectiles: keeping %d projectiles alive for "
+              "%.0fs"),
+         Count, Duration);
+}
+
+void UCombatProjectileSubsystem::UpdateBenchmark(float DeltaTime) {
+  if (BenchmarkCount <= 0) {
+    return;
+  }
+
+  BenchmarkTimeLeft -= DeltaTime;
+  if (BenchmarkTimeLeft <= 0.0f) {
+    const int32 Frames = FMath::Max(BenchmarkFrames, 1);
+    const double AverageLive = double(BenchmarkProjectileFrames) / Frames;
+    const double AverageMs = BenchmarkSeconds * 1000.0 / Frames;
+    UE_LOG(LogOptimizedGASDemo, Log,
+           TEXT("Combat.BenchProjectiles: %d ticks, %.0f live projectiles, "
+                "%.3fms per tick (%.3fus per projectile)"),
+           BenchmarkFrames, AverageLive, AverageMs,
+           AverageLive > 0.0 ? AverageMs * 1000.0 / AverageLive : 0.0);
+    BenchmarkCount = 0;
+    return;
+  }
+
+  // fire from the first player, or the world origin without one
+  const UWorld *World = GetWorld();
+  const APlayerController *PC = World->GetFirstPlayerController();
+  APawn *Pawn = PC ? PC->GetPawn() : nullptr;
+  const FVector Origin = Pawn ? Pawn->GetActorLocation() : FVector::ZeroVector;
+
+  // zero damage so the benchmark can run in a populated level
+  static const FSoftObjectPath SphereMesh(
+      TEXT("/Engine/BasicShapes/Sphere.Sphere"));
+  FCombatProjectileParams Params;
+  Params.Speed = 1500.0f;
+  Params.Radius = 5.0f;
+  Params.Damage = 0.0f;
+  Params.Knockback = 0.0f;
+  Params.Lifetime = 2.0f;
+  Params.Mesh = Cast<UStaticMesh>(SphereMesh.TryLoad());
+  Params.MeshScale = 0.1f;
+
+  while (Positions.Num() < BenchmarkCount) {
+    FVector Direction = FMath::VRand();
+    Direction.Z *= 0.1f;
+    FireProjectile(Origin + FVector(0.0f, 0.0f, 100.0f), Direction, Params,
+                   Pawn);
+  }
+}
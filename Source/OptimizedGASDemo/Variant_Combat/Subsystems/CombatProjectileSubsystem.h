@@ -0,0 +1,166 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericTeamAgentInterface.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "CombatProjectileSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/** Launch parameters of a projectile */
+USTRUCT(BlueprintType)
+struct FCombatProjectileParams {
+  GENERATED_BODY()
+
+  /** Launch speed */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile",
+            meta = (ClampMin = 0, Units = "cm/s"))
+  float Speed = 2000.0f;
+
+  /** Collision radius of the sweep */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile",
+            meta = (ClampMin = 0, Units = "cm"))
+  float Radius = 10.0f;
+
+  /** Damage applied to the first damageable actor hit */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile",
+            meta = (ClampMin = 0))
+  float Damage = 10.0f;
+
+  /** Impulse along the flight direction applied on hit */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile",
+            meta = (ClampMin = 0))
+  float Knockback = 300.0f;
+
+  /** Time before the projectile expires */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile",
+            meta = (ClampMin = 0, Units = "s"))
+  float Lifetime = 3.0f;
+
+  /** Multiplier of world gravity, 0 for straight flight */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Projectile")
+  float GravityScale = 0.0f;
+
+  /** Mesh drawn for the projectile through an instanced mesh component */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visuals")
+  TObjectPtr<UStaticMesh> Mesh;
+
+  /** Uniform scale of the mesh */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Visuals",
+            meta = (ClampMin = 0))
+  float MeshScale = 1.0f;
+};
+
+/**
+ * Simulates projectiles without an actor each. Projectile state is kept in
+ * flat arrays, moved in a parallel batch every tick and swept against hostile
+ * hitboxes and world geometry with async sweeps whose results are read the
+ * next tick. Hits go through ICombatDamageable::ApplyDamage, and projectiles
+ * are drawn through one instanced mesh component per mesh.
+ */
+UCLASS()
+class UCombatProjectileSubsystem : public UTickableWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  // ~begin FTickableGameObject interface
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+  virtual bool IsTickable() const override;
+  // ~end FTickableGameObject interface
+
+  /** Launch a projectile. Friendly hitboxes of the instigator's team are
+   * never hit */
+  void FireProjectile(const FVector &Location, const FVector &Direction,
+                      const FCombatProjectileParams &Params,
+                      AActor *Instigator);
+
+  /** Number of live projectiles */
+  int32 GetNumProjectiles() const { return Positions.Num(); }
+
+  /** Keep Count projectiles alive around the first player for Duration
+   * seconds, then log the average tick cost */
+  void StartBenchmark(int32 Count, float Duration);
+
+protected:
+  // ~begin UWorldSubsystem interface
+  virtual bool DoesSupportWorldType(
+      const EWorldType::Type WorldType) const override;
+  virtual void Deinitialize() override;
+  // ~end UWorldSubsystem interface
+
+  /** Advance every projectile by DeltaTime */
+  void MoveProjectiles(float DeltaTime);
+
+  /** Apply the hits of last tick's sweeps, or sweep now when async sweeps
+   * are off */
+  void ResolveHits();
+
+  /** Damage the actor hit by a projectile */
+  void ApplyHit(int32 Index, const FHitResult &Hit);
+
+  /** Drop expired and spent projectiles */
+  void RemoveDeadProjectiles();
+
+  /** Queue this tick's sweeps */
+  void IssueSweeps();
+
+  /** Copy projectile transforms to the instanced mesh components */
+  void UpdateVisuals();
+
+  /** Returns the visual group for a mesh, or INDEX_NONE for no mesh */
+  int32 FindOrAddVisualGroup(UStaticMesh *Mesh);
+
+  /** Sweep from the previous to the current position of a projectile */
+  void GetSweep(int32 Index, FVector &OutStart, FVector &OutEnd,
+                FCollisionShape &OutShape,
+                FCollisionObjectQueryParams &OutObjectParams,
+                FCollisionQueryParams &OutParams) const;
+
+  /** Keep the benchmark projectile count topped up and log when done */
+  void UpdateBenchmark(float DeltaTime);
+
+private:
+  // live projectiles, one entry per projectile in every array
+  TArray<FVector> Positions;
+  TArray<FVector> PreviousPositions;
+  TArray<FVector> Velocities;
+  TArray<float> Lifetimes;
+  TArray<float> Radii;
+  TArray<float> Damages;
+  TArray<float> Knockbacks;
+  TArray<float> GravityScales;
+  TArray<float> MeshScales;
+  TArray<FGenericTeamId> Teams;
+  TArray<TWeakObjectPtr<AActor>> Instigators;
+  TArray<int32> VisualGroups;
+
+  /** Async sweep issued last tick, read this tick */
+  TArray<FTraceHandle> TraceHandles;
+
+  /** Meshes drawn by each visual group */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<UStaticMesh>> VisualMeshes;
+
+  /** Instanced mesh component of each visual group */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<UInstancedStaticMeshComponent>> VisualComponents;
+
+  /** Actor owning the instanced mesh components */
+  UPROPERTY(Transient)
+  TObjectPtr<AActor> VisualsActor;
+
+  /** Transforms gathered per visual group, reused between ticks */
+  TArray<TArray<FTransform>> VisualTransforms;
+
+  // benchmark state
+  int32 BenchmarkCount = 0;
+  float BenchmarkTimeLeft = 0.0f;
+  int32 BenchmarkFrames = 0;
+  double BenchmarkSeconds = 0.0;
+  int64 BenchmarkProjectileFrames = 0;
+};
@@ -0,0 +1,334 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatRagdollSubsystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "CombatCosmetics.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ragdoll Budget"), STAT_CombatRagdollBudget,
+                   STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Simulated Ragdolls"),
+                               STAT_CombatSimulatedRagdolls, STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Sleeping Ragdolls"),
+                               STAT_CombatSleepingRagdolls, STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Frozen Ragdolls"),
+                               STAT_CombatFrozenRagdolls, STATGROUP_Combat);
+
+namespace {
+TAutoConsoleVariable<int32> CVarRagdollMaxSimulated(
+    TEXT("Combat.Ragdoll.MaxSimulated"), 8,
+    TEXT("Maximum number of ragdolls and knockback blends simulating at once"));
+
+TAutoConsoleVariable<float> CVarRagdollRestSpeed(
+    TEXT("Combat.Ragdoll.RestSpeed"), 10.0f,
+    TEXT("Root body speed (cm/s) below which a ragdoll counts as at rest"));
+
+TAutoConsoleVariable<float> CVarRagdollRestTime(
+    TEXT("Combat.Ragdoll.RestTime"), 0.5f,
+    TEXT("Seconds a ragdoll must stay at rest before it is frozen"));
+
+TAutoConsoleVariable<float> CVarRagdollMinTime(
+    TEXT("Combat.Ragdoll.MinTime"), 1.0f,
+    TEXT("Seconds a new ragdoll ranks ahead of settled ones in the budget"));
+
+TAutoConsoleVariable<float> CVarRagdollMaxKnockbackTime(
+    TEXT("Combat.Ragdoll.MaxKnockbackTime"), 1.0f,
+    TEXT("Seconds a knockback blend holds its slot if it never lands"));
+
+/** Seconds between budget updates */
+constexpr float UpdateInterval = 0.1f;
+
+/** Ragdolls not rendered this recently rank as if they were twice as far */
+constexpr float VisibilityTolerance = 0.5f;
+} // namespace
+
+bool UCombatRagdollSubsystem::DoesSupportWorldType(
+    const EWorldType::Type WorldType) const {
+  return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UCombatRagdollSubsystem::IsTickable() const {
+  return Ragdolls.Num() > 0 && Super::IsTickable();
+}
+
+TStatId UCombatRagdollSubsystem::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatRagdollSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatRagdollSubsystem::Tick(float DeltaTime) {
+  Super::Tick(DeltaTime);
+
+  TimeSinceUpdate += DeltaTime;
+  if (TimeSinceUpdate >= UpdateInterval) {
+    UpdateBudget(TimeSinceUpdate);
+    TimeSinceUpdate = 0.0f;
+  }
+}
+
+void UCombatRagdollSubsystem::StartRagdoll(USkeletalMeshComponent *Mesh) {
+  if (!Mesh || !CombatCosmetics::ShouldRun(GetWorld())) {
+    return;
+  }
+
+  FRagdoll *Ragdoll = FindRagdoll(Mesh);
+  if (!Ragdoll) {
+    Ragdoll = &Ragdolls.AddDefaulted_GetRef();
+    Ragdoll->Mesh = Mesh;
+  } else if (!Ragdoll->bKnockback) {
+    // already ragdolling
+    return;
+  }
+
+  // a knockback turning into a death keeps its slot, otherwise make room by
+  // evicting the oldest simulating ragdoll
+  FRagdoll *Oldest = nullptr;
+  int32 NumSimulated = 0;
+  for (FRagdoll &Other : Ragdolls) {
+    if (&Other == Ragdoll || Other.State != ERagdollState::Simulating) {
+      continue;
+    }
+    ++NumSimulated;
+    if (!Other.bKnockback && (!Oldest || Other.Age > Oldest->Age)) {
+      Oldest = &Other;
+    }
+  }
+
+  const bool bOverBudget =
+      !Ragdoll->bKnockback &&
+      NumSimulated >= CVarRagdollMaxSimulated.GetValueOnGameThread();
+  if (bOverBudget && Oldest) {
+    Evict(*Oldest);
+  }
+
+  Ragdoll->bKnockback = false;
+  Ragdoll->State = ERagdollState::Simulating;
+  Ragdoll->Age = 0.0f;
+  Ragdoll->RestTime = 0.0f;
+
+  Mesh->SetPhysicsBlendWeight(1.0f);
+  Mesh->SetSimulatePhysics(true);
+
+  // every slot is a knockback, wait asleep for the next budget update
+  if (bOverBudget && !Oldest) {
+    Mesh->PutAllRigidBodiesToSleep();
+    Ragdoll->State = ERagdollState::Sleeping;
+  }
+}
+
+void UCombatRagdollSubsystem::StopRagdoll(USkeletalMeshComponent *Mesh) {
+  if (!Mesh) {
+    return;
+  }
+
+  Ragdolls.RemoveAllSwap(
+      [Mesh](const FRagdoll &Ragdoll) { return Ragdoll.Mesh == Mesh; });
+
+  Mesh->SetComponentTickEnabled(true);
+  Mesh->SetPhysicsBlendWeight(0.0f);
+  Mesh->SetSimulatePhysics(false);
+}
+
+bool UCombatRagdollSubsystem::TryStartKnockback(USkeletalMeshComponent *Mesh) {
+  if (!Mesh || !CombatCosmetics::ShouldRun(GetWorld())) {
+    return false;
+  }
+
+  if (FRagdoll *Ragdoll = FindRagdoll(Mesh)) {
+    // already holds a slot, or is a death ragdoll that handles its own impulse
+    return Ragdoll->bKnockback;
+  }
+
+  int32 NumSimulated = 0;
+  for (const FRagdoll &Ragdoll : Ragdolls) {
+    if (Ragdoll.State == ERagdollState::Simulating) {
+      ++NumSimulated;
+    }
+  }
+
+  if (NumSimulated >= CVarRagdollMaxSimulated.GetValueOnGameThread()) {
+    return false;
+  }
+
+  FRagdoll &Ragdoll = Ragdolls.AddDefaulted_GetRef();
+  Ragdoll.Mesh = Mesh;
+  Ragdoll.bKnockback = true;
+  Ragdoll.StartTime = GetWorld()->GetTimeSeconds();
+  return true;
+}
+
+void UCombatRagdollSubsystem::StopKnockback(USkeletalMeshComponent *Mesh) {
+  Ragdolls.RemoveAllSwap([Mesh](const FRagdoll &Ragdoll) {
+    return Ragdoll.bKnockback && Ragdoll.Mesh == Mesh;
+  });
+}
+
+UCombatRagdollSubsystem::FRagdoll *
+UCombatRagdollSubsystem::FindRagdoll(const USkeletalMeshComponent *Mesh) {
+  return Ragdolls.FindByPredicate(
+      [Mesh](const FRagdoll &Ragdoll) { return Ragdoll.Mesh == Mesh; });
+}
+
+void UCombatRagdollSubsystem::Freeze(FRagdoll &Ragdoll) {
+  USkeletalMeshComponent *Mesh = Ragdoll.Mesh.Get();
+  Ragdoll.State = ERagdollState::Frozen;
+
+  // without a component tick the bones are never refreshed from animation,
+  // so the mesh keeps the last simulated pose
+  Mesh->SetSimulatePhysics(false);
+  Mesh->SetComponentTickEnabled(false);
+}
+
+void UCombatRagdollSubsystem::Evict(FRagdoll &Ragdoll) {
+  USkeletalMeshComponent *Mesh = Ragdoll.Mesh.Get();
+  if (Mesh->WasRecentlyRendered(VisibilityTolerance)) {
+    if (Ragdoll.State == ERagdollState::Simulating) {
+      Mesh->PutAllRigidBodiesToSleep();
+      Ragdoll.State = ERagdollState::Sleeping;
+    }
+  } else {
+    // unseen, stop simulating for good
+    Freeze(Ragdoll);
+  }
+}
+
+void UCombatRagdollSubsystem::GetViewLocations(
+    TArray<FVector> &OutLocations) const {
+  for (FConstPlayerControllerIterator It =
+           GetWorld()->GetPlayerControllerIterator();
+       It; ++It) {
+    const APlayerController *PC = It->Get();
+    if (!PC) {
+      continue;
+    }
+
+    // local players rank by camera, remote players by their pawn
+    if (PC->IsLocalController() && PC->PlayerCameraManager) {
+      OutLocations.Add(PC->PlayerCameraManager->GetCameraLocation());
+    } else if (const APawn *Pawn = PC->GetPawn()) {
+      OutLocations.Add(Pawn->GetActorLocation());
+    }
+  }
+}
+
+void UCombatRagdollSubsystem::UpdateBudget(float DeltaTime) {
+  SCOPE_CYCLE_COUNTER(STAT_CombatRagdollBudget);
+
+  // drop meshes that were destroyed with their actor, and expire knockbacks
+  // that never landed (grounded hits, lava ticks, simulated proxies)
+  const double Now = GetWorld()->GetTimeSeconds();
+  const float MaxKnockbackTime =
+      CVarRagdollMaxKnockbackTime.GetValueOnGameThread();
+  for (int32 Index = Ragdolls.Num() - 1; Index >= 0; --Index) {
+    FRagdoll &Ragdoll = Ragdolls[Index];
+    USkeletalMeshComponent *Mesh = Ragdoll.Mesh.Get();
+    if (Mesh && Ragdoll.bKnockback &&
+        Now - Ragdoll.StartTime >= MaxKnockbackTime) {
+      Mesh->SetPhysicsBlendWeight(0.0f);
+      Mesh = nullptr;
+    }
+
+    if (!Mesh) {
+      Ragdolls.RemoveAtSwap(Index);
+    }
+  }
+
+  TArray<FVector> ViewLocations;
+  GetViewLocations(ViewLocations);
+
+  const float RestSpeed = CVarRagdollRestSpeed.GetValueOnGameThread();
+  const float RestTime = CVarRagdollRestTime.GetValueOnGameThread();
+  const float MinTime = CVarRagdollMinTime.GetValueOnGameThread();
+  int32 Budget = CVarRagdollMaxSimulated.GetValueOnGameThread();
+
+  // death ragdolls still competing for a slot, with their priority
+  TArray<TPair<double, FRagdoll *>> Candidates;
+  for (FRagdoll &Ragdoll : Ragdolls) {
+    if (Ragdoll.bKnockback) {
+      // knockbacks are short and already fit the budget when they started
+      --Budget;
+      continue;
+    }
+
+    if (Ragdoll.State == ERagdollState::Frozen) {
+      continue;
+    }
+
+    USkeletalMeshComponent *Mesh = Ragdoll.Mesh.Get();
+    Ragdoll.Age += DeltaTime;
+
+    // end the simulation early once the body has settled
+    if (Ragdoll.State == ERagdollState::Simulating && Ragdoll.Age >= MinTime) {
+      const bool bAtRest = !Mesh->RigidBodyIsAwake() ||
+                           Mesh->GetPhysicsLinearVelocity().Size() < RestSpeed;
+      Ragdoll.RestTime = bAtRest ? Ragdoll.RestTime + DeltaTime : 0.0f;
+      if (Ragdoll.RestTime >= RestTime) {
+        Freeze(Ragdoll);
+        continue;
+      }
+    }
+
+    // closest to any viewer first, off-screen ragdolls count as further away
+    double DistanceSq =
+        ViewLocations.Num() > 0 ? TNumericLimits<double>::Max() : 0.0;
+    const FVector Location = Mesh->GetComponentLocation();
+    for (const FVector &ViewLocation : ViewLocations) {
+      DistanceSq =
+          FMath::Min(DistanceSq, FVector::DistSquared(Location, ViewLocation));
+    }
+    if (!Mesh->WasRecentlyRendered(VisibilityTolerance)) {
+      DistanceSq *= 4.0;
+    }
+
+    // new ragdolls rank before settled ones so they get a chance to fall,
+    // newest first, but they still share the budget
+    const double Priority =
+        Ragdoll.Age < MinTime ? Ragdoll.Age - MinTime : DistanceSq;
+    Candidates.Emplace(Priority, &Ragdoll);
+  }
+
+  Candidates.Sort([](const TPair<double, FRagdoll *> &A,
+                     const TPair<double, FRagdoll *> &B) {
+    return A.Key < B.Key;
+  });
+
+  for (int32 Index = 0; Index < Candidates.Num(); ++Index) {
+    FRagdoll &Ragdoll = *Candidates[Index].Value;
+    USkeletalMeshComponent *Mesh = Ragdoll.Mesh.Get();
+
+    if (Index < Budget) {
+      // within budget, resume if we put it to sleep earlier
+      if (Ragdoll.State == ERagdollState::Sleeping) {
+        Mesh->WakeAllRigidBodies();
+        Ragdoll.State = ERagdollState::Simulating;
+      }
+    } else {
+      Evict(Ragdoll);
+    }
+  }
+
+  int32 NumSimulated = 0;
+  int32 NumSleeping = 0;
+  int32 NumFrozen = 0;
+  for (const FRagdoll &Ragdoll : Ragdolls) {
+    switch (Ragdoll.State) {
+    case ERagdollState::Simulating:
+      ++NumSimulated;
+      break;
+    case ERagdollState::Sleeping:
+      ++NumSleeping;
+      break;
+    case ERagdollState::Frozen:
+      ++NumFrozen;
+      break;
+    }
+  }
+
+  SET_DWORD_STAT(STAT_CombatSimulatedRagdolls, NumSimulated);
+  SET_DWORD_STAT(STAT_CombatSleepingRagdolls, NumSleeping);
+  SET_DWORD_STAT(STAT_CombatFrozenRagdolls, NumFrozen);
+}
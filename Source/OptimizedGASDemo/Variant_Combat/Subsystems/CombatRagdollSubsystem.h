@@ -0,0 +1,93 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatRagdollSubsystem.generated.h"
+
+class USkeletalMeshComponent;
+
+/**
+ * Caps the number of simulated ragdolls. Death ragdolls closest to a viewer
+ * and on screen keep simulating, the rest are put to sleep when visible or
+ * frozen into their current pose when not. Ragdolls that come to rest are
+ * frozen early. New ragdolls count against the cap too: a death over the
+ * budget takes the slot of the oldest simulating ragdoll. Knockback blends
+ * take a slot only while one is free and give it back on landing or after
+ * Combat.Ragdoll.MaxKnockbackTime.
+ * Ragdolls are cosmetic, so nothing is simulated on dedicated servers.
+ */
+UCLASS()
+class UCombatRagdollSubsystem : public UTickableWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  // ~begin FTickableGameObject interface
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+  virtual bool IsTickable() const override;
+  // ~end FTickableGameObject interface
+
+  /** Start a full death ragdoll on the mesh */
+  void StartRagdoll(USkeletalMeshComponent *Mesh);
+
+  /** Stop any ragdoll or knockback on the mesh and restore animation */
+  void StopRagdoll(USkeletalMeshComponent *Mesh);
+
+  /** Reserve a slot for a partial knockback blend. Returns false if the
+   * budget is full and the knockback should skip the physics blend */
+  bool TryStartKnockback(USkeletalMeshComponent *Mesh);
+
+  /** Release the knockback slot once the character lands, dies or leaves
+   * play. Slots that are never released expire on their own */
+  void StopKnockback(USkeletalMeshComponent *Mesh);
+
+protected:
+  // ~begin UWorldSubsystem interface
+  virtual bool DoesSupportWorldType(
+      const EWorldType::Type WorldType) const override;
+  // ~end UWorldSubsystem interface
+
+  /** Rank death ragdolls and apply the budget */
+  void UpdateBudget(float DeltaTime);
+
+  /** Locations ragdolls are prioritized against (cameras or player pawns) */
+  void GetViewLocations(TArray<FVector> &OutLocations) const;
+
+private:
+  /** Simulation state of a tracked mesh */
+  enum class ERagdollState : uint8 { Simulating, Sleeping, Frozen };
+
+  /** One tracked death ragdoll or knockback blend */
+  struct FRagdoll {
+    TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+    ERagdollState State = ERagdollState::Simulating;
+    bool bKnockback = false;
+
+    /** World time the knockback slot was taken */
+    double StartTime = 0.0;
+
+    /** Seconds since the ragdoll started */
+    float Age = 0.0f;
+
+    /** Seconds the ragdoll has been below the rest speed */
+    float RestTime = 0.0f;
+  };
+
+  /** Find the entry for a mesh */
+  FRagdoll *FindRagdoll(const USkeletalMeshComponent *Mesh);
+
+  /** Stop simulating and keep the current pose */
+  static void Freeze(FRagdoll &Ragdoll);
+
+  /** Take a ragdoll over the budget off simulation: sleep it when on screen
+   * so it can resume in place, freeze it otherwise */
+  static void Evict(FRagdoll &Ragdoll);
+
+  /** Tracked ragdolls and knockbacks */
+  TArray<FRagdoll> Ragdolls;
+
+  /** Time accumulated since the last budget update */
+  float TimeSinceUpdate = 0.0f;
+};
@@ -0,0 +1,195 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatSpatialIndexSubsystem.h"
+#include "Algo/Sort.h"
+#include "CombatTeams.h"
+#include "HAL/IConsoleManager.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spatial Index Build"), STAT_CombatSpatialBuild,
+                   STATGROUP_Combat);
+DECLARE_CYCLE_STAT(TEXT("Spatial Index Query"), STAT_CombatSpatialQuery,
+                   STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Spatial Index Targets"),
+                               STAT_CombatSpatialTargets, STATGROUP_Combat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Spatial Query Candidates"),
+                           STAT_CombatSpatialCandidates, STATGROUP_Combat);
+
+namespace {
+TAutoConsoleVariable<float> CVarSpatialCellSize(
+    TEXT("Combat.SpatialCellSize"), 500.0f,
+    TEXT("Cell size (cm) of the combat spatial index grid"));
+} // namespace
+
+void FCombatSpatialGrid::Build(TConstArrayView<FVector> InPoints,
+                               float InCellSize) {
+  InvCellSize = 1.0f / FMath::Max(InCellSize, 1.0f);
+
+  const int32 Count = InPoints.Num();
+  ScratchKeys.SetNumUninitialized(Count, EAllowShrinking::No);
+  PointIndices.SetNumUninitialized(Count, EAllowShrinking::No);
+  for (int32 Index = 0; Index < Count; ++Index) {
+    const FVector &Point = InPoints[Index];
+    ScratchKeys[Index] = MakeKey(ToCell(Point.X), ToCell(Point.Y));
+    PointIndices[Index] = Index;
+  }
+
+  // group the points by cell, then record where each cell's run starts
+  Algo::SortBy(PointIndices,
+               [this](int32 Index) { return ScratchKeys[Index]; });
+
+  Points.SetNumUninitialized(Count, EAllowShrinking::No);
+  Cells.Reset();
+  for (int32 Index = 0; Index < Count; ++Index) {
+    const int32 SourceIndex = PointIndices[Index];
+    Points[Index] = InPoints[SourceIndex];
+
+    FCell &Cell = Cells.FindOrAdd(ScratchKeys[SourceIndex]);
+    if (Cell.Num == 0) {
+      Cell.Start = Index;
+    }
+    ++Cell.Num;
+  }
+}
+
+bool UCombatSpatialIndexSubsystem::DoesSupportWorldType(
+    const EWorldType::Type WorldType) const {
+  return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+float UCombatSpatialIndexSubsystem::GetCellSize() {
+  return CVarSpatialCellSize.GetValueOnGameThread();
+}
+
+FCombatSpatialHandle
+UCombatSpatialIndexSubsystem::RegisterTarget(AActor *Target,
+                                             FGenericTeamId Team) {
+  FCombatSpatialHandle Handle;
+  if (!Target) {
+    return Handle;
+  }
+
+  if (FreeSlots.Num() > 0) {
+    Handle.Index = FreeSlots.Pop(EAllowShrinking::No);
+  } else {
+    Handle.Index = Targets.AddDefaulted();
+    Teams.AddDefaulted();
+    Serials.AddDefaulted();
+  }
+
+  Handle.Serial = NextSerial++;
+
+  const int32 Slot = Handle.Index;
+  Targets[Slot] = Target;
+  Teams[Slot] = Team;
+  Serials[Slot] = Handle.Serial;
+
+  // new targets show up in the next query
+  GridFrame = MAX_uint64;
+
+  SET_DWORD_STAT(STAT_CombatSpatialTargets, GetNumTargets());
+  return Handle;
+}
+
+void UCombatSpatialIndexSubsystem::UnregisterTarget(
+    FCombatSpatialHandle &Handle) {
+  if (IsRegistered(Handle)) {
+    const int32 Slot = Handle.Index;
+    Targets[Slot].Reset();
+    Teams[Slot] = FGenericTeamId::NoTeam;
+    Serials[Slot] = 0;
+    FreeSlots.Add(Slot);
+
+    // the grid may still point at the slot, which could be reused
+    GridFrame = MAX_uint64;
+
+    SET_DWORD_STAT(STAT_CombatSpatialTargets, GetNumTargets());
+  }
+
+  Handle = FCombatSpatialHandle();
+}
+
+void UCombatSpatialIndexSubsystem::SetTeam(const FCombatSpatialHandle &Handle,
+                                           FGenericTeamId Team) {
+  if (IsRegistered(Handle)) {
+    Teams[Handle.Index] = Team;
+  }
+}
+
+bool UCombatSpatialIndexSubsystem::IsRegistered(
+    const FCombatSpatialHandle &Handle) const {
+  return Serials.IsValidIndex(Handle.Index) &&
+         Serials[Handle.Index] == Handle.Serial;
+}
+
+void UCombatSpatialIndexSubsystem::UpdateGrid() {
+  if (GridFrame == GFrameCounter) {
+    return;
+  }
+
+  SCOPE_CYCLE_COUNTER(STAT_CombatSpatialBuild);
+  GridFrame = GFrameCounter;
+
+  GridSlots.Reset();
+  GridLocations.Reset();
+  for (int32 Slot = 0; Slot < Targets.Num(); ++Slot) {
+    if (const AActor *Target = Targets[Slot].Get()) {
+      GridSlots.Add(Slot);
+      GridLocations.Add(Target->GetActorLocation());
+    }
+  }
+
+  Grid.Build(GridLocations, GetCellSize());
+}
+
+void UCombatSpatialIndexSubsystem::QueryTargets(
+    const FCombatSpatialQuery &Query,
+    TArray<FCombatSpatialResult> &OutResults) {
+  OutResults.Reset();
+  if (Query.Radius <= 0.0f) {
+    return;
+  }
+
+  UpdateGrid();
+
+  SCOPE_CYCLE_COUNTER(STAT_CombatSpatialQuery);
+
+  const bool bCone = Query.ConeHalfAngle < 180.0f;
+  const FVector Axis = Query.Direction.GetSafeNormal();
+  const double MinDot =
+      FMath::Cos(FMath::DegreesToRadians(double(Query.ConeHalfAngle)));
+
+  Grid.ForEachInRadius(
+      Query.Origin, Query.Radius,
+      [&](int32 PointIndex, const FVector &Location, double DistanceSquared) {
+        INC_DWORD_STAT(STAT_CombatSpatialCandidates);
+
+        const int32 Slot = GridSlots[PointIndex];
+        if (!CombatTeams::IsHostile(Query.Team, Teams[Slot],
+                                    Query.bIncludeTeamless)) {
+          return;
+        }
+
+        AActor *Target = Targets[Slot].Get();
+        if (!Target || Target == Query.IgnoreActor) {
+          return;
+        }
+
+        // targets on the origin are always inside the cone
+        const FVector Offset = Location - Query.Origin;
+        if (bCone && !Offset.IsNearlyZero() &&
+            (Offset.GetUnsafeNormal() | Axis) < MinDot) {
+          return;
+        }
+
+        FCombatSpatialResult &Result = OutResults.AddDefaulted_GetRef();
+        Result.Actor = Target;
+        Result.Location = Location;
+        Result.Distance = FMath::Sqrt(DistanceSquared);
+      });
+
+  Algo::SortBy(OutResults, &FCombatSpatialResult::Distance);
+  if (Query.MaxResults > 0 && OutResults.Num() > Query.MaxResults) {
+    OutResults.SetNum(Query.MaxResults, EAllowShrinking::No);
+  }
+}
@@ -0,0 +1,207 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericTeamAgentInterface.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatSpatialIndexSubsystem.generated.h"
+
+/** Handle to a target registered with UCombatSpatialIndexSubsystem */
+struct FCombatSpatialHandle {
+  int32 Index = INDEX_NONE;
+  uint32 Serial = 0;
+
+  bool IsValid() const { return Index != INDEX_NONE; }
+};
+
+/**
+ * Uniform 2D hash grid over a set of points. Points are sorted by cell so
+ * each cell is one contiguous run, and a radius query only visits the cells
+ * overlapping the sphere's bounds.
+ */
+class FCombatSpatialGrid {
+public:
+  /** Rebuild the grid over the given points, reusing its storage */
+  void Build(TConstArrayView<FVector> InPoints, float InCellSize);
+
+  /** Calls Visitor(PointIndex, Location, DistanceSquared) for every point
+   * within Radius of Origin, PointIndex being the index passed to Build */
+  template <typename VisitorType>
+  void ForEachInRadius(const FVector &Origin, float Radius,
+                       VisitorType &&Visitor) const;
+
+  /** Number of points in the grid */
+  int32 Num() const { return Points.Num(); }
+
+private:
+  /** Contiguous run of points in one cell */
+  struct FCell {
+    int32 Start = 0;
+    int32 Num = 0;
+  };
+
+  static uint64 MakeKey(int32 X, int32 Y) {
+    return (uint64(uint32(X)) << 32) | uint64(uint32(Y));
+  }
+
+  int32 ToCell(double Value) const {
+    return FMath::FloorToInt32(Value * InvCellSize);
+  }
+
+  float InvCellSize = 1.0f;
+
+  // points sorted by cell, with their index in the build input
+  TArray<FVector> Points;
+  TArray<int32> PointIndices;
+
+  /** Occupied cells by key */
+  TMap<uint64, FCell> Cells;
+
+  /** Cell key per input point, kept to avoid reallocating on rebuild */
+  TArray<uint64> ScratchKeys;
+};
+
+template <typename VisitorType>
+void FCombatSpatialGrid::ForEachInRadius(const FVector &Origin, float Radius,
+                                         VisitorType &&Visitor) const {
+  const double RadiusSquared = FMath::Square(double(Radius));
+  auto VisitCell = [&](const FCell &Cell) {
+    for (int32 Index = Cell.Start; Index < Cell.Start + Cell.Num; ++Index) {
+      const double DistanceSquared =
+          FVector::DistSquared(Points[Index], Origin);
+      if (DistanceSquared <= RadiusSquared) {
+        Visitor(PointIndices[Index], Points[Index], DistanceSquared);
+      }
+    }
+  };
+
+  const int32 MinX = ToCell(Origin.X - Radius);
+  const int32 MaxX = ToCell(Origin.X + Radius);
+  const int32 MinY = ToCell(Origin.Y - Radius);
+  const int32 MaxY = ToCell(Origin.Y + Radius);
+
+  // a huge radius over a sparse grid is cheaper to answer cell by cell
+  const int64 NumCovered = int64(MaxX - MinX + 1) * int64(MaxY - MinY + 1);
+  if (NumCovered > Cells.Num()) {
+    for (const TPair<uint64, FCell> &Pair : Cells) {
+      VisitCell(Pair.Value);
+    }
+    return;
+  }
+
+  for (int32 X = MinX; X <= MaxX; ++X) {
+    for (int32 Y = MinY; Y <= MaxY; ++Y) {
+      if (const FCell *Cell = Cells.Find(MakeKey(X, Y))) {
+        VisitCell(*Cell);
+      }
+    }
+  }
+}
+
+/** Parameters of an area query */
+struct FCombatSpatialQuery {
+  /** Center of the area */
+  FVector Origin = FVector::ZeroVector;
+
+  /** Area radius */
+  float Radius = 0.0f;
+
+  /** Cone axis, only used when ConeHalfAngle is below 180 */
+  FVector Direction = FVector::ForwardVector;
+
+  /** Cone half angle in degrees, 180 for a full sphere */
+  float ConeHalfAngle = 180.0f;
+
+  /** Team of the querier, friendly targets are skipped */
+  FGenericTeamId Team = FGenericTeamId::NoTeam;
+
+  /** Whether targets without a team are returned */
+  bool bIncludeTeamless = true;
+
+  /** Actor left out of the results, usually the querier */
+  const AActor *IgnoreActor = nullptr;
+
+  /** Maximum number of results, closest first. 0 for no limit */
+  int32 MaxResults = 0;
+};
+
+/** A target found by an area query */
+struct FCombatSpatialResult {
+  AActor *Actor = nullptr;
+
+  /** Target location when the index was built */
+  FVector Location = FVector::ZeroVector;
+
+  /** Distance from the query origin */
+  float Distance = 0.0f;
+};
+
+/**
+ * Shared spatial index of damageable actors for area queries that don't
+ * need exact collision. Combatants and props register with their team, and
+ * the grid is rebuilt from their locations at most once per frame, on the
+ * first query of that frame. Queries filter by radius, cone and team
+ * without touching physics.
+ */
+UCLASS()
+class UCombatSpatialIndexSubsystem : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /** Add a target with the team used to filter hostile queries */
+  FCombatSpatialHandle
+  RegisterTarget(AActor *Target, FGenericTeamId Team = FGenericTeamId::NoTeam);
+
+  /** Remove a target and reset its handle */
+  void UnregisterTarget(FCombatSpatialHandle &Handle);
+
+  /** Change the team of a registered target */
+  void SetTeam(const FCombatSpatialHandle &Handle, FGenericTeamId Team);
+
+  /** Collect hostile targets in a sphere or cone, sorted by distance */
+  void QueryTargets(const FCombatSpatialQuery &Query,
+                    TArray<FCombatSpatialResult> &OutResults);
+
+  /** Number of registered targets */
+  int32 GetNumTargets() const { return Targets.Num() - FreeSlots.Num(); }
+
+  /** Cell size of the grid */
+  static float GetCellSize();
+
+protected:
+  // ~begin UWorldSubsystem interface
+  virtual bool DoesSupportWorldType(
+      const EWorldType::Type WorldType) const override;
+  // ~end UWorldSubsystem interface
+
+  /** Rebuild the grid if it wasn't built this frame */
+  void UpdateGrid();
+
+  /** Whether the handle refers to a live slot */
+  bool IsRegistered(const FCombatSpatialHandle &Handle) const;
+
+private:
+  // registered targets, one entry per slot
+  TArray<TWeakObjectPtr<AActor>> Targets;
+  TArray<FGenericTeamId> Teams;
+
+  /** Bumped when a slot is reused so stale handles are rejected */
+  TArray<uint32> Serials;
+
+  /** Slots free for reuse */
+  TArray<int32> FreeSlots;
+
+  /** Serial handed to the next registered target */
+  uint32 NextSerial = 1;
+
+  /** Grid over the live targets */
+  FCombatSpatialGrid Grid;
+
+  // slot and location of each grid point, in build order
+  TArray<int32> GridSlots;
+  TArray<FVector> GridLocations;
+
+  /** Frame the grid was built, reset when targets are added or removed */
+  uint64 GridFrame = MAX_uint64;
+};
@@ -0,0 +1,305 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatSpawnDirectorSubsystem.h"
+#include "AI/CombatEnemy.h"
+#include "AI/CombatEnemySpawner.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Spawn Director Tick"), STAT_CombatSpawnDirector,
+                   STATGROUP_Combat);
+DECLARE_CYCLE_STAT(TEXT("Director Enemy Spawn"), STAT_CombatDirectorSpawn,
+                   STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Queued Spawns"), STAT_CombatQueuedSpawns,
+                               STATGROUP_Combat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Director Spawns"), STAT_CombatDirectorSpawns,
+                           STATGROUP_Combat);
+
+namespace {
+TAutoConsoleVariable<float> CVarSpawnBudgetMs(
+    TEXT("Combat.SpawnBudgetMs"), 4.0f,
+    TEXT("Time (ms) the spawn director may spend spawning enemies per ")
+        TEXT("frame. At least one enemy is spawned per frame, 0 spawns the ")
+        TEXT("whole queue at once"));
+
+/** Half height of the enemy capsule, matching the spawner reference capsule */
+constexpr float SpawnHalfHeight = 90.0f;
+
+/** Spread Count transforms on a ring around Center and drop them on the
+ * ground below */
+void AddRingTransforms(const UWorld &World, const FTransform &Center,
+                       float Radius, int32 Count,
+                       TArray<FTransform> &OutTransforms) {
+  const FCollisionObjectQueryParams GroundParams(ECC_WorldStatic);
+  const FVector Up = FVector::UpVector * SpawnHalfHeight;
+
+  for (int32 Index = 0; Index < Count; ++Index) {
+    // a lone enemy stands on the center, like a spawner without waves
+    FVector Location = Center.GetLocation();
+    if (Count > 1 && Radius > 0.0f) {
+      const float Angle = UE_TWO_PI * Index / Count;
+      Location += Center.TransformVectorNoScale(
+          FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Radius);
+    }
+
+    FHitResult Hit;
+    if (World.LineTraceSingleByObjectType(Hit, Location + Up,
+                                          Location - Up * 3.0f,
+                                          GroundParams)) {
+      Location.Z = Hit.ImpactPoint.Z + SpawnHalfHeight;
+    }
+
+    OutTransforms.Emplace(Center.GetRotation(), Location);
+  }
+}
+} // namespace
+
+bool UCombatSpawnDirectorSubsystem::DoesSupportWorldType(
+    const EWorldType::Type WorldType) const {
+  return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatSpawnDirectorSubsystem::Deinitialize() {
+  Scripts.Reset();
+  Queue.Reset();
+  QueueHead = 0;
+  SET_DWORD_STAT(STAT_CombatQueuedSpawns, 0);
+
+  Super::Deinitialize();
+}
+
+bool UCombatSpawnDirectorSubsystem::IsTickable() const {
+  return (Scripts.Num() > 0 || GetNumQueuedSpawns() > 0) &&
+         Super::IsTickable();
+}
+
+TStatId UCombatSpawnDirectorSubsystem::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatSpawnDirectorSubsystem,
+                                  STATGROUP_Tickables);
+}
+
+void UCombatSpawnDirectorSubsystem::Tick(float DeltaTime) {
+  SCOPE_CYCLE_COUNTER(STAT_CombatSpawnDirector);
+
+  UpdateScripts(GetWorld()->GetTimeSeconds());
+  DrainQueue();
+
+  SET_DWORD_STAT(STAT_CombatQueuedSpawns, GetNumQueuedSpawns());
+}
+
+void UCombatSpawnDirectorSubsystem::StartWaves(
+    ACombatEnemySpawner *Spawner, TSoftClassPtr<ACombatEnemy> EnemyClass,
+    TArray<FCombatSpawnWave> Waves, float InitialDelay) {
+  if (!Spawner) {
+    return;
+  }
+
+  StopWaves(Spawner);
+
+  // skip empty waves so a cleared wave always spawned something
+  Waves.RemoveAll([](const FCombatSpawnWave &Wave) { return Wave.Count <= 0; });
+  if (Waves.Num() == 0 || EnemyClass.IsNull()) {
+    return;
+  }
+
+  FScript &Script = Scripts.AddDefaulted_GetRef();
+  Script.Spawner = Spawner;
+  Script.EnemyClass = MoveTemp(EnemyClass);
+  Script.Waves = MoveTemp(Waves);
+  Script.NextSpawnTime = GetWorld()->GetTimeSeconds() + InitialDelay +
+                         Script.Waves[0].StartDelay;
+  BuildSlots(Script);
+}
+
+void UCombatSpawnDirectorSubsystem::StopWaves(ACombatEnemySpawner *Spawner) {
+  Scripts.RemoveAllSwap(
+      [Spawner](const FScript &Script) { return Script.Spawner == Spawner; });
+
+  // cancel queued spawns in place, the queue is consumed from its head
+  for (int32 Index = QueueHead; Index < Queue.Num(); ++Index) {
+    FSpawnRequest &Request = Queue[Index];
+    if (Request.Spawner == Spawner) {
+      Request.EnemyClass.Reset();
+    }
+  }
+}
+
+void UCombatSpawnDirectorSubsystem::NotifyEnemyDied(
+    ACombatEnemySpawner *Spawner) {
+  FScript *Script = FindScript(Spawner);
+  if (!Script) {
+    return;
+  }
+
+  Script->Alive = FMath::Max(Script->Alive - 1, 0);
+
+  // the replacement takes the slot of the enemy that died
+  for (FSlot &Slot : Script->Slots) {
+    const ACombatEnemy *Enemy = Slot.Enemy.Get();
+    const UCombatHealthComponent *Health =
+        Enemy ? Enemy->GetHealthComponent() : nullptr;
+    if (Health && Health->IsDead()) {
+      Slot.Enemy.Reset();
+    }
+  }
+
+  // wait before replacing the enemy
+  const double ReadyTime = GetWorld()->GetTimeSeconds() +
+                           Script->Waves[Script->WaveIndex].RespawnDelay;
+  Script->NextSpawnTime = FMath::Max(Script->NextSpawnTime, ReadyTime);
+}
+
+UCombatSpawnDirectorSubsystem::FScript *
+UCombatSpawnDirectorSubsystem::FindScript(const ACombatEnemySpawner *Spawner) {
+  return Scripts.FindByPredicate(
+      [Spawner](const FScript &Script) { return Script.Spawner == Spawner; });
+}
+
+void UCombatSpawnDirectorSubsystem::BuildSlots(FScript &Script) const {
+  Script.Slots.Reset();
+
+  const ACombatEnemySpawner *Spawner = Script.Spawner.Get();
+  if (!Spawner) {
+    return;
+  }
+
+  // one slot per enemy alive at the same time, so they never overlap
+  const FCombatSpawnWave &Wave = Script.Waves[Script.WaveIndex];
+  TArray<FTransform> Transforms;
+  AddRingTransforms(*GetWorld(), Spawner->GetSpawnTransform(),
+                    Wave.SpawnRadius, FMath::Min(Wave.MaxAlive, Wave.Count),
+                    Transforms);
+
+  for (const FTransform &Transform : Transforms) {
+    Script.Slots.AddDefaulted_GetRef().Transform = Transform;
+  }
+}
+
+void UCombatSpawnDirectorSubsystem::UpdateScripts(double Now) {
+  // callbacks may start new waves, so they run after the loop
+  TArray<TWeakObjectPtr<ACombatEnemySpawner>, TInlineAllocator<4>> Cleared;
+
+  for (int32 Index = Scripts.Num() - 1; Index >= 0; --Index) {
+    FScript &Script = Scripts[Index];
+    if (!Script.Spawner.IsValid()) {
+      Scripts.RemoveAtSwap(Index);
+      continue;
+    }
+
+    const FCombatSpawnWave &Wave = Script.Waves[Script.WaveIndex];
+
+    // the wave is cleared once everything it spawned is dead
+    if (Script.Spawned >= Wave.Count) {
+      if (Script.Alive > 0) {
+        continue;
+      }
+
+      if (++Script.WaveIndex >= Script.Waves.Num()) {
+        Cleared.Add(Script.Spawner);
+        Scripts.RemoveAtSwap(Index);
+        continue;
+      }
+
+      Script.Spawned = 0;
+      Script.NextSpawnTime =
+          Now + Script.Waves[Script.WaveIndex].StartDelay;
+      BuildSlots(Script);
+      continue;
+    }
+
+    if (Now < Script.NextSpawnTime || Script.Slots.Num() == 0) {
+      continue;
+    }
+
+    // top the wave up to its concurrent enemy count
+    while (Script.Alive + Script.Queued < Wave.MaxAlive &&
+           Script.Spawned + Script.Queued < Wave.Count) {
+      const int32 Slot = Script.Slots.IndexOfByPredicate(
+          [](const FSlot &Candidate) { return Candidate.IsFree(); });
+      if (Slot == INDEX_NONE) {
+        break;
+      }
+
+      Script.Slots[Slot].bQueued = true;
+      FSpawnRequest &Request = Queue.AddDefaulted_GetRef();
+      Request.EnemyClass = Script.EnemyClass;
+      Request.Spawner = Script.Spawner;
+      Request.Slot = Slot;
+      ++Script.Queued;
+    }
+  }
+
+  for (const TWeakObjectPtr<ACombatEnemySpawner> &Spawner : Cleared) {
+    if (ACombatEnemySpawner *ClearedSpawner = Spawner.Get()) {
+      ClearedSpawner->HandleWavesCleared();
+    }
+  }
+}
+
+void UCombatSpawnDirectorSubsystem::DrainQueue() {
+  const double BudgetSeconds =
+      CVarSpawnBudgetMs.GetValueOnGameThread() / 1000.0;
+  const double StartTime = FPlatformTime::Seconds();
+
+  while (QueueHead < Queue.Num()) {
+    const FSpawnRequest Request = MoveTemp(Queue[QueueHead++]);
+
+    // cancelled by StopWaves
+    if (Request.EnemyClass.IsNull()) {
+      continue;
+    }
+
+    SpawnRequest(Request);
+
+    // always spawn one per frame so the queue keeps moving
+    if (BudgetSeconds > 0.0 &&
+        FPlatformTime::Seconds() - StartTime >= BudgetSeconds) {
+      break;
+    }
+  }
+
+  if (QueueHead >= Queue.Num()) {
+    Queue.Reset();
+    QueueHead = 0;
+  }
+}
+
+bool UCombatSpawnDirectorSubsystem::SpawnRequest(
+    const FSpawnRequest &Request) {
+  SCOPE_CYCLE_COUNTER(STAT_CombatDirectorSpawn);
+
+  ACombatEnemySpawner *Spawner = Request.Spawner.Get();
+  FScript *Script = FindScript(Spawner);
+  if (!Script || !Script->Slots.IsValidIndex(Request.Slot)) {
+    return false;
+  }
+  FSlot &Slot = Script->Slots[Request.Slot];
+
+  // the class is normally preloaded by the spawner by now
+  ACombatEnemy *Enemy = nullptr;
+  if (UClass *EnemyClass = Request.EnemyClass.LoadSynchronous()) {
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride =
+        ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    Enemy = GetWorld()->SpawnActor<ACombatEnemy>(EnemyClass, Slot.Transform,
+                                                 SpawnParams);
+  }
+
+  INC_DWORD_STAT(STAT_CombatDirectorSpawns);
+
+  // failed spawns still count so the wave can't stall on them
+  --Script->Queued;
+  ++Script->Spawned;
+  Slot.bQueued = false;
+
+  if (Enemy) {
+    ++Script->Alive;
+    Slot.Enemy = Enemy;
+    Spawner->HandleEnemySpawned(Enemy);
+  }
+
+  return Enemy != nullptr;
+}
@@ -0,0 +1,145 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatSpawnDirectorSubsystem.generated.h"
+
+class ACombatEnemy;
+class ACombatEnemySpawner;
+
+/** One wave of enemies run by the spawn director for a spawner */
+USTRUCT(BlueprintType)
+struct FCombatSpawnWave {
+  GENERATED_BODY()
+
+  /** Total number of enemies spawned by the wave */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave",
+            meta = (ClampMin = 1, ClampMax = 100))
+  int32 Count = 1;
+
+  /** Number of enemies of the wave alive at the same time */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave",
+            meta = (ClampMin = 1, ClampMax = 20))
+  int32 MaxAlive = 1;
+
+  /** Time to wait before the wave starts */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave",
+            meta = (ClampMin = 0, Units = "s"))
+  float StartDelay = 0.0f;
+
+  /** Time to wait before replacing an enemy that died */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave",
+            meta = (ClampMin = 0, Units = "s"))
+  float RespawnDelay = 5.0f;
+
+  /** Radius of the ring the enemies alive at the same time are spread on */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Wave",
+            meta = (ClampMin = 0, Units = "cm"))
+  float SpawnRadius = 150.0f;
+};
+
+/**
+ * Runs the enemy waves of every spawner and spreads the spawns across
+ * frames. Spawns are queued with locations worked out when the wave starts
+ * and drained under a per-frame time budget, so spawners firing in the same
+ * frame no longer stack actor spawn, ability system and StateTree startup
+ * costs into one hitch.
+ */
+UCLASS()
+class UCombatSpawnDirectorSubsystem : public UTickableWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  // ~begin FTickableGameObject interface
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+  virtual bool IsTickable() const override;
+  // ~end FTickableGameObject interface
+
+  /** Run the waves of a spawner, replacing any waves it was running. The
+   * spawner is told about every enemy spawned and when the last wave is
+   * cleared */
+  void StartWaves(ACombatEnemySpawner *Spawner,
+                  TSoftClassPtr<ACombatEnemy> EnemyClass,
+                  TArray<FCombatSpawnWave> Waves, float InitialDelay);
+
+  /** Stop the waves of a spawner and drop its queued spawns */
+  void StopWaves(ACombatEnemySpawner *Spawner);
+
+  /** Let the director replace an enemy of the spawner that died */
+  void NotifyEnemyDied(ACombatEnemySpawner *Spawner);
+
+  /** Number of spawns waiting in the queue */
+  int32 GetNumQueuedSpawns() const { return Queue.Num() - QueueHead; }
+
+protected:
+  // ~begin UWorldSubsystem interface
+  virtual bool DoesSupportWorldType(
+      const EWorldType::Type WorldType) const override;
+  virtual void Deinitialize() override;
+  // ~end UWorldSubsystem interface
+
+  /** A spawn transform and the enemy holding it */
+  struct FSlot {
+    FTransform Transform;
+
+    /** Living enemy spawned on the slot */
+    TWeakObjectPtr<ACombatEnemy> Enemy;
+
+    /** A queued spawn is waiting for the slot */
+    bool bQueued = false;
+
+    bool IsFree() const { return !bQueued && !Enemy.IsValid(); }
+  };
+
+  /** Waves of one spawner */
+  struct FScript {
+    TWeakObjectPtr<ACombatEnemySpawner> Spawner;
+    TSoftClassPtr<ACombatEnemy> EnemyClass;
+    TArray<FCombatSpawnWave> Waves;
+    int32 WaveIndex = 0;
+
+    // progress of the current wave
+    int32 Spawned = 0;
+    int32 Queued = 0;
+    int32 Alive = 0;
+    double NextSpawnTime = 0.0;
+
+    /** Spawn slots of the current wave, one per concurrent enemy */
+    TArray<FSlot> Slots;
+  };
+
+  /** A spawn waiting in the queue */
+  struct FSpawnRequest {
+    TSoftClassPtr<ACombatEnemy> EnemyClass;
+    TWeakObjectPtr<ACombatEnemySpawner> Spawner;
+
+    /** Slot of the spawner's current wave the enemy spawns on */
+    int32 Slot = INDEX_NONE;
+  };
+
+  /** Queue the spawns the scripts are ready for and advance their waves */
+  void UpdateScripts(double Now);
+
+  /** Spawn from the queue until the frame budget runs out */
+  void DrainQueue();
+
+  /** Spawn one queued enemy, returns true if an actor was created */
+  bool SpawnRequest(const FSpawnRequest &Request);
+
+  /** Work out the spawn transforms of the script's current wave */
+  void BuildSlots(FScript &Script) const;
+
+  /** Returns the script of the spawner, or null */
+  FScript *FindScript(const ACombatEnemySpawner *Spawner);
+
+private:
+  /** Waves in progress, one per spawner */
+  TArray<FScript> Scripts;
+
+  /** Pending spawns, consumed from QueueHead and compacted when drained */
+  TArray<FSpawnRequest> Queue;
+  int32 QueueHead = 0;
+};
@@ -0,0 +1,157 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatTickSubsystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "CombatBase.h"
+#include "CombatCosmetics.h"
+#include "Components/WidgetComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Tick Manager"), STAT_CombatTickManager,
+                   STATGROUP_Combat);
+DECLARE_CYCLE_STAT(TEXT("Combat Tick Camera Pass"), STAT_CombatTickCamera,
+                   STATGROUP_Combat);
+DECLARE_CYCLE_STAT(TEXT("Combat Tick Debug Pass"), STAT_CombatTickDebug,
+                   STATGROUP_Combat);
+DECLARE_CYCLE_STAT(TEXT("Combat Tick LOD Pass"), STAT_CombatTickLOD,
+                   STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Batched Combatants"),
+                               STAT_CombatBatchedCombatants, STATGROUP_Combat);
+
+namespace {
+TAutoConsoleVariable<bool> CVarCombatBatchedTick(
+    TEXT("Combat.BatchedTick"), true,
+    TEXT("Tick combat characters from one manager tick instead of one actor "
+         "tick each"));
+
+TAutoConsoleVariable<float> CVarLifeBarCullDistance(
+    TEXT("Combat.LifeBarCullDistance"), 4000.0f,
+    TEXT("Distance (cm) from every camera beyond which life bars are hidden "
+         "and stop ticking, 0 to never hide"));
+} // namespace
+
+bool UCombatTickSubsystem::DoesSupportWorldType(
+    const EWorldType::Type WorldType) const {
+  return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UCombatTickSubsystem::IsTickable() const {
+  return Combatants.Num() > 0 && Super::IsTickable();
+}
+
+TStatId UCombatTickSubsystem::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatTickSubsystem, STATGROUP_Tickables);
+}
+
+bool UCombatTickSubsystem::IsBatchingEnabled() {
+  return CVarCombatBatchedTick.GetValueOnGameThread();
+}
+
+void UCombatTickSubsystem::RegisterCombatant(ACombatBase *Combatant) {
+  if (Combatant) {
+    Combatants.AddUnique(Combatant);
+    ApplyTickMode(Combatant);
+  }
+}
+
+void UCombatTickSubsystem::UnregisterCombatant(ACombatBase *Combatant) {
+  Combatants.RemoveSwap(Combatant);
+}
+
+void UCombatTickSubsystem::ApplyTickMode(ACombatBase *Combatant) const {
+  static const FName ReceiveTickName =
+      GET_FUNCTION_NAME_CHECKED(AActor, ReceiveTick);
+
+  Combatant->SetActorTickEnabled(
+      !bBatched ||
+      Combatant->GetClass()->IsFunctionImplementedInScript(ReceiveTickName));
+}
+
+void UCombatTickSubsystem::Tick(float DeltaTime) {
+  Super::Tick(DeltaTime);
+
+  SCOPE_CYCLE_COUNTER(STAT_CombatTickManager);
+
+  // switch every combatant over when the mode changes
+  const bool bWantBatched = IsBatchingEnabled();
+  if (bWantBatched != bBatched) {
+    bBatched = bWantBatched;
+    for (ACombatBase *Combatant : Combatants) {
+      ApplyTickMode(Combatant);
+    }
+  }
+
+  SET_DWORD_STAT(STAT_CombatBatchedCombatants,
+                 bBatched ? Combatants.Num() : 0);
+  if (!bBatched) {
+    return;
+  }
+
+  {
+    // only locked or recovering player cameras have work to do
+    SCOPE_CYCLE_COUNTER(STAT_CombatTickCamera);
+    for (ACombatBase *Combatant : Combatants) {
+      if (Combatant->NeedsCameraUpdate()) {
+        Combatant->UpdateCamera(DeltaTime);
+      }
+    }
+  }
+
+  UWorld *World = GetWorld();
+
+#if ENABLE_DRAW_DEBUG
+  if (CombatCosmetics::ShouldDrawDebug(World)) {
+    SCOPE_CYCLE_COUNTER(STAT_CombatTickDebug);
+    for (const ACombatBase *Combatant : Combatants) {
+      Combatant->DrawDebugAttributes();
+    }
+  }
+#endif
+
+  if (CombatCosmetics::ShouldRun(World)) {
+    SCOPE_CYCLE_COUNTER(STAT_CombatTickLOD);
+    TArray<FVector, TInlineAllocator<4>> ViewLocations;
+    GetViewLocations(World, ViewLocations);
+    for (ACombatBase *Combatant : Combatants) {
+      UpdateLifeBarLOD(Combatant, ViewLocations);
+    }
+  }
+}
+
+void UCombatTickSubsystem::GetViewLocations(
+    const UWorld *World, TArray<FVector, TInlineAllocator<4>> &OutLocations) {
+  for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator();
+       It; ++It) {
+    const APlayerController *PC = It->Get();
+    if (PC && PC->IsLocalController() && PC->PlayerCameraManager) {
+      OutLocations.Add(PC->PlayerCameraManager->GetCameraLocation());
+    }
+  }
+}
+
+void UCombatTickSubsystem::UpdateLifeBarLOD(
+    ACombatBase *Combatant, TArrayView<const FVector> ViewLocations) {
+  UWidgetComponent *LifeBar = Combatant->GetLifeBar();
+  if (!LifeBar) {
+    return;
+  }
+
+  const float CullDistance = CVarLifeBarCullDistance.GetValueOnGameThread();
+  bool bInRange = CullDistance <= 0.0f || ViewLocations.Num() == 0;
+  const FVector Location = Combatant->GetActorLocation();
+  for (const FVector &ViewLocation : ViewLocations) {
+    if (bInRange) {
+      break;
+    }
+    bInRange = FVector::DistSquared(Location, ViewLocation) <
+               FMath::Square(CullDistance);
+  }
+
+  // visibility only, so a life bar hidden on death stays hidden
+  if (LifeBar->GetVisibleFlag() != bInRange) {
+    LifeBar->SetVisibility(bInRange);
+    LifeBar->SetComponentTickEnabled(bInRange);
+  }
+}
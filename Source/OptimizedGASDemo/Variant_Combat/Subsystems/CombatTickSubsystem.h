@@ -0,0 +1,66 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTickSubsystem.generated.h"
+
+class ACombatBase;
+
+/**
+ * Runs the per-frame work of every combat character in one batched tick
+ * instead of one actor tick each. Combatants register on BeginPlay and the
+ * manager runs camera lock, debug text and life bar distance culling as
+ * separate passes over the registered array, skipping combatants with
+ * nothing to do. Set Combat.BatchedTick 0 to go back to actor ticks for
+ * comparison.
+ */
+UCLASS()
+class UCombatTickSubsystem : public UTickableWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  // ~begin FTickableGameObject interface
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+  virtual bool IsTickable() const override;
+  // ~end FTickableGameObject interface
+
+  /** Start ticking a combatant */
+  void RegisterCombatant(ACombatBase *Combatant);
+
+  /** Stop ticking a combatant */
+  void UnregisterCombatant(ACombatBase *Combatant);
+
+  /** Whether combatants are ticked by the manager or by their actor tick */
+  static bool IsBatchingEnabled();
+
+  /** Locations of the local player cameras, inline for split screen */
+  static void
+  GetViewLocations(const UWorld *World,
+                   TArray<FVector, TInlineAllocator<4>> &OutLocations);
+
+  /** Hide and stop ticking the life bar of a combatant far from every
+   * camera, show it again once one gets close */
+  static void UpdateLifeBarLOD(ACombatBase *Combatant,
+                               TArrayView<const FVector> ViewLocations);
+
+protected:
+  // ~begin UWorldSubsystem interface
+  virtual bool DoesSupportWorldType(
+      const EWorldType::Type WorldType) const override;
+  // ~end UWorldSubsystem interface
+
+  /** Enable the actor tick when batching is off, or when a Blueprint
+   * implements Event Tick */
+  void ApplyTickMode(ACombatBase *Combatant) const;
+
+private:
+  /** Registered combatants */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<ACombatBase>> Combatants;
+
+  /** Batching mode the combatants were last set up for */
+  bool bBatched = true;
+};
@@ -0,0 +1,225 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatTimerSubsystem.h"
+#include "OptimizedGASDemo.h"
+
+DECLARE_CYCLE_STAT(TEXT("Combat Timers"), STAT_CombatTimers, STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active Combat Timers"),
+                               STAT_CombatActiveTimers, STATGROUP_Combat);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Combat Timers Fired"),
+                               STAT_CombatTimersFired, STATGROUP_Combat);
+
+namespace {
+/** Seconds per wheel tick, the resolution of the finest wheel */
+constexpr float TickSeconds = 1.0f / 60.0f;
+
+/** Slots per wheel as a power of two. Each level covers 64 times the span of
+ * the one below: ~1s, ~68s, ~73min, then ~78h */
+constexpr int32 SlotBits = 6;
+constexpr int32 SlotsPerLevel = 1 << SlotBits;
+constexpr uint64 SlotMask = SlotsPerLevel - 1;
+constexpr int32 NumLevels = 4;
+} // namespace
+
+bool UCombatTimerSubsystem::DoesSupportWorldType(
+    const EWorldType::Type WorldType) const {
+  return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatTimerSubsystem::Deinitialize() {
+  Timers.Reset();
+  FreeTimers.Reset();
+  Slots.Reset();
+  NumActive = 0;
+
+  Super::Deinitialize();
+}
+
+bool UCombatTimerSubsystem::IsTickable() const {
+  return NumActive > 0 && Super::IsTickable();
+}
+
+TStatId UCombatTimerSubsystem::GetStatId() const {
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatTimerSubsystem, STATGROUP_Tickables);
+}
+
+void UCombatTimerSubsystem::Tick(float DeltaTime) {
+  Super::Tick(DeltaTime);
+
+  SCOPE_CYCLE_COUNTER(STAT_CombatTimers);
+  SET_DWORD_STAT(STAT_CombatTimersFired, 0);
+
+  // one pass per elapsed wheel tick, empty slots cost an array check
+  TickRemainder += DeltaTime;
+  while (TickRemainder >= TickSeconds && NumActive > 0) {
+    TickRemainder -= TickSeconds;
+    AdvanceTick();
+  }
+
+  // time passed with nothing scheduled does not carry over
+  if (NumActive == 0) {
+    TickRemainder = 0.0f;
+  }
+
+  SET_DWORD_STAT(STAT_CombatActiveTimers, NumActive);
+}
+
+uint64 UCombatTimerSubsystem::ToTicks(float Delay) {
+  return FMath::Max<uint64>(FMath::CeilToInt64(Delay / TickSeconds), 1);
+}
+
+void UCombatTimerSubsystem::SetTimer(FCombatTimerHandle &InOutHandle,
+                                     FCombatTimerDelegate Delegate,
+                                     float Delay, bool bLoop) {
+  ClearTimer(InOutHandle);
+  if (!Delegate.IsBound()) {
+    return;
+  }
+
+  if (Slots.Num() == 0) {
+    Slots.SetNum(NumLevels * SlotsPerLevel);
+  }
+
+  const int32 TimerIndex = FreeTimers.Num() > 0
+                               ? FreeTimers.Pop(EAllowShrinking::No)
+                               : Timers.AddDefaulted();
+
+  FTimer &Timer = Timers[TimerIndex];
+  Timer.Object = Delegate.GetUObject();
+  Timer.Delegate = MoveTemp(Delegate);
+  Timer.ExpireTick = CurrentTick + ToTicks(Delay);
+  Timer.LoopTicks = bLoop ? ToTicks(Delay) : 0;
+  Timer.Serial = NextSerial++;
+  Timer.bActive = true;
+  ++NumActive;
+
+  Schedule(TimerIndex);
+
+  InOutHandle.Index = TimerIndex;
+  InOutHandle.Serial = Timer.Serial;
+}
+
+void UCombatTimerSubsystem::ClearTimer(FCombatTimerHandle &InOutHandle) {
+  if (IsTimerActive(InOutHandle)) {
+    Cancel(InOutHandle.Index);
+  }
+
+  InOutHandle.Invalidate();
+}
+
+void UCombatTimerSubsystem::ClearAllTimers(const UObject *Object) {
+  if (!Object) {
+    return;
+  }
+
+  for (int32 TimerIndex = 0; TimerIndex < Timers.Num(); ++TimerIndex) {
+    const FTimer &Timer = Timers[TimerIndex];
+    if (!Timer.bActive) {
+      continue;
+    }
+
+    const UObject *TimerObject = Timer.Object.Get();
+    if (TimerObject &&
+        (TimerObject == Object || TimerObject->IsIn(Object))) {
+      Cancel(TimerIndex);
+    }
+  }
+}
+
+bool UCombatTimerSubsystem::IsTimerActive(
+    const FCombatTimerHandle &Handle) const {
+  return Timers.IsValidIndex(Handle.Index) &&
+         Timers[Handle.Index].bActive &&
+         Timers[Handle.Index].Serial == Handle.Serial;
+}
+
+float UCombatTimerSubsystem::GetTimerRemaining(
+    const FCombatTimerHandle &Handle) const {
+  if (!IsTimerActive(Handle)) {
+    return -1.0f;
+  }
+
+  const uint64 Ticks = Timers[Handle.Index].ExpireTick - CurrentTick;
+  return FMath::Max(Ticks * TickSeconds - TickRemainder, 0.0f);
+}
+
+void UCombatTimerSubsystem::Cancel(int32 TimerIndex) {
+  FTimer &Timer = Timers[TimerIndex];
+  Timer.bActive = false;
+  Timer.Delegate.Unbind();
+  Timer.Object.Reset();
+  --NumActive;
+}
+
+void UCombatTimerSubsystem::Schedule(int32 TimerIndex) {
+  const uint64 ExpireTick = Timers[TimerIndex].ExpireTick;
+  const uint64 Delta =
+      ExpireTick > CurrentTick ? ExpireTick - CurrentTick : 0;
+
+  // the coarsest level whose span still holds the delay, slotted by the
+  // expiry bits of that level
+  for (int32 Level = 0; Level < NumLevels; ++Level) {
+    const int32 Shift = Level * SlotBits;
+    if (Delta < (uint64(1) << (Shift + SlotBits))) {
+      const int32 Slot = int32((ExpireTick >> Shift) & SlotMask);
+      Slots[Level * SlotsPerLevel + Slot].Add(TimerIndex);
+      return;
+    }
+  }
+
+  // beyond the last wheel, park in the slot visited last and reschedule
+  // when it cascades
+  const int32 Shift = (NumLevels - 1) * SlotBits;
+  const int32 Slot = int32(((CurrentTick >> Shift) - 1) & SlotMask);
+  Slots[(NumLevels - 1) * SlotsPerLevel + Slot].Add(TimerIndex);
+}
+
+void UCombatTimerSubsystem::AdvanceTick() {
+  ++CurrentTick;
+
+  // when a wheel wraps, move the next slot of the wheel above down
+  for (int32 Level = 1; Level < NumLevels; ++Level) {
+    const int32 Shift = Level * SlotBits;
+    if ((CurrentTick & ((uint64(1) << Shift) - 1)) != 0) {
+      break;
+    }
+
+    const int32 Slot = int32((CurrentTick >> Shift) & SlotMask);
+    TArray<int32> Cascading = MoveTemp(Slots[Level * SlotsPerLevel + Slot]);
+    for (const int32 TimerIndex : Cascading) {
+      if (Timers[TimerIndex].bActive) {
+        Schedule(TimerIndex);
+      } else {
+        FreeTimers.Add(TimerIndex);
+      }
+    }
+  }
+
+  // callbacks may schedule into this slot, so take it first
+  TArray<int32> Due = MoveTemp(Slots[int32(CurrentTick & SlotMask)]);
+  for (const int32 TimerIndex : Due) {
+    FTimer &Timer = Timers[TimerIndex];
+    if (!Timer.bActive) {
+      FreeTimers.Add(TimerIndex);
+      continue;
+    }
+
+    if (Timer.ExpireTick > CurrentTick) {
+      Schedule(TimerIndex);
+      continue;
+    }
+
+    // copy the delegate, the callback may clear or replace this timer
+    FCombatTimerDelegate Delegate = Timer.Delegate;
+    if (Timer.LoopTicks > 0) {
+      Timer.ExpireTick = CurrentTick + Timer.LoopTicks;
+      Schedule(TimerIndex);
+    } else {
+      Cancel(TimerIndex);
+      FreeTimers.Add(TimerIndex);
+    }
+
+    INC_DWORD_STAT(STAT_CombatTimersFired);
+    Delegate.ExecuteIfBound();
+  }
+}
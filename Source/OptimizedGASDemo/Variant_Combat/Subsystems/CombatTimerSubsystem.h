@@ -0,0 +1,126 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatTimerSubsystem.generated.h"
+
+/** Callback fired by a combat timer */
+DECLARE_DELEGATE(FCombatTimerDelegate);
+
+/** Handle to a timer scheduled on UCombatTimerSubsystem */
+struct FCombatTimerHandle {
+  int32 Index = INDEX_NONE;
+  uint32 Serial = 0;
+
+  bool IsValid() const { return Index != INDEX_NONE; }
+  void Invalidate() { *this = FCombatTimerHandle(); }
+};
+
+/**
+ * Hierarchical timing wheel for combat-owned timers. Timers are bucketed by
+ * expiry into wheels of increasing resolution and cascade down as they get
+ * close, so each frame only visits the slots that elapsed. Timers bound to
+ * an object can be cancelled together, e.g. when an actor ends play.
+ */
+UCLASS()
+class UCombatTimerSubsystem : public UTickableWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  // ~begin USubsystem interface
+  virtual void Deinitialize() override;
+  // ~end USubsystem interface
+
+  // ~begin FTickableGameObject interface
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+  virtual bool IsTickable() const override;
+  // ~end FTickableGameObject interface
+
+  /** Schedule a member function after Delay seconds, replacing the timer the
+   * handle refers to. Looping timers repeat every Delay seconds */
+  template <typename UserClass>
+  void SetTimer(FCombatTimerHandle &InOutHandle, UserClass *Object,
+                typename FCombatTimerDelegate::TMethodPtr<UserClass> Method,
+                float Delay, bool bLoop = false) {
+    SetTimer(InOutHandle, FCombatTimerDelegate::CreateUObject(Object, Method),
+             Delay, bLoop);
+  }
+
+  /** Schedule a delegate after Delay seconds, replacing the timer the handle
+   * refers to */
+  void SetTimer(FCombatTimerHandle &InOutHandle, FCombatTimerDelegate Delegate,
+                float Delay, bool bLoop = false);
+
+  /** Cancel a timer and invalidate its handle */
+  void ClearTimer(FCombatTimerHandle &InOutHandle);
+
+  /** Cancel every timer bound to the object or to anything it outers, such as
+   * the components and abilities of a dying actor */
+  void ClearAllTimers(const UObject *Object);
+
+  /** Whether the timer is still scheduled */
+  bool IsTimerActive(const FCombatTimerHandle &Handle) const;
+
+  /** Seconds until the timer fires, or -1 if it is not active */
+  float GetTimerRemaining(const FCombatTimerHandle &Handle) const;
+
+protected:
+  // ~begin UWorldSubsystem interface
+  virtual bool DoesSupportWorldType(
+      const EWorldType::Type WorldType) const override;
+  // ~end UWorldSubsystem interface
+
+  /** Advance one wheel tick, cascading and firing the slots it reaches */
+  void AdvanceTick();
+
+  /** Put a timer in the slot matching its expiry */
+  void Schedule(int32 TimerIndex);
+
+  /** Cancel a timer, its slot entry is released when the slot is visited */
+  void Cancel(int32 TimerIndex);
+
+private:
+  /** A scheduled or cancelled timer */
+  struct FTimer {
+    FCombatTimerDelegate Delegate;
+
+    /** Object the delegate is bound to, for bulk cancellation */
+    TWeakObjectPtr<const UObject> Object;
+
+    /** Wheel tick the timer fires at */
+    uint64 ExpireTick = 0;
+
+    /** Ticks between repeats, zero for one-shot timers */
+    uint64 LoopTicks = 0;
+
+    uint32 Serial = 0;
+    bool bActive = false;
+  };
+
+  /** Wheel ticks from now to Delay seconds, at least one */
+  static uint64 ToTicks(float Delay);
+
+  /** Timer storage, indexed by handles */
+  TArray<FTimer> Timers;
+
+  /** Timer entries no slot refers to anymore */
+  TArray<int32> FreeTimers;
+
+  /** Timer indices per level and slot */
+  TArray<TArray<int32>> Slots;
+
+  /** Current wheel tick */
+  uint64 CurrentTick = 0;
+
+  /** Time not yet consumed by a wheel tick */
+  float TickRemainder = 0.0f;
+
+  /** Scheduled timers that were not cancelled */
+  int32 NumActive = 0;
+
+  /** Serial handed to the next timer */
+  uint32 NextSerial = 1;
+};
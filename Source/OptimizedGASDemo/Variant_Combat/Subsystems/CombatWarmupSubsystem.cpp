@@ -0,0 +1,273 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#include "CombatWarmupSubsystem.h"
+#include "Abilities/GameplayAbility.h"
+#include "AI/CombatEnemySpawner.h"
+#include "Blueprint/UserWidget.h"
+#include "Camera/PlayerCameraManager.h"
+#include "CombatBase.h"
+#include "CombatCosmetics.h"
+#include "Components/DecalComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/WidgetComponent.h"
+#include "Data/CombatPawnData.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameplayEffect.h"
+#include "GameplayEffectExecutionCalculation.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/GameplayStatics.h"
+#include "LockSystem/CombatLockSystemComponent.h"
+#include "OptimizedGASDemo.h"
+#include "PhysicsEngine/PhysicsAsset.h"
+
+DECLARE_CYCLE_STAT(TEXT("Level Warm-up"), STAT_CombatWarmup, STATGROUP_Combat);
+
+namespace {
+TAutoConsoleVariable<bool> CVarCombatWarmup(
+    TEXT("Combat.Warmup"), true,
+    TEXT("Warm up combat classes and assets when a level begins play"));
+} // namespace
+
+bool UCombatWarmupSubsystem::DoesSupportWorldType(
+    const EWorldType::Type WorldType) const {
+  return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UCombatWarmupSubsystem::OnWorldBeginPlay(UWorld &InWorld) {
+  Super::OnWorldBeginPlay(InWorld);
+
+  if (!CVarCombatWarmup.GetValueOnGameThread()) {
+    return;
+  }
+
+  SCOPE_CYCLE_COUNTER(STAT_CombatWarmup);
+  const double StartTime = FPlatformTime::Seconds();
+
+  TSet<UClass *> CharacterClasses;
+  GatherCharacterClasses(InWorld, CharacterClasses);
+
+  for (UClass *CharacterClass : CharacterClasses) {
+    WarmupCharacterClass(CharacterClass);
+  }
+
+  Report(CharacterClasses.Num(),
+         (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+  Categories.Reset();
+  VisitedObjects.Reset();
+}
+
+void UCombatWarmupSubsystem::GatherCharacterClasses(
+    UWorld &InWorld, TSet<UClass *> &OutClasses) const {
+  // characters placed in the level
+  for (TActorIterator<ACombatBase> It(&InWorld); It; ++It) {
+    OutClasses.Add(It->GetClass());
+  }
+
+  // deferred spawners preload through their activation volume, so only
+  // the ones spawning on BeginPlay are loaded here
+  for (TActorIterator<ACombatEnemySpawner> It(&InWorld); It; ++It) {
+    if (It->ShouldSpawnEnemiesImmediately()) {
+      if (UClass *EnemyClass = It->GetEnemyClass().LoadSynchronous()) {
+        OutClasses.Add(EnemyClass);
+      }
+    }
+  }
+
+  // the player pawn, from the game mode on servers or its defaults on clients
+  const AGameModeBase *GameMode = InWorld.GetAuthGameMode();
+  if (!GameMode && InWorld.GetGameState()) {
+    GameMode = InWorld.GetGameState()->GetDefaultGameMode();
+  }
+
+  if (GameMode && GameMode->DefaultPawnClass &&
+      GameMode->DefaultPawnClass->IsChildOf<ACombatBase>()) {
+    OutClasses.Add(GameMode->DefaultPawnClass.Get());
+  }
+}
+
+void UCombatWarmupSubsystem::WarmupCharacterClass(UClass *CharacterClass) {
+  const ACombatBase *Defaults = CharacterClass->GetDefaultObject<ACombatBase>();
+  if (!Defaults) {
+    return;
+  }
+
+  // pawn data and ability sets, which pull in the ability and effect classes
+  double StartTime = FPlatformTime::Seconds();
+  const UCombatPawnData *Data = Defaults->GetPawnDataAsset().LoadSynchronous();
+  if (Data) {
+    Record(TEXT("pawn data"), Data, StartTime);
+  } else {
+    Data = GetDefault<UCombatDefaultPawnData>();
+  }
+
+  for (const FCombatAbilitySetWithInput &AbilitySetWithInput :
+       Data->AbilitySets) {
+    StartTime = FPlatformTime::Seconds();
+    const UCombatAbilitySet *AbilitySet =
+        AbilitySetWithInput.AbilitySet.LoadSynchronous();
+    if (!AbilitySet) {
+      continue;
+    }
+    Record(TEXT("ability sets"), AbilitySet, StartTime);
+
+    for (const FGameplayAbilityBindInfo &BindInfo : AbilitySet->Abilities) {
+      WarmupAbilityClass(BindInfo.GameplayAbilityClass);
+    }
+
+    for (const FGameplayEffectApplicationInfo &EffectInfo :
+         AbilitySet->GrantedGameplayEffects) {
+      WarmupEffectClass(EffectInfo.GameplayEffect);
+    }
+  }
+
+  // combo and charged attack montages
+  TArray<FSoftObjectPath> MontagePaths;
+  Defaults->GetMontagesToLoad(MontagePaths);
+  for (const FSoftObjectPath &MontagePath : MontagePaths) {
+    StartTime = FPlatformTime::Seconds();
+    if (UObject *Montage = MontagePath.TryLoad()) {
+      Record(TEXT("montages"), Montage, StartTime);
+    }
+  }
+
+  // the physics asset used by the death ragdoll
+  if (const USkeletalMeshComponent *Mesh = Defaults->GetMesh()) {
+    StartTime = FPlatformTime::Seconds();
+    if (UPhysicsAsset *PhysicsAsset = Mesh->GetPhysicsAsset()) {
+      Record(TEXT("physics assets"), PhysicsAsset, StartTime);
+    }
+  }
+
+  // life bar widgets and lock-on decals are never shown on dedicated servers
+  if (!CombatCosmetics::ShouldRun(GetWorld())) {
+    return;
+  }
+
+  const UWidgetComponent *LifeBar =
+      Defaults->FindComponentByClass<UWidgetComponent>();
+  UClass *WidgetClass = LifeBar ? LifeBar->GetWidgetClass().Get() : nullptr;
+  if (WidgetClass && !VisitedObjects.Contains(WidgetClass)) {
+    // build the widget and its slate tree once, off-screen, then drop it
+    StartTime = FPlatformTime::Seconds();
+    if (UUserWidget *Widget = CreateWidget<UUserWidget>(GetWorld(),
+                                                        WidgetClass)) {
+      Widget->TakeWidget();
+      Record(TEXT("widgets"), WidgetClass, StartTime);
+    }
+  }
+
+  if (const UCombatLockSystemComponent *LockSystem =
+          Defaults->FindComponentByClass<UCombatLockSystemComponent>()) {
+    StartTime = FPlatformTime::Seconds();
+    if (UMaterialInterface *DecalMaterial =
+            LockSystem->GetLockDecalMaterial();
+        DecalMaterial && !VisitedObjects.Contains(DecalMaterial)) {
+      // a hidden decal never gets a scene proxy, so draw a sub-pixel decal in
+      // front of the first player's view for a few frames instead. That
+      // compiles the material's pipeline states before the first lock-on
+      FVector Location = FVector::ZeroVector;
+      FRotator Rotation = FRotator::ZeroRotator;
+      if (const APlayerCameraManager *Camera =
+              UGameplayStatics::GetPlayerCameraManager(GetWorld(), 0)) {
+        Rotation = Camera->GetCameraRotation();
+        Location = Camera->GetCameraLocation() + Rotation.Vector() * 100.0f;
+      }
+      if (UDecalComponent *Decal = UGameplayStatics::SpawnDecalAtLocation(
+              GetWorld(), DecalMaterial, FVector(1.0f), Location, Rotation,
+              0.1f)) {
+        // keep the decal from being culled for its tiny screen size
+        Decal->SetFadeScreenSize(0.0f);
+      }
+      Record(TEXT("decal materials"), DecalMaterial, StartTime);
+    }
+  }
+}
+
+void UCombatWarmupSubsystem::WarmupAbilityClass(UClass *AbilityClass) {
+  if (!AbilityClass || VisitedObjects.Contains(AbilityClass)) {
+    return;
+  }
+
+  const double StartTime = FPlatformTime::Seconds();
+  const UObject *AbilityDefaults = AbilityClass->GetDefaultObject();
+  Record(TEXT("abilities"), AbilityClass, StartTime);
+
+  // effect classes such as stamina costs and damage, and any other class the
+  // ability references (camera shakes), are created on first use otherwise
+  for (TFieldIterator<FClassProperty> It(AbilityClass); It; ++It) {
+    UClass *ReferencedClass =
+        Cast<UClass>(It->GetObjectPropertyValue_InContainer(AbilityDefaults));
+    if (!ReferencedClass || VisitedObjects.Contains(ReferencedClass)) {
+      continue;
+    }
+
+    if (ReferencedClass->IsChildOf<UGameplayEffect>()) {
+      WarmupEffectClass(ReferencedClass);
+    } else {
+      const double ClassStartTime = FPlatformTime::Seconds();
+      ReferencedClass->GetDefaultObject();
+      Record(TEXT("referenced classes"), ReferencedClass, ClassStartTime);
+    }
+  }
+}
+
+void UCombatWarmupSubsystem::WarmupEffectClass(UClass *EffectClass) {
+  if (!EffectClass || VisitedObjects.Contains(EffectClass)) {
+    return;
+  }
+
+  double StartTime = FPlatformTime::Seconds();
+  const UGameplayEffect *Effect = GetDefault<UGameplayEffect>(EffectClass);
+  Record(TEXT("effects"), EffectClass, StartTime);
+
+  for (const FGameplayEffectExecutionDefinition &Execution :
+       Effect->Executions) {
+    UClass *CalculationClass = Execution.CalculationClass.Get();
+    if (CalculationClass && !VisitedObjects.Contains(CalculationClass)) {
+      StartTime = FPlatformTime::Seconds();
+      CalculationClass->GetDefaultObject();
+      Record(TEXT("executions"), CalculationClass, StartTime);
+    }
+  }
+}
+
+void UCombatWarmupSubsystem::Record(FName Category, const UObject *Object,
+                                    double StartTime) {
+  if (!Object) {
+    return;
+  }
+
+  bool bAlreadyVisited = false;
+  VisitedObjects.Add(Object, &bAlreadyVisited);
+  if (bAlreadyVisited) {
+    return;
+  }
+
+  // only referenced here, the objects themselves are not modified
+  WarmedObjects.Add(const_cast<UObject *>(Object));
+
+  const double Ms = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+  FWarmupCategory &Totals = Categories.FindOrAdd(Category);
+  ++Totals.Count;
+  Totals.Ms += Ms;
+
+  UE_LOG(LogOptimizedGASDemo, Verbose, TEXT("CombatWarmup:   %s %s %.2fms"),
+         *Category.ToString(), *GetNameSafe(Object), Ms);
+}
+
+void UCombatWarmupSubsystem::Report(int32 NumClasses, double ElapsedMs) const {
+  UE_LOG(LogOptimizedGASDemo, Log,
+         TEXT("CombatWarmup: %d combat character classes warmed in %.2fms"),
+         NumClasses, ElapsedMs);
+
+  // each line is a first-use cost moved out of gameplay into level start
+  for (const TPair<FName, FWarmupCategory> &Pair : Categories) {
+    UE_LOG(LogOptimizedGASDemo, Log, TEXT("CombatWarmup:   %d %s (%.2fms)"),
+           Pair.Value.Count, *Pair.Key.ToString(), Pair.Value.Ms);
+  }
+}
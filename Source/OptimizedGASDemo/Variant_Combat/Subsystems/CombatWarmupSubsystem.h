@@ -0,0 +1,64 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatWarmupSubsystem.generated.h"
+
+/**
+ * Level-start warm-up. Before actors begin play, collects the combat
+ * characters the level will use (placed characters, spawner enemy classes
+ * and the default pawn), then loads and instantiates what their first combo,
+ * hit, death and lock-on would otherwise pay for on first use. Disable with
+ * Combat.Warmup 0 to compare.
+ */
+UCLASS()
+class UCombatWarmupSubsystem : public UWorldSubsystem {
+  GENERATED_BODY()
+
+protected:
+  // ~begin UWorldSubsystem interface
+  virtual bool DoesSupportWorldType(
+      const EWorldType::Type WorldType) const override;
+  virtual void OnWorldBeginPlay(UWorld &InWorld) override;
+  // ~end UWorldSubsystem interface
+
+  /** Collect every combat character class the level can spawn */
+  void GatherCharacterClasses(UWorld &InWorld,
+                              TSet<UClass *> &OutClasses) const;
+
+  /** Warm the pawn data, abilities, effects and cosmetics of one class */
+  void WarmupCharacterClass(UClass *CharacterClass);
+
+  /** Create the class default object of an ability and everything it
+   * references through class properties */
+  void WarmupAbilityClass(UClass *AbilityClass);
+
+  /** Create the class default object of an effect and its executions */
+  void WarmupEffectClass(UClass *EffectClass);
+
+  /** Record an object warmed since StartTime under a report category */
+  void Record(FName Category, const UObject *Object, double StartTime);
+
+  /** Log what was warmed and the time it took, per category */
+  void Report(int32 NumClasses, double ElapsedMs) const;
+
+private:
+  /** Warm-up totals for one kind of asset */
+  struct FWarmupCategory {
+    int32 Count = 0;
+    double Ms = 0.0;
+  };
+
+  /** Totals by category, in the order they were first seen */
+  TMap<FName, FWarmupCategory> Categories;
+
+  /** Objects already visited, so shared classes are counted once */
+  TSet<const UObject *> VisitedObjects;
+
+  /** Everything warmed, kept referenced until the level ends so garbage
+   * collection doesn't undo the warm-up */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<UObject>> WarmedObjects;
+};
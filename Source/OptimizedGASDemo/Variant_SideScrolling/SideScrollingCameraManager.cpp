@@ -6,6 +6,7 @@
 #include "Engine/HitResult.h"
 #include "CollisionQueryParams.h"
 #include "Engine/World.h"
+#include "OptimizedGASDemo.h"
 
 void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float DeltaTime)
 {
@@ -58,15 +59,35 @@ void ASideScrollingCameraManager::UpdateViewTarget(FTViewTarget& OutVT, float De
 		} else {
 
 			// run a trace below the character to determine if we need to do a height update
-			FHitResult OutHit;
-
 			const FVector End = CurrentActorLocation + FVector(0.0f, 0.0f, -1000.0f);
 
 			FCollisionQueryParams QueryParams;
 			QueryParams.AddIgnoredActor(TargetPawn);
 
+			if (CombatAsyncTraces::IsEnabled())
+			{
+				// use the result of last frame's trace, if it is ready
+				FTraceDatum GroundTraceData;
+				if (GetWorld()->QueryTraceData(GroundTraceHandle, GroundTraceData))
+				{
+					bGroundBelow = GroundTraceData.OutHits.Num() > 0 && GroundTraceData.OutHits[0].bBlockingHit;
+				}
+
+				// queue the trace for the next frame
+				INC_DWORD_STAT(STAT_CombatAsyncTraces);
+				GroundTraceHandle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, CurrentActorLocation, End, ECC_Visibility, QueryParams);
+
+			} else {
+
+				SCOPE_CYCLE_COUNTER(STAT_CombatDeferrableTraces);
+
+				FHitResult OutHit;
+				bGroundBelow = GetWorld()->LineTraceSingleByChannel(OutHit, CurrentActorLocation, End, ECC_Visibility, QueryParams);
+
+			}
+
 			// only update height if we're not about to hit ground
-			bZUpdate = !GetWorld()->LineTraceSingleByChannel(OutHit, CurrentActorLocation, End, ECC_Visibility, QueryParams);
+			bZUpdate = !bGroundBelow;
 
 		}
 
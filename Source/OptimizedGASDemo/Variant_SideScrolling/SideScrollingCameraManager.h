@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Camera/PlayerCameraManager.h"
+#include "WorldCollision.h"
 #include "SideScrollingCameraManager.generated.h"
 
 /**
@@ -44,4 +45,10 @@ protected:
 
 	/** First-time update camera setup flag */
 	bool bSetup = true;
+
+	/** Whether the last ground check found ground below the target */
+	bool bGroundBelow = false;
+
+	/** Pending async ground check, consumed the next frame */
+	FTraceHandle GroundTraceHandle;
 };
@@ -0,0 +1,15 @@
+// Copyright Nguyen Minh Tam. All Rights Reserved.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+public class OptimizedGASDemoServerTarget : TargetRules
+{
+	public OptimizedGASDemoServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V6;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_7;
+		ExtraModuleNames.Add("OptimizedGASDemo");
+	}
+}